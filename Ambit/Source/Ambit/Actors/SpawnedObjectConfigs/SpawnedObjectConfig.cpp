@@ -14,7 +14,6 @@
 
 #include "SpawnedObjectConfig.h"
 
-#include "Containers/Map.h"
 #include "Dom/JsonObject.h"
 
 #include "Ambit/Mode/Constant.h"
@@ -28,26 +27,21 @@ TSharedPtr<FJsonObject> USpawnedObjectConfig::SerializeToJson() const
     if (SpawnedObjects.Num() > 0)
     {
         TArray<TSharedPtr<FJsonValue>> SpawnTransformsJson;
-        TArray<FString> ActorsPaths;
-        SpawnedObjects.GenerateKeyArray(ActorsPaths);
-        for (const FString& PathName : ActorsPaths)
+        SpawnTransformsJson.Reserve(SpawnedObjects.Num());
+        for (const TPair<FName, FPlacementBuffer::FPlacements>& Class : SpawnedObjects.GetClasses())
         {
-            const TArray<FTransform>* PathNameTransforms = SpawnedObjects.Find(PathName);
-            if (PathNameTransforms != nullptr)
+            const FString PathName = Class.Key.ToString();
+            const FPlacementBuffer::FPlacements& Placements = Class.Value;
+            for (int32 i = 0; i < Placements.Num(); i++)
             {
-                for (const FTransform& Transform : *PathNameTransforms)
-                {
-                    const TSharedPtr<FJsonObject> TransformJson = MakeShareable(new FJsonObject);
-                    // The unit is centimeter
-                    TransformJson->SetStringField(JsonConstants::AmbitSpawner::KActorToSpawnKey, PathName);
-                    const FVector& Location = Transform.GetLocation();
-                    TransformJson->SetArrayField(JsonConstants::KAmbitSpawnerLocationsKey,
-                                                 FJsonHelpers::SerializeVector3(Location));
-                    const FRotator& Rotation = Transform.Rotator();
-                    TransformJson->SetArrayField(JsonConstants::KAmbitSpawnerRotationsKey,
-                                                 FJsonHelpers::SerializeRotation(Rotation));
-                    SpawnTransformsJson.Add(MakeShareable(new FJsonValueObject(TransformJson)));
-                }
+                const TSharedPtr<FJsonObject> TransformJson = MakeShareable(new FJsonObject);
+                // The unit is centimeter
+                TransformJson->SetStringField(JsonConstants::AmbitSpawner::KActorToSpawnKey, PathName);
+                TransformJson->SetArrayField(JsonConstants::KAmbitSpawnerLocationsKey,
+                                             FJsonHelpers::SerializeVector3(Placements.GetLocation(i)));
+                TransformJson->SetArrayField(JsonConstants::KAmbitSpawnerRotationsKey,
+                                             FJsonHelpers::SerializeRotation(Placements.GetRotation(i)));
+                SpawnTransformsJson.Add(MakeShareable(new FJsonValueObject(TransformJson)));
             }
         }
 
@@ -57,6 +51,23 @@ TSharedPtr<FJsonObject> USpawnedObjectConfig::SerializeToJson() const
     return Json;
 }
 
+void USpawnedObjectConfig::WriteSpawnedObjectsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const
+{
+    for (const TPair<FName, FPlacementBuffer::FPlacements>& Class : SpawnedObjects.GetClasses())
+    {
+        const FString PathName = Class.Key.ToString();
+        const FPlacementBuffer::FPlacements& Placements = Class.Value;
+        for (int32 i = 0; i < Placements.Num(); i++)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(JsonConstants::AmbitSpawner::KActorToSpawnKey, PathName);
+            FJsonHelpers::WriteVector3(Writer, JsonConstants::KAmbitSpawnerLocationsKey, Placements.GetLocation(i));
+            FJsonHelpers::WriteRotation(Writer, JsonConstants::KAmbitSpawnerRotationsKey, Placements.GetRotation(i));
+            Writer->WriteObjectEnd();
+        }
+    }
+}
+
 void USpawnedObjectConfig::DeserializeFromJson(TSharedPtr<FJsonObject> JsonObject)
 {
     // Does nothing since this class is not supposed to be deserialized
@@ -17,6 +17,9 @@
 #include "CoreMinimal.h"
 
 #include <AmbitUtils/ConfigJsonSerializer.h>
+#include <AmbitUtils/JsonHelpers.h>
+
+#include "Ambit/Utils/PlacementBuffer.h"
 
 #include "SpawnedObjectConfig.generated.h"
 
@@ -33,7 +36,7 @@ public:
     /**
      * The path, location and rotation of spawned objects
      */
-    TMap<FString, TArray<FTransform>> SpawnedObjects;
+    FPlacementBuffer SpawnedObjects;
 
     /**
      * Destructor for USpawnedObjectConfig
@@ -50,6 +53,12 @@ public:
      */
     void DeserializeFromJson(TSharedPtr<FJsonObject> JsonObject) override;
 
+    /**
+     * Writes each spawned object as an element of the array that is open on Writer.
+     * The elements match the SpawnedObjects array of SerializeToJson, without building it.
+     */
+    void WriteSpawnedObjectsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const;
+
     FString GetOutputConfigurationName() const override
     {
         return JsonConstants::KAmbitSpawnerKey;
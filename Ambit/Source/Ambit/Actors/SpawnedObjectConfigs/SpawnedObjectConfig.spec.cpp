@@ -42,11 +42,11 @@ void SpawnedObjectConfigSpec::Define()
         {
             It("sets values correctly when there is one ActorToSpawn pathname and one transform", [this]()
             {
-                TMap<FString, TArray<FTransform>> Expected;
+                FPlacementBuffer Expected;
                 const FString& Path = "TestPath";
                 TArray<FTransform> Transforms;
                 Transforms.Add(FTransform());
-                Expected.Add(Path, Transforms);
+                Expected.Append(*Path, Transforms);
 
                 Config->SpawnedObjects = Expected;
                 const TArray<TSharedPtr<FJsonValue>> ResultsArray = Config->SerializeToJson()->GetArrayField(
@@ -61,13 +61,13 @@ void SpawnedObjectConfigSpec::Define()
 
             It("sets values correctly when there is one ActorToSpawn pathname and multiple transforms", [this]()
             {
-                TMap<FString, TArray<FTransform>> Expected;
+                FPlacementBuffer Expected;
                 const FString& Path = "TestPath";
                 TArray<FTransform> Transforms;
                 const FTransform TransformTwo(FRotator(), FVector(100, 100, 0));
                 Transforms.Add(FTransform());
                 Transforms.Add(TransformTwo);
-                Expected.Add(Path, Transforms);
+                Expected.Append(*Path, Transforms);
 
                 Config->SpawnedObjects = Expected;
                 const TArray<TSharedPtr<FJsonValue>> ResultsArray = Config->SerializeToJson()->GetArrayField(
@@ -85,7 +85,7 @@ void SpawnedObjectConfigSpec::Define()
 
             It("sets values correctly when there are multiple ActorToSpawn pathnames and multiple transforms", [this]()
             {
-                TMap<FString, TArray<FTransform>> Expected;
+                FPlacementBuffer Expected;
                 const FString& Path = "TestPath";
                 const FString& OtherPath = "AnotherTestPath";
                 TArray<FTransform> TransformsOne;
@@ -94,8 +94,8 @@ void SpawnedObjectConfigSpec::Define()
                 TArray<FTransform> TransformsTwo;
                 TransformsTwo.Add(TransformTwo);
 
-                Expected.Add(Path, TransformsOne);
-                Expected.Add(OtherPath, TransformsTwo);
+                Expected.Append(*Path, TransformsOne);
+                Expected.Append(*OtherPath, TransformsTwo);
 
                 Config->SpawnedObjects = Expected;
 
@@ -104,15 +104,60 @@ void SpawnedObjectConfigSpec::Define()
                 for (const TSharedPtr<FJsonValue>& Result : ResultsArray)
                 {
                     const TSharedPtr<FJsonObject>& Object = Result->AsObject();
-                    TestTrue("Path Name", Expected.Contains(Object->GetStringField("ActorToSpawn")));
-                    const TArray<FTransform>& ExpectedTransforms = *Expected.Find(
-                        Object->GetStringField("ActorToSpawn"));
+                    const FPlacementBuffer::FPlacements* ExpectedPlacements = Expected.Find(
+                        *Object->GetStringField("ActorToSpawn"));
+                    TestNotNull("Path Name", ExpectedPlacements);
+                    if (ExpectedPlacements == nullptr)
+                    {
+                        continue;
+                    }
+                    const TArray<FTransform> ExpectedTransforms = ExpectedPlacements->GetTransforms();
                     TestTrue("Location", ExpectedTransforms[0].GetLocation().Equals(
                                  FJsonHelpers::DeserializeToVector3(Object->GetArrayField("Location"))));
                     TestTrue("Rotation", ExpectedTransforms[0].Rotator().Equals(
                                  FJsonHelpers::DeserializeToRotation(Object->GetArrayField("Rotation"))));
                 }
             });
+
+            It("writes the rotation of the transform that was added", [this]()
+            {
+                const FRotator Rotation(12.345f, -123.456f, 78.9f);
+                Config->SpawnedObjects.Add("TestPath", FTransform(Rotation, FVector(1, 2, 3)));
+
+                const TArray<TSharedPtr<FJsonValue>> ResultsArray = Config->SerializeToJson()->GetArrayField(
+                    "SpawnedObjects");
+                TestEqual("One object", ResultsArray.Num(), 1);
+                const TSharedPtr<FJsonObject>& Object = ResultsArray[0]->AsObject();
+                TestTrue("Rotation", FTransform(Rotation).Rotator().Equals(
+                             FJsonHelpers::DeserializeToRotation(Object->GetArrayField("Rotation"))));
+            });
+        });
+    });
+
+    Describe("WriteSpawnedObjectsToJson()", [this]()
+    {
+        BeforeEach([this]()
+        {
+            Config = NewObject<USpawnedObjectConfig>();
+        });
+
+        It("writes the same document as SerializeToJson", [this]()
+        {
+            TArray<FTransform> Transforms;
+            Transforms.Add(FTransform(FRotator(12.345f, -123.456f, 78.9f), FVector(1.5f, -2.25f, 1000.125f)));
+            Transforms.Add(FTransform(FRotator(), FVector(100, 100, 0)));
+            Config->SpawnedObjects.Append("TestPath", Transforms);
+            Config->SpawnedObjects.Add("AnotherTestPath", FTransform(FVector(-0.1f, 0.2f, 0.3f)));
+
+            const FString Streamed = FJsonHelpers::WriteJson(
+                [this](const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+                {
+                    Writer->WriteArrayStart("SpawnedObjects");
+                    Config->WriteSpawnedObjectsToJson(Writer);
+                    Writer->WriteArrayEnd();
+                });
+
+            TestEqual("Streamed Json", Streamed, FJsonHelpers::SerializeJson(Config->SerializeToJson()));
         });
     });
 }
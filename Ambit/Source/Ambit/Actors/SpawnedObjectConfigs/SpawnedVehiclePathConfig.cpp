@@ -31,6 +31,7 @@ TSharedPtr<FJsonObject> USpawnedVehiclePathConfig::SerializeToJson() const
         Json->SetNumberField(JsonConstants::AmbitPathGenerator::KSpeedLimit, SpeedLimit);
 
         TArray<TSharedPtr<FJsonValue>> WaypointsJson;
+        WaypointsJson.Reserve(Waypoints.Num());
         for (const FVector& Waypoint : Waypoints)
         {
             WaypointsJson.Add(MakeShareable(new FJsonValueArray(FJsonHelpers::SerializeVector3(Waypoint))));
@@ -24,6 +24,7 @@
 
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
 #include "Ambit/Utils/AmbitWorldHelpers.h"
 
 #include <AmbitUtils/MenuHelpers.h>
@@ -59,7 +60,7 @@ void ASpawnInVolume::PostEditChangeProperty(FPropertyChangedEvent& PropertyChang
     // If the game is running, regenerate actors whenever the user changes parameters.
     if (GetWorld()->bBegunPlay)
     {
-        GenerateActors();
+        ScheduleRegeneration(PropertyChangedEvent);
     }
 }
 
@@ -78,16 +79,37 @@ void ASpawnInVolume::Configure(const TSharedPtr<FSpawnInVolumeConfig>& Config)
     bSnapToSurfaceBelow = Config->bSnapToSurfaceBelow;
 }
 
-TMap<FString, TArray<FTransform>> ASpawnInVolume::GenerateActors()
+FSpawnerTransformGenerator ASpawnInVolume::MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const
 {
-    TMap<FString, TArray<FTransform>> SpawnedObject;
-
-    if (!AreParametersValid())
+    // Checks if the box component is not two-dimensional
+    if (!FMath::IsNearlyEqual(Box->GetScaledBoxExtent().Z, 0.f))
     {
-        UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel());
-        return SpawnedObject;
+        UE_LOG(LogAmbit, Warning,
+               TEXT("%s: The bound specifier is not a plane. SpawnInVolume will use the top of the box."),
+               *this->GetActorLabel());
     }
 
+    FSpawnerTransformGenerator Generator;
+    Generator.Draw = [BoxTransform = Box->GetComponentTransform(), BoxExtent = Box->GetUnscaledBoxExtent(),
+                      RandomSeed = RandomSeed, DensityMin = DensityMin, DensityMax = DensityMax,
+                      RotationMin = RotationMin, RotationMax = RotationMax,
+                      PlacementDistribution = PlacementDistribution, MinSpacing = GetMinimumSpacing(),
+                      SpawnerId = FAmbitCounterRandom::GetSpawnerId(this)]()
+    {
+        return AmbitWorldHelpers::DrawLocationsFromBox(BoxTransform, BoxExtent, RandomSeed, DensityMin, DensityMax,
+                                                       RotationMin, RotationMax, PlacementDistribution, MinSpacing,
+                                                       SpawnerId);
+    };
+    Generator.Snap = [bSnapToSurfaceBelow = bSnapToSurfaceBelow](
+        const AmbitWorldHelpers::FPlacementCandidates& Candidates, const TArray<AActor*>& Surfaces)
+    {
+        return AmbitWorldHelpers::SnapToSurfaces(Candidates, Surfaces, bSnapToSurfaceBelow, false);
+    };
+    return Generator;
+}
+
+bool ASpawnInVolume::AreParametersValid() const
+{
     const FRotator& BoxRotation = Box->GetComponentTransform().Rotator();
     if (!FMath::IsNearlyEqual(BoxRotation.Roll, 0.f) || !FMath::IsNearlyEqual(BoxRotation.Pitch, 0.f))
     {
@@ -96,30 +118,7 @@ TMap<FString, TArray<FTransform>> ASpawnInVolume::GenerateActors()
                 "The bound specifier of %s is not flat, which is not allowed. Please set roll (x) and pitch (y) values to 0."),
             *this->GetActorLabel());
         FMenuHelpers::DisplayMessagePopup(Message, "Warning");
-        return SpawnedObject;
-    }
-    UE_LOG(LogAmbit, Display, TEXT("%s: Generating actors."), *this->GetActorLabel())
-
-    // Remove any previously spawned actors.
-    DestroyGeneratedActors();
-
-    const TArray<AActor*>& SurfacesToHit = AmbitWorldHelpers::GetActorsByMatchBy(
-        MatchBy, SurfaceNamePattern, SurfaceTags);
-
-    // Checks if the box component is not two-dimensional
-    if (!FMath::IsNearlyEqual(Box->GetScaledBoxExtent().Z, 0.f))
-    {
-        UE_LOG(LogAmbit, Warning,
-               TEXT("%s: The bound specifier is not a plane. SpawnInVolume will use the top of the box."),
-               *this->GetActorLabel());
-    }
-
-    const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromBox(
-        Box, SurfacesToHit, RandomSeed, bSnapToSurfaceBelow, DensityMin, DensityMax, RotationMin, RotationMax);
-
-    if (Transforms.Num() > 0)
-    {
-        SpawnActorsAtTransforms(Transforms, SpawnedObject);
+        return false;
     }
-    return SpawnedObject;
+    return Super::AreParametersValid();
 }
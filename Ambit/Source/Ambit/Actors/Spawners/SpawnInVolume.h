@@ -60,6 +60,9 @@ public:
     void Configure(const TSharedPtr<FSpawnInVolumeConfig>& Config);
 
 private:
-    // Spawns actors as specified by this object's parameters.
-    TMap<FString, TArray<FTransform>> GenerateActors() override;
+    // Returns the steps that compute the placements for this object's parameters on SurfaceActors.
+    FSpawnerTransformGenerator MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const override;
+
+    // Also requires the box to be flat.
+    bool AreParametersValid() const override;
 };
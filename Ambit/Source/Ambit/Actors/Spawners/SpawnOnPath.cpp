@@ -23,6 +23,7 @@
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Actors/SpawnerConfigs/SpawnOnPathConfig.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
 #include "Ambit/Utils/AmbitWorldHelpers.h"
 
 ASpawnOnPath::ASpawnOnPath()
@@ -47,7 +48,7 @@ void ASpawnOnPath::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
     // If the game is running, regenerate actors whenever the user changes parameters.
     if (GetWorld()->bBegunPlay)
     {
-        GenerateActors();
+        ScheduleRegeneration(PropertyChangedEvent);
     }
 }
 
@@ -82,31 +83,25 @@ void ASpawnOnPath::Configure(const TSharedPtr<FSpawnOnPathConfig>& Config)
     bSnapToSurfaceBelow = Config->bSnapToSurfaceBelow;
 }
 
-TMap<FString, TArray<FTransform>> ASpawnOnPath::GenerateActors()
+FSpawnerTransformGenerator ASpawnOnPath::MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const
 {
-    TMap<FString, TArray<FTransform>> SpawnedObjects;
-    if (!AreParametersValid())
+    // The spline is copied so that the user can keep editing it.
+    FSpawnerTransformGenerator Generator;
+    Generator.Draw = [SplineSnapshot = AmbitSplineSampler::FSplineSnapshot(*Spline), RandomSeed = RandomSeed,
+                      DensityMin = DensityMin, DensityMax = DensityMax, RotationMin = RotationMin,
+                      RotationMax = RotationMax, bFollowSplineRotation = bFollowSplineRotation,
+                      PlacementDistribution = PlacementDistribution, MinSpacing = GetMinimumSpacing(),
+                      SpawnerId = FAmbitCounterRandom::GetSpawnerId(this)]()
     {
-        UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel())
-        return SpawnedObjects;
-    }
-
-    UE_LOG(LogAmbit, Display, TEXT("%s: Generating actors."), *this->GetActorLabel())
-
-    // Remove any previously spawned actors.
-    DestroyGeneratedActors();
-
-    const TArray<AActor*>& SurfacesToHit = AmbitWorldHelpers::GetActorsByMatchBy(
-        MatchBy, SurfaceNamePattern, SurfaceTags);
-
-    const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromSpline(
-        Spline, SurfacesToHit, RandomSeed, bSnapToSurfaceBelow, DensityMin, DensityMax, RotationMin, RotationMax,
-        bFollowSplineRotation);
-
-    if (Transforms.Num() > 0)
+        return AmbitWorldHelpers::DrawLocationsFromSpline(SplineSnapshot, RandomSeed, DensityMin, DensityMax,
+                                                          RotationMin, RotationMax, bFollowSplineRotation,
+                                                          PlacementDistribution, MinSpacing, SpawnerId);
+    };
+    Generator.Snap = [bSnapToSurfaceBelow = bSnapToSurfaceBelow](
+        const AmbitWorldHelpers::FPlacementCandidates& Candidates, const TArray<AActor*>& Surfaces)
     {
-        SpawnActorsAtTransforms(Transforms, SpawnedObjects);
-    }
-
-    return SpawnedObjects;
+        // Traced against the matched surfaces only, so that props above them do not block placements.
+        return AmbitWorldHelpers::SnapToSurfaces(Candidates, Surfaces, bSnapToSurfaceBelow, true);
+    };
+    return Generator;
 }
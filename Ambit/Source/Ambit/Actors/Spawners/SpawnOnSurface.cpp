@@ -22,6 +22,7 @@
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Actors/SpawnerConfigs/SpawnerBaseConfig.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
 #include "Ambit/Utils/AmbitWorldHelpers.h"
 
 ASpawnOnSurface::ASpawnOnSurface()
@@ -40,7 +41,7 @@ void ASpawnOnSurface::PostEditChangeProperty(FPropertyChangedEvent& PropertyChan
     // If the game is running, regenerate actors whenever the user changes parameters.
     if (GetWorld()->bBegunPlay)
     {
-        GenerateActors();
+        ScheduleRegeneration(PropertyChangedEvent);
     }
 }
 
@@ -54,32 +55,44 @@ void ASpawnOnSurface::Configure(const TSharedPtr<FSpawnerBaseConfig>& Config)
     Super::Configure<FSpawnerBaseConfig>(Config);
 }
 
-TMap<FString, TArray<FTransform>> ASpawnOnSurface::GenerateActors()
+FSpawnerTransformGenerator ASpawnOnSurface::MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const
 {
-    TMap<FString, TArray<FTransform>> SpawnedObjects;
-    if (!AreParametersValid())
-    {
-        UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel())
-        return SpawnedObjects;
-    }
-
-    UE_LOG(LogAmbit, Display, TEXT("%s: Generating actors."), *this->GetActorLabel())
-
-    // Remove any previously spawned actors.
-    DestroyGeneratedActors();
-
-    const TArray<AActor*>& SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
-        MatchBy, SurfaceNamePattern, SurfaceTags);
-
     UE_LOG(LogAmbit, Display, TEXT("%s: Matching surface actors: %i"), *this->GetActorLabel(), SurfaceActors.Num());
 
-    const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
-        SurfaceActors, RandomSeed, DensityMin, DensityMax, RotationMin, RotationMax);
-
-    if (Transforms.Num() > 0)
+    FSpawnerTransformGenerator Generator;
+    if (SurfaceSamplingMode == ESurfaceSamplingMode::MeshTriangles)
     {
-        SpawnActorsAtTransforms(Transforms, SpawnedObjects);
+        // Samples land on the triangles, so nothing is left to snap.
+        Generator.Draw = [Surfaces = AmbitWorldHelpers::GetSurfaceTriangles(SurfaceActors), RandomSeed = RandomSeed,
+                          DensityMin = DensityMin, DensityMax = DensityMax, RotationMin = RotationMin,
+                          RotationMax = RotationMax, SpawnerId = FAmbitCounterRandom::GetSpawnerId(this)]()
+        {
+            AmbitWorldHelpers::FPlacementCandidates Candidates;
+            Candidates.Transforms = AmbitWorldHelpers::DrawLocationsFromTriangles(
+                Surfaces, RandomSeed, DensityMin, DensityMax, RotationMin, RotationMax, SpawnerId);
+            return Candidates;
+        };
+        Generator.Snap = [](const AmbitWorldHelpers::FPlacementCandidates& Candidates, const TArray<AActor*>&)
+        {
+            return Candidates.Transforms;
+        };
+        return Generator;
     }
 
-    return SpawnedObjects;
+    Generator.Draw = [Surfaces = AmbitWorldHelpers::GetSurfaceExtents(SurfaceActors), RandomSeed = RandomSeed,
+                      DensityMin = DensityMin, DensityMax = DensityMax, RotationMin = RotationMin,
+                      RotationMax = RotationMax, PlacementDistribution = PlacementDistribution,
+                      MinSpacing = GetMinimumSpacing(), SpawnerId = FAmbitCounterRandom::GetSpawnerId(this)]()
+    {
+        return AmbitWorldHelpers::DrawLocationsFromSurfaces(Surfaces, RandomSeed, DensityMin, DensityMax,
+                                                            RotationMin, RotationMax, true, PlacementDistribution,
+                                                            MinSpacing, SpawnerId);
+    };
+    Generator.Snap = [](const AmbitWorldHelpers::FPlacementCandidates& Candidates,
+                        const TArray<AActor*>& Surfaces)
+    {
+        // Traced against the matched surfaces only, so that props above them do not block placements.
+        return AmbitWorldHelpers::SnapToOwnSurfaces(Candidates, Surfaces, true, true);
+    };
+    return Generator;
 }
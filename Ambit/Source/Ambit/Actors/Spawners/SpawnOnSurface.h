@@ -18,6 +18,7 @@
 #include "SpawnerBase.h"
 
 #include "Ambit/Actors/SpawnerConfigs/SpawnerBaseConfig.h"
+#include "Ambit/Utils/SurfaceSamplingMode.h"
 
 #include "SpawnOnSurface.generated.h"
 
@@ -34,6 +35,16 @@ public:
     // Sets default values for this actor's properties
     ASpawnOnSurface();
 
+    /**
+     * How spawn locations are chosen on the matched surfaces.
+     * Trace bounding box draws points in the surfaces' bounding boxes and keeps those
+     * that hit the surface, so sparse surfaces receive fewer items than requested.
+     * Sample mesh triangles draws points directly from the surfaces' static mesh triangles
+     * and ignores Placement Distribution.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    TEnumAsByte<ESurfaceSamplingMode> SurfaceSamplingMode = ESurfaceSamplingMode::BoundsTrace;
+
     /**
      * See https://docs.unrealengine.com/4.26/en-US/API/Runtime/Engine/GameFramework/AActor/PostEditChangeProperty/
      */
@@ -51,6 +62,6 @@ public:
 
 
 private:
-    // Spawns actors as specified by this object's parameters.
-    TMap<FString, TArray<FTransform>> GenerateActors() override;
+    // Returns the steps that compute the placements for this object's parameters on SurfaceActors.
+    FSpawnerTransformGenerator MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const override;
 };
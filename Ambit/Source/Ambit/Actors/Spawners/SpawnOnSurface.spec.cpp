@@ -326,6 +326,32 @@ void SpawnOnSurfaceSpec::Define()
         });
     });
 
+    Describe("GetSpawnProgress()", [this]()
+    {
+        It("is complete when nothing is being spawned", [this]()
+        {
+            TestEqual("SpawnProgress", Spawner->GetSpawnProgress(), 1.f);
+        });
+
+        It("is complete after a generation without surfaces", [this]()
+        {
+            Spawner->ActorsToSpawn.Add(FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C")
+                .TryLoadClass<AActor>());
+            Spawner->SurfaceNamePattern = "NoSurfaceHasThisName";
+
+            bool bCompleted = false;
+            Spawner->GetOnSpawnedObjectConfigCompletedDelegate().BindLambda(
+                [&bCompleted](TScriptInterface<IConfigJsonSerializer>& Config, bool bSuccess)
+                {
+                    bCompleted = bSuccess;
+                });
+            Spawner->GenerateSpawnedObjectConfiguration();
+
+            TestTrue("Completed", bCompleted);
+            TestEqual("SpawnProgress", Spawner->GetSpawnProgress(), 1.f);
+        });
+    });
+
     AfterEach([this]()
     {
         Spawner->Destroy();
@@ -128,23 +128,18 @@ void ASpawnVehiclePath::GenerateSpawnedObjectConfiguration()
 {
     USpawnedVehiclePathConfig* Config = NewObject<USpawnedVehiclePathConfig>();
 
-    const FString& PathName = VehicleToSpawn.Get()->GetPathName();
-
-    Config->SpawnedVehicle = PathName;
-
     Config->SpeedLimit = SpeedLimit * 250.f / 9.f;
 
     const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateFixedLocationsFromSpline(
         Spline, DistanceBetweenWaypoints * 100);
 
-    TArray<FVector> Waypoints;
+    Config->SpawnedVehicle = VehicleToSpawn.Get()->GetPathName();
+    Config->Waypoints.Reserve(Transforms.Num());
     for (const FTransform& Transform : Transforms)
     {
-        Waypoints.Emplace(Transform.GetLocation());
+        Config->Waypoints.Emplace(Transform.GetLocation());
     }
 
-    Config->Waypoints = Waypoints;
-
     auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
     OnSpawnedObjectConfigCompleted.ExecuteIfBound(FinalConfig, true);
 }
@@ -16,9 +16,16 @@
 
 #include "SpawnWithHoudini.h"
 
+#include "HoudiniAssetActor.h"
 #include "HoudiniPublicAPI.h"
 #include "HoudiniPublicAPIBlueprintLib.h"
+#include "HoudiniPublicAPIInputTypes.h"
 #include "Components/BillboardComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Containers/Ticker.h"
 #include "UObject/ConstructorHelpers.h"
 
 #include <stdexcept>
@@ -26,10 +33,43 @@
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
+#include "Ambit/Utils/AmbitHoudiniBakeCache.h"
 #include "Ambit/Utils/AmbitWorldHelpers.h"
 
 #include <AmbitUtils/MenuHelpers.h>
 
+namespace
+{
+    /**
+     * Returns where a baked actor placed its objects. A batched point cloud bakes its copies
+     * as instances; each instance is one placement.
+     */
+    TArray<FTransform> GetBakedPlacements(const AActor* BakedActor)
+    {
+        TArray<UInstancedStaticMeshComponent*> Instancers;
+        BakedActor->GetComponents<UInstancedStaticMeshComponent>(Instancers);
+        if (Instancers.Num() == 0)
+        {
+            return {BakedActor->GetActorTransform()};
+        }
+
+        TArray<FTransform> Placements;
+        for (const UInstancedStaticMeshComponent* Instancer : Instancers)
+        {
+            const int32 InstanceCount = Instancer->GetInstanceCount();
+            Placements.Reserve(Placements.Num() + InstanceCount);
+            for (int32 InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+            {
+                FTransform InstanceTransform;
+                Instancer->GetInstanceTransform(InstanceIndex, InstanceTransform, true);
+                Placements.Add(InstanceTransform);
+            }
+        }
+        return Placements;
+    }
+}
+
 ASpawnWithHoudini::ASpawnWithHoudini()
 {
     IconComponent = CreateDefaultSubobject<UBillboardComponent>("Icon");
@@ -73,7 +113,6 @@ bool ASpawnWithHoudini::HasActorsToSpawn() const
 
 void ASpawnWithHoudini::GenerateObstacles()
 {
-    Random.Initialize(RandomSeed);
     const bool bDidClear = ClearObstacles();
     if (!bDidClear)
     {
@@ -85,8 +124,9 @@ void ASpawnWithHoudini::GenerateObstacles()
 
     UE_LOG(LogAmbit, Display, TEXT("Matching surface actors: %i"), SurfaceActors.Num());
 
+    const uint32 SpawnerId = FAmbitCounterRandom::GetSpawnerId(this);
     TArray<FTransform> LocationsToSpawn = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
-        SurfaceActors, RandomSeed, DensityMin, DensityMax);
+        SurfaceActors, RandomSeed, DensityMin, DensityMax, 0.0, 360.0, true, UniformRandom, 0.0, SpawnerId);
 
     UWorld* World = GetWorld();
 
@@ -102,32 +142,103 @@ void ASpawnWithHoudini::GenerateObstacles()
         }
     }
 
-    HoudiniApi->CreateSession();
-    for (const FTransform& Transform : LocationsToSpawn)
+    const FAmbitCounterRandom AssetRandom(RandomSeed, SpawnerId);
+    // Keep the session warm across generations and permutations; starting one costs far more than a cook.
+    if (!HoudiniApi->IsSessionValid())
+    {
+        HoudiniApi->CreateSession();
+    }
+    CookScheduler.SetMaxConcurrentCooks(MaxConcurrentCooks);
+    for (int32 TransformIndex = 0; TransformIndex < LocationsToSpawn.Num(); TransformIndex++)
     {
-        const int32 Index = Random.RandRange(0, HoudiniAssetDetails.Num() - 1);
+        const FTransform& Transform = LocationsToSpawn[TransformIndex];
+        const int32 Index = AssetRandom.RandRange(TransformIndex, EAmbitRandomChannel::ActorClass, 0,
+                                                  HoudiniAssetDetails.Num() - 1);
         UHoudiniAsset* IndividualHDA = HoudiniAssetDetails[Index].HDAToLoad;
         // Check whether the HDA Asset has been selected
-        if (IndividualHDA != nullptr)
+        if (IndividualHDA == nullptr)
         {
-            FString BakePath = GetBakePathRelative();
-            UHoudiniPublicAPIAssetWrapper* SpawnedActor = HoudiniApi->InstantiateAsset(
-                IndividualHDA, Transform, World, nullptr, false, false, BakePath);
+            continue;
+        }
+
+        if (bBatchAsPointCloud)
+        {
+            HoudiniAssetDetails[Index].PointCloudTransforms.Add(Transform);
+            continue;
+        }
+
+        UHoudiniPublicAPIAssetWrapper* SpawnedActor = InstantiateHDA(IndividualHDA, Transform);
+        if (SpawnedActor != nullptr)
+        {
+            AddSpawnedAsset(SpawnedActor, Index);
+        }
+    }
+
+    if (bBatchAsPointCloud)
+    {
+        // One instance per HDA; the placements are in world space so the instance stays at the origin.
+        for (int32 ListNumber = 0; ListNumber < HoudiniAssetDetails.Num(); ListNumber++)
+        {
+            const FHoudiniLoadableAsset& AssetDetails = HoudiniAssetDetails[ListNumber];
+            if (AssetDetails.PointCloudTransforms.Num() == 0)
+            {
+                continue;
+            }
+
+            UHoudiniPublicAPIAssetWrapper* SpawnedActor = InstantiateHDA(AssetDetails.HDAToLoad,
+                                                                         FTransform::Identity);
             if (SpawnedActor != nullptr)
             {
-                SpawnedActor->GetOnPreInstantiationDelegate().AddUniqueDynamic(
-                    this, &ASpawnWithHoudini::AssetPreInstantiation_DelegateHandler);
-                SpawnedActor->GetOnPostProcessingDelegate().AddUniqueDynamic(
-                    this, &ASpawnWithHoudini::PostProcessing_DelegateHandler);
-                SpawnedActor->GetOnPostBakeDelegate().AddUniqueDynamic(
-                    this, &ASpawnWithHoudini::PostBake_DelegateHandler);
-
-                HoudiniAssetDetails[Index].SpawnedActors.Add(SpawnedActor);
+                SpawnedActor->GetOnPostInstantiationDelegate().AddUniqueDynamic(
+                    this, &ASpawnWithHoudini::AssetPostInstantiation_DelegateHandler);
+                AddSpawnedAsset(SpawnedActor, ListNumber);
             }
         }
     }
 }
 
+UHoudiniPublicAPIAssetWrapper* ASpawnWithHoudini::InstantiateHDA(UHoudiniAsset* HDA, const FTransform& Transform)
+{
+    FString BakePath = GetBakePathRelative();
+    UHoudiniPublicAPIAssetWrapper* SpawnedActor = HoudiniApi->InstantiateAsset(
+        HDA, Transform, GetWorld(), nullptr, false, false, BakePath);
+    if (SpawnedActor != nullptr)
+    {
+        SpawnedActor->GetOnPreInstantiationDelegate().AddUniqueDynamic(
+            this, &ASpawnWithHoudini::AssetPreInstantiation_DelegateHandler);
+        SpawnedActor->GetOnPostProcessingDelegate().AddUniqueDynamic(
+            this, &ASpawnWithHoudini::PostProcessing_DelegateHandler);
+        SpawnedActor->GetOnPostBakeDelegate().AddUniqueDynamic(
+            this, &ASpawnWithHoudini::PostBake_DelegateHandler);
+    }
+
+    return SpawnedActor;
+}
+
+void ASpawnWithHoudini::AddSpawnedAsset(UHoudiniPublicAPIAssetWrapper* SpawnedActor, int32 ListNumber)
+{
+    const int32 IndexInList = HoudiniAssetDetails[ListNumber].SpawnedActors.Add(SpawnedActor);
+    SpawnedAssetIndices.Add(SpawnedActor, {ListNumber, IndexInList});
+}
+
+void ASpawnWithHoudini::ScheduleCook(UHoudiniPublicAPIAssetWrapper* SpawnedActor)
+{
+    TWeakObjectPtr<UHoudiniPublicAPIAssetWrapper> WeakActor(SpawnedActor);
+    CookScheduler.Enqueue([this, WeakActor]()
+    {
+        UHoudiniPublicAPIAssetWrapper* ActorToCook = WeakActor.Get();
+        if (ActorToCook == nullptr || !ActorToCook->IsValidLowLevel())
+        {
+            // The instance was deleted while it waited; give its turn to the next one.
+            CookScheduler.FinishCook();
+            return;
+        }
+
+        ActorToCook->GetOnPostCookDelegate().AddUniqueDynamic(this, &ASpawnWithHoudini::PostCook_DelegateHandler);
+        ActorToCook->Recook();
+    });
+}
+
 bool ASpawnWithHoudini::ClearObstacles()
 {
     UWorld* World = GetWorld();
@@ -153,10 +264,18 @@ bool ASpawnWithHoudini::ClearObstacles()
         }
 
         LoadedSet.SpawnedActors.Empty();
+        LoadedSet.PointCloudTransforms.Empty();
     }
 
     CurrentGeneration = NotGenerated;
+    SpawnedAssetIndices.Empty();
+    CookScheduler.Reset();
     ActorBakeCount = 0;
+    PendingBakes.Empty();
+    BakeCaptures.Empty();
+    BakedPlacements.Empty();
+    BakedActorsToDestroy.Empty();
+    BakedPackageFiles.Empty();
     CachedActorCount = 0;
     return true;
 }
@@ -165,11 +284,8 @@ void ASpawnWithHoudini::PopulateParameters(UHoudiniPublicAPIAssetWrapper* Spawne
 {
     if (SpawnedActor->IsValidLowLevel())
     {
-        const int32 FoundAsset = HoudiniAssetDetails.IndexOfByPredicate(
-            [SpawnedActor](const FHoudiniLoadableAsset& asset)
-            {
-                return asset.SpawnedActors.Contains(SpawnedActor);
-            });
+        const FSpawnedAssetIndex* SpawnedAsset = FindSpawnedAsset(SpawnedActor);
+        const int32 FoundAsset = SpawnedAsset != nullptr ? SpawnedAsset->ListNumber : INDEX_NONE;
 
         if (FoundAsset != INDEX_NONE && HoudiniAssetDetails[FoundAsset].ParamsToRandom.Num() == 0)
         {
@@ -195,13 +311,9 @@ void ASpawnWithHoudini::RandomizeActor(UHoudiniPublicAPIAssetWrapper* SpawnedAct
 {
     if (SpawnedActor->IsValidLowLevel())
     {
-        int32 AssetIndexInList = INDEX_NONE;
-        const int32 ListNumber = HoudiniAssetDetails.IndexOfByPredicate(
-            [SpawnedActor, &AssetIndexInList](const FHoudiniLoadableAsset& asset)
-            {
-                AssetIndexInList = asset.SpawnedActors.IndexOfByKey(SpawnedActor);
-                return AssetIndexInList != INDEX_NONE;
-            });
+        const FSpawnedAssetIndex* SpawnedAsset = FindSpawnedAsset(SpawnedActor);
+        const int32 ListNumber = SpawnedAsset != nullptr ? SpawnedAsset->ListNumber : INDEX_NONE;
+        const int32 AssetIndexInList = SpawnedAsset != nullptr ? SpawnedAsset->IndexInList : INDEX_NONE;
 
         TMap<FName, FHoudiniParameterTuple> ActorExistingParameterMap;
         TMap<FName, FHoudiniParameterTuple> ActorNewParameterMap;
@@ -294,7 +406,10 @@ void ASpawnWithHoudini::RandomizeActor(UHoudiniPublicAPIAssetWrapper* SpawnedAct
             const bool bResolved = SpawnedActor->SetParameterTuples(ActorNewParameterMap);
             if (bResolved)
             {
-                SpawnedActor->Recook();
+                if (!RestoreFromBakeCache(SpawnedActor, ActorNewParameterMap, ListNumber))
+                {
+                    ScheduleCook(SpawnedActor);
+                }
                 ActorExistingParameterMap.Empty();
             }
             else
@@ -336,6 +451,7 @@ void ASpawnWithHoudini::ResetObstacleSpawner()
     SurfaceTags.Empty();
     MatchBy = NameAndTags;
     RandomSeed = 0;
+    bBatchAsPointCloud = false;
 }
 
 void ASpawnWithHoudini::GenerateSpawnedObjectConfiguration()
@@ -420,12 +536,75 @@ void ASpawnWithHoudini::AssetPreInstantiation_DelegateHandler(UHoudiniPublicAPIA
         this, &ASpawnWithHoudini::AssetPreInstantiation_DelegateHandler);
 }
 
+void ASpawnWithHoudini::AssetPostInstantiation_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor)
+{
+    SpawnedActor->GetOnPostInstantiationDelegate().RemoveDynamic(
+        this, &ASpawnWithHoudini::AssetPostInstantiation_DelegateHandler);
+
+    const FSpawnedAssetIndex* SpawnedAsset = FindSpawnedAsset(SpawnedActor);
+    if (SpawnedAsset == nullptr)
+    {
+        return;
+    }
+
+    const FHoudiniLoadableAsset* AssetDetails = &HoudiniAssetDetails[SpawnedAsset->ListNumber];
+    if (AssetDetails->PointCloudTransforms.Num() == 0)
+    {
+        return;
+    }
+
+    // A points-only curve carries each placement's position, rotation and scale as point attributes.
+    UHoudiniPublicAPICurveInput* PointCloudInput = Cast<UHoudiniPublicAPICurveInput>(
+        SpawnedActor->CreateEmptyInput(UHoudiniPublicAPICurveInput::StaticClass()));
+    if (PointCloudInput == nullptr)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("Could not create a point cloud input for spawner %s and object %s."),
+               *this->GetActorLabel(), *SpawnedActor->GetName());
+        return;
+    }
+
+    UHoudiniPublicAPICurveInputObject* Points = NewObject<UHoudiniPublicAPICurveInputObject>(PointCloudInput);
+    Points->SetCurveType(EHoudiniPublicAPICurveType::Points);
+    Points->SetCurvePoints(AssetDetails->PointCloudTransforms);
+    PointCloudInput->SetInputObjects({Points});
+
+    if (!SpawnedActor->SetInputAtIndex(PointCloudInputIndex, PointCloudInput))
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("Could not set input %i of object %s for spawner %s."), PointCloudInputIndex,
+               *SpawnedActor->GetName(), *this->GetActorLabel());
+    }
+}
+
+void ASpawnWithHoudini::PostCook_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor, bool bCookSuccess)
+{
+    SpawnedActor->GetOnPostCookDelegate().RemoveDynamic(this, &ASpawnWithHoudini::PostCook_DelegateHandler);
+    CookScheduler.FinishCook();
+
+    UE_LOG(LogAmbit, Display, TEXT("Houdini cooks for spawner %s: %i of %i done, %i cooking, %.2f per second."),
+           *this->GetActorLabel(), CookScheduler.NumFinished(), CookScheduler.NumScheduled(),
+           CookScheduler.NumInFlight(), CookScheduler.GetCooksPerSecond());
+    if (!bCookSuccess)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("Houdini Asset %s failed to cook for spawner %s."), *SpawnedActor->GetName(),
+               *this->GetActorLabel());
+    }
+}
+
 void ASpawnWithHoudini::PostProcessing_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor)
 {
     if (IsExportSdf())
     {
         SpawnedActor->SetRemoveOutputAfterBake(true);
+
+        // The bake spawns its actors before it returns. Capture them as they are added,
+        // so that PostBake_DelegateHandler does not have to look for them.
+        const FDelegateHandle CaptureHandle = GEngine->OnLevelActorAdded().AddWeakLambda(
+            this, [this, SpawnedActor](AActor* BakedActor)
+            {
+                BakeCaptures.FindOrAdd(SpawnedActor).Add(BakedActor);
+            });
         SpawnedActor->BakeAllOutputs();
+        GEngine->OnLevelActorAdded().Remove(CaptureHandle);
     }
 
     PostProcessingDone.ExecuteIfBound();
@@ -436,12 +615,8 @@ void ASpawnWithHoudini::PostBake_DelegateHandler(UHoudiniPublicAPIAssetWrapper*
 {
     if (bSuccess)
     {
-        ActorBakeCount++;
-
-        if (ActorBakeCount == GetActorCount() && OnSpawnedObjectConfigCompleted.IsBound())
-        {
-            CreateSpawnedObjectConfiguration();
-        }
+        RecordBake(SpawnedActor);
+        OnAssetBaked();
     }
     else
     {
@@ -459,6 +634,125 @@ void ASpawnWithHoudini::PostBake_DelegateHandler(UHoudiniPublicAPIAssetWrapper*
     SpawnedActor->GetOnPostBakeDelegate().RemoveDynamic(this, &ASpawnWithHoudini::PostBake_DelegateHandler);
 }
 
+void ASpawnWithHoudini::OnAssetBaked()
+{
+    ActorBakeCount++;
+
+    if (ActorBakeCount == GetActorCount() && OnSpawnedObjectConfigCompleted.IsBound())
+    {
+        CreateSpawnedObjectConfiguration();
+    }
+}
+
+bool ASpawnWithHoudini::RestoreFromBakeCache(UHoudiniPublicAPIAssetWrapper* SpawnedActor,
+                                             const TMap<FName, FHoudiniParameterTuple>& Parameters,
+                                             int32 ListNumber)
+{
+    if (!bUseBakeCache || !IsExportSdf() || ListNumber == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const FHoudiniLoadableAsset& AssetDetails = HoudiniAssetDetails[ListNumber];
+    const FString Key = FAmbitHoudiniBakeCache::MakeKey(AssetDetails.HDAToLoad, Parameters,
+                                                        AssetDetails.PointCloudTransforms);
+    const AActor* AssetActor = SpawnedActor->GetHoudiniAssetActor();
+    const FTransform InstanceTransform = AssetActor != nullptr ? AssetActor->GetActorTransform() : FTransform::Identity;
+
+    // Bakes are restored into the bake folder under their original names, so that the configuration
+    // is the same whether the bake cache hits or misses.
+    TArray<FAmbitHoudiniBakeCache::FBakedFile> Files;
+    FAmbitHoudiniBakeCache& BakeCache = FAmbitHoudiniBakeCache::Get();
+    if (!BakeCache.Restore(Key, GetBakePathFull(), Files))
+    {
+        PendingBakes.Add(SpawnedActor, {Key, InstanceTransform});
+        return false;
+    }
+
+    for (const FAmbitHoudiniBakeCache::FBakedFile& File : Files)
+    {
+        TArray<FTransform> Placements;
+        Placements.Reserve(File.RelativeTransforms.Num());
+        for (const FTransform& RelativeTransform : File.RelativeTransforms)
+        {
+            Placements.Add(RelativeTransform * InstanceTransform);
+        }
+        RecordBakedFile(File.FileName, Placements);
+    }
+
+    UE_LOG(LogAmbit, Display, TEXT("Bake cache for spawner %s: %i hits, %i misses."), *this->GetActorLabel(),
+           BakeCache.GetHitCount(), BakeCache.GetMissCount());
+
+    // Nothing is cooked, so no bake will count this instance. Count it on the next tick rather than
+    // inside Houdini's delegate, since completing the export deletes the instance.
+    TWeakObjectPtr<ASpawnWithHoudini> WeakThis(this);
+    FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+    {
+        if (ASpawnWithHoudini* Spawner = WeakThis.Get())
+        {
+            Spawner->OnAssetBaked();
+        }
+        return false;
+    }));
+    return true;
+}
+
+void ASpawnWithHoudini::RecordBake(UHoudiniPublicAPIAssetWrapper* SpawnedActor)
+{
+    TArray<TWeakObjectPtr<AActor>> CapturedActors;
+    BakeCaptures.RemoveAndCopyValue(SpawnedActor, CapturedActors);
+    FPendingBake PendingBake;
+    const bool bStoreInBakeCache = PendingBakes.RemoveAndCopyValue(SpawnedActor, PendingBake);
+
+    const FString BakePathRelative = GetBakePathRelative();
+    TMap<FString, FAmbitHoudiniBakeCache::FBakedFile> Files;
+    for (const TWeakObjectPtr<AActor>& CapturedActor : CapturedActors)
+    {
+        AActor* BakedActor = CapturedActor.Get();
+        if (BakedActor == nullptr)
+        {
+            continue;
+        }
+
+        // The package baked for an actor is the one of its mesh. Only packages baked for this spawner are exported.
+        const UStaticMeshComponent* MeshComponent = BakedActor->FindComponentByClass<UStaticMeshComponent>();
+        const UStaticMesh* Mesh = MeshComponent != nullptr ? MeshComponent->GetStaticMesh() : nullptr;
+        const FString PackageName = Mesh != nullptr ? Mesh->GetOutermost()->GetName() : FString();
+        if (FPaths::GetPath(PackageName) != BakePathRelative)
+        {
+            continue;
+        }
+
+        BakedActorsToDestroy.Add(BakedActor);
+        const FString FileName = FPaths::GetCleanFilename(PackageName) + TEXT(".uasset");
+        const TArray<FTransform> Placements = GetBakedPlacements(BakedActor);
+        RecordBakedFile(FileName, Placements);
+
+        if (bStoreInBakeCache)
+        {
+            FAmbitHoudiniBakeCache::FBakedFile& File = Files.FindOrAdd(FileName);
+            File.FileName = FileName;
+            for (const FTransform& Placement : Placements)
+            {
+                File.RelativeTransforms.Add(Placement.GetRelativeTransform(PendingBake.InstanceTransform));
+            }
+        }
+    }
+
+    if (bStoreInBakeCache)
+    {
+        TArray<FAmbitHoudiniBakeCache::FBakedFile> FilesToStore;
+        Files.GenerateValueArray(FilesToStore);
+        FAmbitHoudiniBakeCache::Get().Store(PendingBake.Key, GetBakePathFull(), FilesToStore);
+    }
+}
+
+void ASpawnWithHoudini::RecordBakedFile(const FString& FileName, const TArray<FTransform>& Placements)
+{
+    BakedPlacements.FindOrAdd(FName(*FPaths::Combine(GetBakePathRelative(), FileName))).Append(Placements);
+    BakedPackageFiles.Add(FPaths::Combine(GetBakePathFull(), FileName));
+}
+
 void ASpawnWithHoudini::CreateSpawnedObjectConfiguration()
 {
     bool bSucceeded = false;
@@ -466,33 +760,26 @@ void ASpawnWithHoudini::CreateSpawnedObjectConfiguration()
 
     try
     {
-        TArray<FString> Result;
+        for (const TPair<FName, TArray<FTransform>>& Bake : BakedPlacements)
+        {
+            Config->SpawnedObjects.Append(Bake.Key, Bake.Value);
+        }
 
-        const FString PathSuffix = TEXT("uasset");
-        IFileManager::Get().FindFiles(Result, *GetBakePathFull(), *PathSuffix);
+        // Upload the baked packages to S3 bucket here, if needed.
 
-        const EMatchBy MatchName = EMatchBy::NameOrTags;
-        const TArray<FName> TagsT;
-        for (const FString& FoundBake : Result)
+        // Clean up after every bake in one pass.
+        for (const TWeakObjectPtr<AActor>& BakedActor : BakedActorsToDestroy)
         {
-            auto AssetRelativePath = FPaths::Combine(GetBakePathRelative(), FoundBake);
-            auto AssetFullPath = FPaths::Combine(GetBakePathFull(), FoundBake);
-            auto AssetNameOnly = FoundBake;
-            AssetNameOnly.RemoveFromEnd(".uasset");
-            const TArray<AActor*> SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
-                MatchName, AssetNameOnly, TagsT, true);
-            TArray<FTransform> Transforms;
-            for (auto* Transform : SurfaceActors)
+            if (BakedActor.IsValid())
             {
-                Transforms.Add(Transform->GetActorTransform());
-
-                Transform->Destroy();
+                BakedActor->Destroy();
             }
-            Config->SpawnedObjects.Add(AssetRelativePath, Transforms);
-
-            // Upload folder to S3 bucket here, if needed.
+        }
 
-            FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*AssetFullPath);
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        for (const FString& PackageFile : BakedPackageFiles)
+        {
+            PlatformFile.DeleteFile(*PackageFile);
         }
 
         ClearObstacles();
@@ -21,6 +21,7 @@
 
 #include "AmbitSpawner.h"
 #include "Ambit/Actors/SpawnerConfigs/SpawnWithHoudiniConfig.h"
+#include "Ambit/Utils/AmbitCookScheduler.h"
 #include "Ambit/Utils/MatchBy.h"
 
 #include "SpawnWithHoudini.generated.h"
@@ -65,6 +66,13 @@ public:
      */
     UPROPERTY()
     TArray<UHoudiniPublicAPIAssetWrapper*> SpawnedActors;
+
+    /**
+     * The placements sent to this HDA's single instance as a point cloud when the spawner
+     * batches its placements (see ASpawnWithHoudini::bBatchAsPointCloud).
+     */
+    UPROPERTY()
+    TArray<FTransform> PointCloudTransforms;
 };
 
 /**
@@ -134,6 +142,34 @@ public:
         Category = "Ambit Spawner")
     TArray<FHoudiniLoadableAsset> HoudiniAssetDetails;
 
+    /**
+     * When enabled, each HDA is instantiated once and receives all of its placements as a
+     * point cloud input instead of being instantiated once per placement. The HDA is
+     * expected to copy its output onto the incoming points.
+     */
+    UPROPERTY(EditAnywhere, meta = (AdvancedDisplay), Category = "Ambit Spawner")
+    bool bBatchAsPointCloud = false;
+
+    /**
+     * The HDA input that receives the point cloud when bBatchAsPointCloud is enabled.
+     */
+    UPROPERTY(EditAnywhere, meta = (AdvancedDisplay, EditCondition = "bBatchAsPointCloud", ClampMin = 0),
+        Category = "Ambit Spawner")
+    int32 PointCloudInputIndex = 0;
+
+    /**
+     * When enabled, SDF exports reuse earlier bakes of the same HDA with the same parameters from the
+     * local bake cache instead of cooking and baking it again.
+     */
+    UPROPERTY(EditAnywhere, meta = (AdvancedDisplay), Category = "Ambit Spawner")
+    bool bUseBakeCache = true;
+
+    /**
+     * The number of HDA instances that may cook at the same time. The others wait for their turn.
+     */
+    UPROPERTY(EditAnywhere, meta = (AdvancedDisplay, ClampMin = 1), Category = "Ambit Spawner")
+    int32 MaxConcurrentCooks = 4;
+
     /**
      * For internal testing only. Returns when PreInstantiation has been completed on the HDAs
      * triggered by Houdini Plugin's response.
@@ -235,6 +271,28 @@ public:
     UFUNCTION(CallInEditor, Category = "Ambit Spawner Delegate Handler")
     void AssetPreInstantiation_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor);
 
+    /**
+     * This method sends the placements of a batched HDA to its point cloud input once Houdini
+     * has instantiated it, so that the first cook already copies onto every placement.
+     *
+     *@param SpawnedActor A reference to a Houdini Public API Asset Wrapper that has been
+     * properly instantiated and is at least in the PostInstantiation stage from Houdini's
+     * creation workflow.
+     */
+    UFUNCTION(CallInEditor, Category = "Ambit Spawner Delegate Handler")
+    void AssetPostInstantiation_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor);
+
+    /**
+     * This method indicates when a cook started by the cook scheduler has finished, so that the next
+     * queued HDA may start cooking.
+     *
+     *@param SpawnedActor A reference to a Houdini Public API Asset Wrapper that has just cooked.
+     *
+     *@param bCookSuccess Boolean to determine if the cook was successful.
+     */
+    UFUNCTION(CallInEditor, Category = "Ambit Spawner Delegate Handler")
+    void PostCook_DelegateHandler(UHoudiniPublicAPIAssetWrapper* SpawnedActor, bool bCookSuccess);
+
     /**
      * This method indicates when a particular HDA has finished processing, and is rendered to screen in the event
      * we need to do some post-handling for it.
@@ -299,6 +357,59 @@ private:
      */
     int ActorBakeCount;
 
+    /**
+     * Where a spawned HDA instance is kept in HoudiniAssetDetails.
+     */
+    struct FSpawnedAssetIndex
+    {
+        int32 ListNumber;
+        int32 IndexInList;
+    };
+
+    /**
+     * The spawned HDA instances and where they are kept, so that the delegate handlers do not search every list.
+     */
+    TMap<UHoudiniPublicAPIAssetWrapper*, FSpawnedAssetIndex> SpawnedAssetIndices;
+
+    /**
+     * Limits how many of the spawned HDA instances cook at the same time.
+     */
+    FAmbitCookScheduler CookScheduler;
+
+    /**
+     * What is needed to store a bake in the bake cache once it is done.
+     */
+    struct FPendingBake
+    {
+        FString Key;
+        FTransform InstanceTransform;
+    };
+
+    /**
+     * The instances being cooked and baked because the bake cache missed them.
+     */
+    TMap<UHoudiniPublicAPIAssetWrapper*, FPendingBake> PendingBakes;
+
+    /**
+     * The actors that each instance's bake has spawned so far.
+     */
+    TMap<UHoudiniPublicAPIAssetWrapper*, TArray<TWeakObjectPtr<AActor>>> BakeCaptures;
+
+    /**
+     * The placements of every package baked or restored from the bake cache, by asset path.
+     */
+    TMap<FName, TArray<FTransform>> BakedPlacements;
+
+    /**
+     * The actors left behind by the bakes, destroyed once the configuration is created.
+     */
+    TArray<TWeakObjectPtr<AActor>> BakedActorsToDestroy;
+
+    /**
+     * The package files written by the bakes, deleted once the configuration is created.
+     */
+    TSet<FString> BakedPackageFiles;
+
     /**
      * A cached instance of the actor count.
      */
@@ -329,12 +440,63 @@ private:
     };
 
     /**
-     * Handles the SDF export by finding all of the baked objects, packaging them for the SDF,
-     * deleting them from disk, and then finally exporting out that configuration to the delegate.
+     * Instantiates one HDA at the given transform and binds this spawner's delegate handlers to it.
+     *
+     *@return The wrapper of the new instance, or nullptr if Houdini could not instantiate it.
+     */
+    UHoudiniPublicAPIAssetWrapper* InstantiateHDA(UHoudiniAsset* HDA, const FTransform& Transform);
+
+    /**
+     * Adds SpawnedActor to the spawned instances of the HDA at ListNumber.
+     */
+    void AddSpawnedAsset(UHoudiniPublicAPIAssetWrapper* SpawnedActor, int32 ListNumber);
+
+    /**
+     * Returns where SpawnedActor is kept in HoudiniAssetDetails, or nullptr if this spawner did not spawn it.
+     */
+    const FSpawnedAssetIndex* FindSpawnedAsset(UHoudiniPublicAPIAssetWrapper* SpawnedActor) const
+    {
+        return SpawnedAssetIndices.Find(SpawnedActor);
+    }
+
+    /**
+     * Queues SpawnedActor to be cooked once the cook scheduler has room for it.
+     */
+    void ScheduleCook(UHoudiniPublicAPIAssetWrapper* SpawnedActor);
+
+    /**
+     * Restores the bake of SpawnedActor with Parameters from the bake cache when exporting to SDF.
+     * On a miss, the bake is stored once it is done.
+     *
+     *@return Whether the bake was restored, so that SpawnedActor does not need to be cooked.
+     */
+    bool RestoreFromBakeCache(UHoudiniPublicAPIAssetWrapper* SpawnedActor,
+                              const TMap<FName, FHoudiniParameterTuple>& Parameters, int32 ListNumber);
+
+    /**
+     * Records the placements of the actors that SpawnedActor's bake has spawned, and stores its packages
+     * in the bake cache if it missed it.
+     */
+    void RecordBake(UHoudiniPublicAPIAssetWrapper* SpawnedActor);
+
+    /**
+     * Records Placements of the package FileName in the bake folder, so that it is exported and then deleted.
+     * Packages restored from the bake cache are recorded the same way as freshly baked ones.
+     */
+    void RecordBakedFile(const FString& FileName, const TArray<FTransform>& Placements);
+
+    /**
+     * Counts one more instance as baked, and creates the configuration once all of them are.
+     */
+    void OnAssetBaked();
+
+    /**
+     * Handles the SDF export by packaging the recorded bakes for the SDF, deleting the baked
+     * objects and files, and then finally exporting out that configuration to the delegate.
      * Once completed, will send the delegate through the bound OnCompleted Delegate, and inform if the
      * process was successful or not.
      *
-     * This method assumes that all appropriate objects have been baked to disk and are currently loaded in the world. 
+     * This method assumes that every bake has been recorded by RecordBake() or restored from the bake cache.
      */
     void CreateSpawnedObjectConfiguration();
 };
@@ -1,4 +1,4 @@
-//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+﻿//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
 //  
 //   Licensed under the Apache License, Version 2.0 (the "License").
 //   You may not use this file except in compliance with the License.
@@ -15,11 +15,13 @@
 #include "SpawnWithHoudini.h"
 
 #include "HoudiniAsset.h"
+#include "Async/Async.h"
 #include "Engine/StaticMeshActor.h"
 #include "GameFramework/WorldSettings.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationEditorCommon.h"
 
+#include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
 #include "Ambit/Utils/AmbitWorldHelpers.h"
 
 
@@ -128,6 +130,16 @@ void SpawnWithHoudiniSpec::Define()
                              Spawner->HoudiniAssetDetails[0].SpawnedActors.Num(), 2);
                });
 
+            It("Should instantiate the HDA once for all placements when batching as a point cloud", [this]()
+            {
+                Spawner->bBatchAsPointCloud = true;
+                Spawner->GenerateObstacles();
+
+                TestEqual("The HDA is instantiated once.", Spawner->HoudiniAssetDetails[0].SpawnedActors.Num(), 1);
+                TestEqual("The point cloud holds every placement.",
+                          Spawner->HoudiniAssetDetails[0].PointCloudTransforms.Num(), 2);
+            });
+
             It(
                 "Should not return SpawnedActors when no configuration doesn't have surface actor name when MatchBy is NameOrTags",
                 [this]()
@@ -516,6 +528,72 @@ void SpawnWithHoudiniSpec::Define()
         });
     });
 
+    Describe("GenerateSpawnedObjectConfiguration()", [this]()
+    {
+        BeforeEach([this]()
+        {
+            Spawner->MatchBy = NameOrTags;
+            Spawner->SurfaceNamePattern = SurfaceActorName;
+            Spawner->SurfaceTags.Add(FName(Tag));
+            UHoudiniAsset* SampleCubeHDA = Cast<UHoudiniAsset>(StaticLoadObject(
+                UHoudiniAsset::StaticClass(), nullptr,
+                TEXT("HoudiniAsset'/Ambit/Test/Props/sample_cube.sample_cube'")));
+
+            Spawner->HoudiniAssetDetails[0].HDAToLoad = SampleCubeHDA;
+        });
+
+        LatentIt("Should export the same configuration whether the bake cache hits or misses",
+                 FTimespan::FromMinutes(5), [this](const FDoneDelegate& Done)
+                 {
+                     // Exports without the bake cache, then twice with it, so that the last export is sure to hit.
+                     const TSharedRef<TArray<FPlacementBuffer>> Exports = MakeShared<TArray<FPlacementBuffer>>();
+                     Spawner->bUseBakeCache = false;
+                     Spawner->GetOnSpawnedObjectConfigCompletedDelegate().BindLambda(
+                         [this, Done, Exports](TScriptInterface<IConfigJsonSerializer>& Config, bool bSuccess)
+                         {
+                             TestTrue("The export succeeded.", bSuccess);
+                             Exports->Add(Cast<USpawnedObjectConfig>(Config.GetObject())->SpawnedObjects);
+                             if (Exports->Num() < 3)
+                             {
+                                 // Exporting again from the delegate would reset the export being completed.
+                                 AsyncTask(ENamedThreads::GameThread, [this]()
+                                 {
+                                     Spawner->bUseBakeCache = true;
+                                     Spawner->GenerateSpawnedObjectConfiguration();
+                                 });
+                                 return;
+                             }
+
+                             const FPlacementBuffer& Missed = (*Exports)[0];
+                             const FPlacementBuffer& Hit = (*Exports)[2];
+                             TestTrue("Packages are exported.", Missed.Num() > 0);
+                             TestEqual("The same packages are exported.", Hit.NumClasses(), Missed.NumClasses());
+                             for (const TPair<FName, FPlacementBuffer::FPlacements>& Package : Missed.GetClasses())
+                             {
+                                 const FPlacementBuffer::FPlacements* Restored = Hit.Find(Package.Key);
+                                 if (TestNotNull(*FString::Printf(TEXT("%s is exported on a hit."),
+                                                                  *Package.Key.ToString()), Restored)
+                                     && TestEqual("Placements", Restored->Num(), Package.Value.Num()))
+                                 {
+                                     for (int32 i = 0; i < Package.Value.Num(); i++)
+                                     {
+                                         TestTrue("Placement", Restored->GetTransform(i).Equals(
+                                                      Package.Value.GetTransform(i), 0.1f));
+                                     }
+                                 }
+                             }
+                             Done.Execute();
+                         });
+                     Spawner->GenerateSpawnedObjectConfiguration();
+                 });
+
+        AfterEach([this]()
+        {
+            Spawner->GetOnSpawnedObjectConfigCompletedDelegate().Unbind();
+            Spawner->ResetObstacleSpawner();
+        });
+    });
+
     AfterEach([this]()
     {
         SurfaceActor->Destroy();
@@ -0,0 +1,138 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "SpawnedInstances.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace
+{
+    bool HaveSameResponses(const FCollisionResponseContainer& A, const FCollisionResponseContainer& B)
+    {
+        for (int32 Channel = 0; Channel < ECC_MAX; Channel++)
+        {
+            if (A.GetResponse(static_cast<ECollisionChannel>(Channel))
+                != B.GetResponse(static_cast<ECollisionChannel>(Channel)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+ASpawnedInstances::ASpawnedInstances()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    RootComponent = CreateDefaultSubobject<USceneComponent>("Root");
+}
+
+UHierarchicalInstancedStaticMeshComponent* ASpawnedInstances::AddInstance(const UStaticMeshComponent* Template,
+                                                                         const FCollisionResponseTemplate& Collision,
+                                                                         const FTransform& WorldTransform,
+                                                                         int32& OutIndex)
+{
+    UHierarchicalInstancedStaticMeshComponent* Component = FindOrAddComponent(Template, Collision);
+    OutIndex = Component->AddInstanceWorldSpace(WorldTransform);
+    return Component;
+}
+
+void ASpawnedInstances::RemoveLastInstance(UHierarchicalInstancedStaticMeshComponent* Component)
+{
+    // Removing the last instance does not move any other instance to a new index.
+    Component->RemoveInstance(Component->GetInstanceCount() - 1);
+}
+
+void ASpawnedInstances::BuildTrees()
+{
+    for (UHierarchicalInstancedStaticMeshComponent* Component : InstanceComponents)
+    {
+        Component->BuildTreeIfOutdated(true, false);
+    }
+}
+
+void ASpawnedInstances::ClearInstances()
+{
+    for (UHierarchicalInstancedStaticMeshComponent* Component : InstanceComponents)
+    {
+        Component->ClearInstances();
+    }
+}
+
+int32 ASpawnedInstances::GetInstanceCount() const
+{
+    int32 Count = 0;
+    for (const UHierarchicalInstancedStaticMeshComponent* Component : InstanceComponents)
+    {
+        Count += Component->GetInstanceCount();
+    }
+    return Count;
+}
+
+const TArray<UHierarchicalInstancedStaticMeshComponent*>& ASpawnedInstances::GetInstanceComponents() const
+{
+    return InstanceComponents;
+}
+
+UHierarchicalInstancedStaticMeshComponent* ASpawnedInstances::FindOrAddComponent(
+    const UStaticMeshComponent* Template, const FCollisionResponseTemplate& Collision)
+{
+    for (UHierarchicalInstancedStaticMeshComponent* Component : InstanceComponents)
+    {
+        if (Component->GetStaticMesh() != Template->GetStaticMesh()
+            || Component->GetCollisionEnabled() != Collision.CollisionEnabled
+            || Component->GetCollisionObjectType() != Collision.ObjectType
+            || !HaveSameResponses(Component->GetCollisionResponseToChannels(), Collision.ResponseToChannels)
+            || Component->GetNumMaterials() != Template->GetNumMaterials())
+        {
+            continue;
+        }
+
+        bool bSameMaterials = true;
+        for (int32 i = 0; i < Template->GetNumMaterials() && bSameMaterials; i++)
+        {
+            bSameMaterials = Component->GetMaterial(i) == Template->GetMaterial(i);
+        }
+        if (bSameMaterials)
+        {
+            return Component;
+        }
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+    Component->SetMobility(RootComponent->Mobility);
+    Component->SetStaticMesh(Template->GetStaticMesh());
+    for (int32 i = 0; i < Template->GetNumMaterials(); i++)
+    {
+        Component->SetMaterial(i, Template->GetMaterial(i));
+    }
+    Component->SetCastShadow(Template->CastShadow);
+
+    // Collides like a spawned actor, with one body per instance.
+    Component->SetCollisionObjectType(Collision.ObjectType);
+    Component->SetCollisionResponseToChannels(Collision.ResponseToChannels);
+    Component->SetCollisionEnabled(Collision.CollisionEnabled);
+    Component->SetGenerateOverlapEvents(Template->GetGenerateOverlapEvents());
+
+    // Spawners build the trees once all instances are added.
+    Component->bAutoRebuildTreeOnInstanceChanges = false;
+
+    Component->SetupAttachment(RootComponent);
+    Component->RegisterComponent();
+    AddInstanceComponent(Component);
+    InstanceComponents.Add(Component);
+    return Component;
+}
@@ -0,0 +1,85 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CollisionProfile.h"
+#include "GameFramework/Actor.h"
+
+#include "SpawnedInstances.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMeshComponent;
+
+/**
+ * Holds the obstacles that a spawner draws as instances instead of spawning actors.
+ * Instances are grouped into one hierarchical instanced static mesh component per mesh,
+ * materials and collision, and each instance has its own collision body.
+ */
+UCLASS(NotPlaceable)
+class AMBIT_API ASpawnedInstances : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ASpawnedInstances();
+
+    /**
+     * Adds an instance of the mesh and materials of Template at WorldTransform. The instance
+     * has the object type, responses and collision enabled state of Collision.
+     *
+     * @param OutIndex
+     *  the index of the new instance in the returned component
+     * @return
+     *  the component that holds the new instance
+     */
+    UHierarchicalInstancedStaticMeshComponent* AddInstance(const UStaticMeshComponent* Template,
+                                                           const FCollisionResponseTemplate& Collision,
+                                                           const FTransform& WorldTransform, int32& OutIndex);
+
+    /**
+     * Removes the instance that was added last to Component.
+     */
+    void RemoveLastInstance(UHierarchicalInstancedStaticMeshComponent* Component);
+
+    /**
+     * Sorts the instances added since the last call for culling and level of detail.
+     */
+    void BuildTrees();
+
+    /**
+     * Removes every instance.
+     */
+    void ClearInstances();
+
+    /**
+     * Returns the number of instances in all components.
+     */
+    int32 GetInstanceCount() const;
+
+    /**
+     * Returns the components that hold the instances.
+     */
+    const TArray<UHierarchicalInstancedStaticMeshComponent*>& GetInstanceComponents() const;
+
+private:
+    UPROPERTY()
+    TArray<UHierarchicalInstancedStaticMeshComponent*> InstanceComponents;
+
+    // Returns the component for the mesh and materials of Template and the given responses, adding it if needed.
+    UHierarchicalInstancedStaticMeshComponent* FindOrAddComponent(const UStaticMeshComponent* Template,
+                                                                  const FCollisionResponseTemplate& Collision);
+};
@@ -0,0 +1,317 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "SpawnedInstances.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#include "Ambit/AmbitModule.h"
+#include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
+#include "Ambit/Actors/Spawners/SpawnOnSurface.h"
+#include "Ambit/Utils/AmbitSpawnerCollisionHelpers.h"
+
+BEGIN_DEFINE_SPEC(SpawnedInstancesSpec, "Ambit.Unit.SpawnedInstances",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    ASpawnedInstances* Instances;
+    UStaticMeshComponent* CubeTemplate;
+    UStaticMeshComponent* SphereTemplate;
+    FCollisionResponseTemplate Collision;
+
+    UStaticMeshComponent* MakeTemplate(const TCHAR* MeshPath)
+    {
+        UStaticMeshComponent* Template = NewObject<UStaticMeshComponent>(GetTransientPackage());
+        Template->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, MeshPath));
+        return Template;
+    }
+
+    // Returns the objects that Spawner exports for Seed.
+    FPlacementBuffer Export(ASpawnOnSurface* Spawner, int32 Seed)
+    {
+        FPlacementBuffer Exported;
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().BindLambda(
+            [&Exported](TScriptInterface<IConfigJsonSerializer>& Config, bool bSuccess)
+            {
+                Exported = Cast<USpawnedObjectConfig>(Config.GetObject())->SpawnedObjects;
+            });
+        Spawner->GenerateSpawnedObjectConfiguration(Seed);
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().Unbind();
+        return Exported;
+    }
+END_DEFINE_SPEC(SpawnedInstancesSpec)
+
+void SpawnedInstancesSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        Instances = World->SpawnActor<ASpawnedInstances>();
+        CubeTemplate = MakeTemplate(TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        SphereTemplate = MakeTemplate(TEXT("StaticMesh'/Engine/BasicShapes/Sphere.Sphere'"));
+        Collision.ObjectType = ECC_GameTraceChannel1;
+        Collision.CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+        Collision.ResponseToChannels.SetAllChannels(ECR_Block);
+        Collision.ResponseToChannels.SetResponse(ECC_GameTraceChannel2, ECR_Overlap);
+    });
+
+    Describe("AddInstance()", [this]()
+    {
+        It("groups instances of the same mesh into one component", [this]()
+        {
+            int32 First;
+            int32 Second;
+            UHierarchicalInstancedStaticMeshComponent* FirstComponent = Instances->AddInstance(
+                CubeTemplate, Collision, FTransform(FVector(0, 0, 0)), First);
+            UHierarchicalInstancedStaticMeshComponent* SecondComponent = Instances->AddInstance(
+                CubeTemplate, Collision, FTransform(FVector(500, 0, 0)), Second);
+
+            TestEqual("Same component", SecondComponent, FirstComponent);
+            TestEqual("First index", First, 0);
+            TestEqual("Second index", Second, 1);
+            TestEqual("Instance count", Instances->GetInstanceCount(), 2);
+        });
+
+        It("uses a component per mesh and per collision", [this]()
+        {
+            int32 Index;
+            Instances->AddInstance(CubeTemplate, Collision, FTransform::Identity, Index);
+            Instances->AddInstance(SphereTemplate, Collision, FTransform::Identity, Index);
+            FCollisionResponseTemplate NoCollision = Collision;
+            NoCollision.CollisionEnabled = ECollisionEnabled::NoCollision;
+            Instances->AddInstance(CubeTemplate, NoCollision, FTransform::Identity, Index);
+
+            TestEqual("Component count", Instances->GetInstanceComponents().Num(), 3);
+        });
+
+        It("places the instance at the world transform", [this]()
+        {
+            int32 Index;
+            UHierarchicalInstancedStaticMeshComponent* Component = Instances->AddInstance(
+                CubeTemplate, Collision, FTransform(FRotator(0, 45, 0), FVector(100, 200, 300)), Index);
+
+            FTransform InstanceTransform;
+            Component->GetInstanceTransform(Index, InstanceTransform, true);
+            TestEqual("Location", InstanceTransform.GetLocation(), FVector(100, 200, 300));
+            TestTrue("Rotation", InstanceTransform.Rotator().Equals(FRotator(0, 45, 0), KINDA_SMALL_NUMBER));
+        });
+
+        It("gives each instance a collision body with the provided collision", [this]()
+        {
+            int32 Index;
+            UHierarchicalInstancedStaticMeshComponent* Component = Instances->AddInstance(
+                CubeTemplate, Collision, FTransform::Identity, Index);
+
+            TestEqual("Object type", Component->GetCollisionObjectType(), ECC_GameTraceChannel1);
+            TestEqual("Overlappable obstacles overlap",
+                      Component->GetCollisionResponseToChannel(ECC_GameTraceChannel2), ECR_Overlap);
+            TestTrue("Instance body", Component->InstanceBodies.IsValidIndex(Index)
+                     && Component->InstanceBodies[Index]->IsValidBodyInstance());
+        });
+    });
+
+    Describe("RemoveLastInstance()", [this]()
+    {
+        It("keeps the other instances at their index", [this]()
+        {
+            int32 Index;
+            UHierarchicalInstancedStaticMeshComponent* Component = Instances->AddInstance(
+                CubeTemplate, Collision, FTransform(FVector(100, 0, 0)), Index);
+            Instances->AddInstance(CubeTemplate, Collision, FTransform(FVector(200, 0, 0)), Index);
+
+            Instances->RemoveLastInstance(Component);
+
+            FTransform InstanceTransform;
+            Component->GetInstanceTransform(0, InstanceTransform, true);
+            TestEqual("Instance count", Instances->GetInstanceCount(), 1);
+            TestEqual("Remaining location", InstanceTransform.GetLocation(), FVector(100, 0, 0));
+        });
+    });
+
+    Describe("ClearInstances()", [this]()
+    {
+        It("removes every instance", [this]()
+        {
+            int32 Index;
+            Instances->AddInstance(CubeTemplate, Collision, FTransform::Identity, Index);
+            Instances->AddInstance(SphereTemplate, Collision, FTransform::Identity, Index);
+
+            Instances->ClearInstances();
+
+            TestEqual("Instance count", Instances->GetInstanceCount(), 0);
+        });
+    });
+
+    Describe("a spawner in instanced static meshes mode", [this]()
+    {
+        It("exports the same objects as in actors mode", [this]()
+        {
+            UClass* PropClass = FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C").TryLoadClass<AActor>();
+            TArray<FInstanceableMesh> Meshes;
+            FVector RootScale;
+            TestTrue("The prop is made of static meshes only",
+                     AmbitSpawnerCollisionHelpers::GetInstanceableMeshes(PropClass, Meshes, RootScale));
+
+            FActorSpawnParameters SurfaceParams;
+            SurfaceParams.Name = FName("InstanceSurface");
+            AStaticMeshActor* Surface = World->SpawnActor<AStaticMeshActor>(
+                AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector::ZeroVector,
+                                                            FVector(20, 20, 1)), SurfaceParams);
+            Surface->GetStaticMeshComponent()->SetStaticMesh(
+                LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'")));
+
+            ASpawnOnSurface* Spawner = World->SpawnActor<ASpawnOnSurface>();
+            Spawner->SurfaceNamePattern = "InstanceSurface";
+            Spawner->ActorsToSpawn.Add(PropClass);
+            Spawner->DensityMin = 0.2f;
+            Spawner->DensityMax = 0.2f;
+            Spawner->SpawnBudgetMilliseconds = 0.f;
+            Spawner->bExportWithoutSpawning = false;
+
+            for (int32 Seed = 0; Seed < 5; Seed++)
+            {
+                Spawner->OutputMode = ESpawnerOutputMode::ActorPerPlacement;
+                const FPlacementBuffer FromActors = Export(Spawner, Seed);
+                Spawner->OutputMode = ESpawnerOutputMode::InstancedStaticMeshes;
+                const FPlacementBuffer FromInstances = Export(Spawner, Seed);
+
+                const FPlacementBuffer::FPlacements* ActorPlacements = FromActors.Find(*PropClass->GetPathName());
+                const FPlacementBuffer::FPlacements* InstancePlacements = FromInstances.Find(*PropClass->GetPathName());
+                TestTrue("Both modes export the prop", ActorPlacements != nullptr && InstancePlacements != nullptr);
+                if (ActorPlacements == nullptr || InstancePlacements == nullptr)
+                {
+                    continue;
+                }
+                const TArray<FTransform> ActorTransforms = ActorPlacements->GetTransforms();
+                const TArray<FTransform> InstanceTransforms = InstancePlacements->GetTransforms();
+                TestEqual(FString::Printf(TEXT("Seed %i exports the same number of objects."), Seed),
+                          InstanceTransforms.Num(), ActorTransforms.Num());
+                for (int32 i = 0; i < InstanceTransforms.Num() && i < ActorTransforms.Num(); i++)
+                {
+                    TestTrue(FString::Printf(TEXT("Seed %i exports object %i at the same transform."), Seed, i),
+                             InstanceTransforms[i].Equals(ActorTransforms[i], 0.01f));
+                }
+            }
+
+            Spawner->Destroy();
+            Surface->Destroy();
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Instances->Destroy();
+    });
+}
+
+BEGIN_DEFINE_SPEC(SpawnedInstancesBenchmarkSpec, "Ambit.Perf.SpawnedInstances",
+                  EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    ASpawnedInstances* Instances;
+    UStaticMeshComponent* CubeTemplate;
+    FCollisionResponseTemplate Collision;
+
+    // Returns the time of a world tick, in milliseconds.
+    double MeasureTick() const
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        World->Tick(LEVELTICK_All, 1.f / 60.f);
+        return (FPlatformTime::Seconds() - StartTime) * 1000;
+    }
+END_DEFINE_SPEC(SpawnedInstancesBenchmarkSpec)
+
+void SpawnedInstancesBenchmarkSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        Instances = World->SpawnActor<ASpawnedInstances>();
+        UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        CubeTemplate = NewObject<UStaticMeshComponent>(GetTransientPackage());
+        CubeTemplate->SetStaticMesh(Cube);
+        Collision.ObjectType = ECC_GameTraceChannel1;
+        Collision.CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+        Collision.ResponseToChannels.SetAllChannels(ECR_Block);
+    });
+
+    It("reports the frame time and memory of 10k and 100k instances", [this]()
+    {
+        const float Spacing = 200.f;
+        for (const int32 Count : {10000, 100000})
+        {
+            const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+            const double EmptyTick = MeasureTick();
+            const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+            double StartTime = FPlatformTime::Seconds();
+            for (int32 i = 0; i < Count; i++)
+            {
+                int32 Index;
+                Instances->AddInstance(CubeTemplate, Collision,
+                                       FTransform(FVector(i % Columns * Spacing, i / Columns * Spacing, 0)),
+                                       Index);
+            }
+            Instances->BuildTrees();
+            const double InstanceSeconds = FPlatformTime::Seconds() - StartTime;
+            const double InstanceTick = MeasureTick();
+            const int64 InstanceMemory = FPlatformMemory::GetStats().UsedPhysical - MemoryBefore;
+            TestEqual("Instance count", Instances->GetInstanceCount(), Count);
+            Instances->ClearInstances();
+
+            // The instances are gone, so the actors are measured from where memory is now.
+            const uint64 ActorMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+            StartTime = FPlatformTime::Seconds();
+            TArray<AStaticMeshActor*> Actors;
+            for (int32 i = 0; i < Count; i++)
+            {
+                AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(
+                    AStaticMeshActor::StaticClass(),
+                    FTransform(FVector(i % Columns * Spacing, i / Columns * Spacing, 0)));
+                Actor->GetStaticMeshComponent()->SetStaticMesh(CubeTemplate->GetStaticMesh());
+                Actors.Add(Actor);
+            }
+            const double ActorSeconds = FPlatformTime::Seconds() - StartTime;
+            const double ActorTick = MeasureTick();
+            const int64 ActorMemory = FPlatformMemory::GetStats().UsedPhysical - ActorMemoryBefore;
+            for (AStaticMeshActor* Actor : Actors)
+            {
+                Actor->Destroy();
+            }
+
+            UE_LOG(LogAmbit, Display,
+                   TEXT("%i obstacles: instances %.1f ms to add, %.2f ms tick, %lld KB; "
+                       "actors %.1f ms to spawn, %.2f ms tick, %lld KB; empty tick %.2f ms."),
+                   Count, InstanceSeconds * 1000, InstanceTick, InstanceMemory / 1024, ActorSeconds * 1000,
+                   ActorTick, ActorMemory / 1024, EmptyTick);
+        }
+    });
+
+    AfterEach([this]()
+    {
+        Instances->Destroy();
+    });
+}
@@ -15,19 +15,138 @@
 #include "SpawnerBase.h"
 
 #include "EngineUtils.h"
+#include "TimerManager.h"
+#include "Containers/Ticker.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Components/BillboardComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
+#include "Ambit/Actors/Spawners/SpawnedInstances.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitActorPoolSubsystem.h"
+#include "Ambit/Utils/AmbitCollisionTemplateSubsystem.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
+#include "Ambit/Utils/AmbitPlacementBroadphase.h"
+#include "Ambit/Utils/AmbitPlacementScene.h"
 #include "Ambit/Utils/AmbitSpawnerCollisionHelpers.h"
+#include "Ambit/Utils/AmbitWorldHelpers.h"
 #include "Ambit/Utils/UserMetricsSubsystem.h"
 #include "AmbitUtils/JsonHelpers.h"
 
 #include <AmbitUtils/MenuHelpers.h>
 
+namespace
+{
+    // How long edits must pause before actors are regenerated, so that dragging a slider
+    // does not regenerate them on every step.
+    constexpr float KRegenerationDelaySeconds = 0.3f;
+
+    // How many placements are tested against the world at once before they are spawned.
+    constexpr int32 KWorldTestBatchSize = 64;
+
+    // Returns the index of the class to place at each of NumTransforms placements.
+    // Keyed by the placement, so the choice does not depend on which placements were rejected.
+    TArray<int32> ChooseClassIndices(const FAmbitCounterRandom& Random, int32 NumTransforms, int32 NumClasses)
+    {
+        TArray<int32> ClassIndices;
+        ClassIndices.SetNumZeroed(NumTransforms);
+        if (NumClasses > 1)
+        {
+            for (int32 TransformIndex = 0; TransformIndex < NumTransforms; TransformIndex++)
+            {
+                ClassIndices[TransformIndex] = Random.RandRange(TransformIndex, EAmbitRandomChannel::ActorClass, 0,
+                                                                NumClasses - 1);
+            }
+        }
+        return ClassIndices;
+    }
+
+    // Each class can place at most the placements it was chosen for, so the placements never grow.
+    void ReservePlacements(const TArray<int32>& ClassIndices, const TArray<FName>& PathNames,
+                           FPlacementBuffer& OutPlacements)
+    {
+        TArray<int32> ChosenCounts;
+        ChosenCounts.SetNumZeroed(PathNames.Num());
+        for (const int32 ClassIndex : ClassIndices)
+        {
+            ChosenCounts[ClassIndex]++;
+        }
+        for (int32 i = 0; i < PathNames.Num(); i++)
+        {
+            if (ChosenCounts[i] > 0)
+            {
+                OutPlacements.Reserve(PathNames[i], ChosenCounts[i]);
+            }
+        }
+    }
+}
+
+/**
+ * The state of spawning actors at a set of placements, kept between frames
+ * so that spawning can be spread over several of them.
+ */
+struct FAmbitSpawnJob
+{
+    FAmbitSpawnJob(const TArray<FTransform>& InTransforms, const FAmbitCounterRandom& InRandom,
+                   TFunction<void(FPlacementBuffer&)> InOnCompleted)
+        : Transforms(InTransforms)
+        , Random(InRandom)
+        , OnCompleted(MoveTemp(InOnCompleted))
+    {
+    }
+
+    TWeakObjectPtr<ASpawnerBase> Spawner;
+    TArray<FTransform> Transforms;
+    // Captured when the job is created, so that a temporary seed used for an export still applies.
+    FAmbitCounterRandom Random;
+    TFunction<void(FPlacementBuffer&)> OnCompleted;
+
+    bool bStarted = false;
+    int32 NextIndex = 0;
+
+    TArray<TSubclassOf<AActor>> ActorsToSpawnClean;
+    // For each of ActorsToSpawnClean, the path name its placements are exported with.
+    TArray<FName> PathNames;
+    // For each of ActorsToSpawnClean, the collision its obstacles are placed and spawned with.
+    TArray<FSpawnedObstacleCollisionRef> Collisions;
+
+    bool bUseFootprints = false;
+    TArray<FBox> Footprints;
+    FAmbitPlacementBroadphase Broadphase;
+    TArray<int32> ClassIndices;
+    TArray<int32> KeptActorIndices;
+    TArray<TWeakObjectPtr<UStaticMeshComponent>> ComponentsToSimulate;
+    // For each of ActorsToSpawnClean, its meshes if it is drawn as instances.
+    TArray<TArray<FInstanceableMesh>> InstanceableMeshes;
+    TArray<FVector> InstanceRootScales;
+
+    // Whether each placement is blocked by the world, and how far it was moved to get out of the obstacles
+    // that blocked it, for placements before WorldTestedCount.
+    bool bTestWorldBeforeSpawn = false;
+    TArray<bool> BlockedByWorld;
+    TArray<FVector> Adjustments;
+    int32 WorldTestedCount = 0;
+    // Tested against instead of the world if bUsePlacementScene is set.
+    TUniquePtr<FAmbitPlacementScene> PlacementScene;
+
+    int32 RejectedBeforeSpawn = 0;
+    int32 ReusableCount = 0;
+    int32 KeptActors = 0;
+    FPlacementBuffer SpawnedObjects;
+};
+
+namespace
+{
+    // Spawning that is spread over frames, in the order it was requested. Only the first job
+    // is started at a time, so that each job finds the obstacles of the jobs before it.
+    TArray<TSharedPtr<FAmbitSpawnJob>> SpawnQueue;
+    FDelegateHandle SpawnQueueTicker;
+}
+
 // Sets default values
 ASpawnerBase::ASpawnerBase()
 {
@@ -41,18 +160,63 @@ void ASpawnerBase::GenerateSpawnedObjectConfiguration()
 
 void ASpawnerBase::GenerateSpawnedObjectConfiguration(int32 Seed)
 {
-    USpawnedObjectConfig* Config = NewObject<USpawnedObjectConfig>();
-
     const int32 OriginalSeed = RandomSeed;
     RandomSeed = Seed;
 
-    Config->SpawnedObjects = GenerateActors();
+    // Physics stacking needs actors, so only spawners without it can export without touching the world.
+    if (bExportWithoutSpawning && !bAddPhysics)
+    {
+        USpawnedObjectConfig* Config = NewObject<USpawnedObjectConfig>();
+        if (AreParametersValid())
+        {
+            const TArray<AActor*>& SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
+                MatchBy, SurfaceNamePattern, SurfaceTags);
+            PlaceWithoutSpawning(GenerateTransforms(SurfaceActors), Config->SpawnedObjects);
+        }
+        else
+        {
+            UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel());
+        }
+        RandomSeed = OriginalSeed;
+
+        auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
+        OnSpawnedObjectConfigCompleted.ExecuteIfBound(FinalConfig, true);
+        return;
+    }
 
-    DestroyGeneratedActors();
+    TArray<FTransform> Transforms;
+    const bool bHasTransforms = PrepareToGenerate(Transforms);
+
+    // Spawning below captures the seed, so it can be restored before spawning ends.
+    const TWeakObjectPtr<ASpawnerBase> WeakThis(this);
+    const auto EmitConfig = [WeakThis](FPlacementBuffer& SpawnedObjects)
+    {
+        ASpawnerBase* Spawner = WeakThis.Get();
+        if (Spawner == nullptr)
+        {
+            return;
+        }
+
+        USpawnedObjectConfig* Config = NewObject<USpawnedObjectConfig>();
+        Config->SpawnedObjects = MoveTemp(SpawnedObjects);
+
+        Spawner->DestroyGeneratedActors();
+
+        auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
+        Spawner->OnSpawnedObjectConfigCompleted.ExecuteIfBound(FinalConfig, true);
+    };
+
+    if (bHasTransforms)
+    {
+        SpawnActorsOverFrames(Transforms, EmitConfig);
+    }
     RandomSeed = OriginalSeed;
 
-    auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
-    OnSpawnedObjectConfigCompleted.ExecuteIfBound(FinalConfig, true);
+    if (!bHasTransforms)
+    {
+        FPlacementBuffer NoObjects;
+        EmitConfig(NoObjects);
+    }
 }
 
 template <typename Struct>
@@ -101,14 +265,40 @@ void ASpawnerBase::Configure(const TSharedPtr<Struct>& Config)
 void ASpawnerBase::BeginPlay()
 {
     Super::BeginPlay();
-    GenerateActors();
 
-    const TSharedRef<FJsonObject> MetricContextData = MakeShareable(new FJsonObject);
-    MetricContextData->SetNumberField(UserMetrics::AmbitSpawner::KAmbitSpawnerSpawnNumberContextData,
-                                      SpawnedActors.Num());
-    GEngine->GetEngineSubsystem<UUserMetricsSubsystem>()->Track(UserMetrics::AmbitSpawner::KAmbitSpawnerRunEvent,
-                                                                UserMetrics::AmbitSpawner::KAmbitSpawnerNameSpace,
-                                                                MetricContextData);
+    const TWeakObjectPtr<ASpawnerBase> WeakThis(this);
+    GenerateActorsOverFrames([WeakThis](FPlacementBuffer& SpawnedObjects)
+    {
+        if (!WeakThis.IsValid())
+        {
+            return;
+        }
+
+        const TSharedRef<FJsonObject> MetricContextData = MakeShareable(new FJsonObject);
+        MetricContextData->SetNumberField(UserMetrics::AmbitSpawner::KAmbitSpawnerSpawnNumberContextData,
+                                          WeakThis->SpawnedActors.Num() + WeakThis->GetSpawnedInstanceCount());
+        GEngine->GetEngineSubsystem<UUserMetricsSubsystem>()->Track(UserMetrics::AmbitSpawner::KAmbitSpawnerRunEvent,
+                                                                    UserMetrics::AmbitSpawner::KAmbitSpawnerNameSpace,
+                                                                    MetricContextData);
+    });
+}
+
+void ASpawnerBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelSpawnJob();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASpawnerBase::Destroyed()
+{
+    CancelSpawnJob();
+    if (IsValid(SpawnedInstances))
+    {
+        SpawnedInstances->Destroy();
+    }
+
+    Super::Destroyed();
 }
 
 void ASpawnerBase::PostActorCreated()
@@ -122,6 +312,192 @@ void ASpawnerBase::PostActorCreated()
 }
 
 
+FPlacementBuffer ASpawnerBase::GenerateActors()
+{
+    FPlacementBuffer SpawnedObjects;
+    TArray<FTransform> Transforms;
+    if (PrepareToGenerate(Transforms))
+    {
+        SpawnActorsAtTransforms(Transforms, SpawnedObjects);
+    }
+    return SpawnedObjects;
+}
+
+void ASpawnerBase::GenerateActorsOverFrames(TFunction<void(FPlacementBuffer&)> OnCompleted)
+{
+    TArray<FTransform> Transforms;
+    if (PrepareToGenerate(Transforms))
+    {
+        SpawnActorsOverFrames(Transforms, MoveTemp(OnCompleted));
+    }
+    else
+    {
+        FPlacementBuffer NoObjects;
+        OnCompleted(NoObjects);
+    }
+}
+
+TArray<FTransform> ASpawnerBase::GenerateTransforms(const TArray<AActor*>& SurfaceActors) const
+{
+    const FSpawnerTransformGenerator Generator = MakeTransformGenerator(SurfaceActors);
+    return Generator.Snap(Generator.Draw(), SurfaceActors);
+}
+
+void ASpawnerBase::PlaceWithoutSpawning(const TArray<FTransform>& Transforms, FPlacementBuffer& OutPlacements) const
+{
+    OutPlacements.Empty();
+    TArray<TSubclassOf<AActor>> ActorsToSpawnClean;
+    CleanActorsToSpawn(ActorsToSpawnClean);
+    if (Transforms.Num() == 0 || ActorsToSpawnClean.Num() == 0)
+    {
+        return;
+    }
+
+    // The class defaults stand in for the actors that spawning would create.
+    TArray<FName> PathNames;
+    TArray<FBox> Footprints;
+    TArray<FVector> RootScales;
+    float LargestFootprint = 0.f;
+    for (const TSubclassOf<AActor>& Actor : ActorsToSpawnClean)
+    {
+        PathNames.Add(*Actor.Get()->GetPathName());
+        RootScales.Add(AmbitSpawnerCollisionHelpers::GetDefaultRootScale(Actor.Get()));
+        const FBox& Footprint = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(Actor.Get());
+        Footprints.Add(Footprint);
+        if (Footprint.IsValid)
+        {
+            LargestFootprint = FMath::Max3(LargestFootprint, Footprint.GetSize().X, Footprint.GetSize().Y);
+        }
+    }
+    FAmbitPlacementBroadphase Broadphase(LargestFootprint > 0.f ? LargestFootprint : 100.f);
+
+    UAmbitCollisionTemplateSubsystem* Templates = GEngine->GetEngineSubsystem<UAmbitCollisionTemplateSubsystem>();
+    TArray<FSpawnedObstacleCollisionRef> Collisions;
+    TArray<const FSpawnedObstacleCollision*> SceneCollisions;
+    for (const TSubclassOf<AActor>& Actor : ActorsToSpawnClean)
+    {
+        SceneCollisions.Add(&Collisions.Add_GetRef(Templates->FindOrAdd(Actor.Get(), bRemoveOverlaps)).Get());
+    }
+
+    // The obstacles this spawner has placed before are replaced by the exported ones, so they are left out.
+    TArray<const AActor*> IgnoredActors;
+    for (const AActor* Actor : SpawnedActors)
+    {
+        if (IsValid(Actor))
+        {
+            IgnoredActors.Add(Actor);
+        }
+    }
+    if (IsValid(SpawnedInstances))
+    {
+        IgnoredActors.Add(SpawnedInstances);
+    }
+
+    // Classes are chosen as BeginSpawnJob chooses them, so that both find the same placements.
+    const FAmbitCounterRandom Random(RandomSeed, FAmbitCounterRandom::GetSpawnerId(this));
+    const TArray<int32> ClassIndices = ChooseClassIndices(Random, Transforms.Num(), ActorsToSpawnClean.Num());
+
+    // Placements are tested against the rest of the world as spawning tests them. Without a scene,
+    // nothing is added to the world, so every placement is tested against it at once up front.
+    // Blocked placements are moved out of the obstacles in the world as spawning moves them.
+    TUniquePtr<FAmbitPlacementScene> Scene;
+    TArray<bool> BlockedByWorld;
+    TArray<FVector> Adjustments;
+    if (bUsePlacementScene)
+    {
+        Scene = MakePlacementScene(Transforms, SceneCollisions, IgnoredActors);
+    }
+    else
+    {
+        const UWorld* World = GetWorld();
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitPlacementWithoutSpawning));
+        Params.AddIgnoredActors(IgnoredActors);
+        BlockedByWorld.SetNumZeroed(Transforms.Num());
+        Adjustments.SetNumZeroed(Transforms.Num());
+        ParallelFor(Transforms.Num(), [&](int32 TransformIndex)
+        {
+            const FSpawnedObstacleCollision& Collision = *Collisions[ClassIndices[TransformIndex]];
+            FTransform Placement(Transforms[TransformIndex].GetRotation(), Transforms[TransformIndex].GetLocation());
+            bool bIsBlocked = AmbitSpawnerCollisionHelpers::IsPlacementBlocked(World, Collision, Placement, Params);
+            if (bIsBlocked && bAdjustOverlappingPlacements)
+            {
+                bIsBlocked = !AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(World, Collision, Placement, Params);
+                Adjustments[TransformIndex] = Placement.GetLocation() - Transforms[TransformIndex].GetLocation();
+            }
+            BlockedByWorld[TransformIndex] = bIsBlocked;
+        });
+    }
+
+    ReservePlacements(ClassIndices, PathNames, OutPlacements);
+    for (int32 TransformIndex = 0; TransformIndex < Transforms.Num(); TransformIndex++)
+    {
+        const int32 ClassIndex = ClassIndices[TransformIndex];
+        const FSpawnedObstacleCollision& Collision = *Collisions[ClassIndex];
+        FTransform Placement(Transforms[TransformIndex].GetRotation(), Transforms[TransformIndex].GetLocation());
+        const FBox& Footprint = Footprints[ClassIndex];
+        if (bRemoveOverlaps && Footprint.IsValid && Broadphase.Overlaps(Footprint, Placement))
+        {
+            continue;
+        }
+        bool bIsBlocked;
+        if (Scene.IsValid())
+        {
+            bIsBlocked = AmbitSpawnerCollisionHelpers::IsPlacementBlocked(*Scene, Collision, Placement);
+            if (bIsBlocked && bAdjustOverlappingPlacements)
+            {
+                bIsBlocked = !AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(*Scene, Collision, Placement);
+            }
+        }
+        else
+        {
+            bIsBlocked = BlockedByWorld[TransformIndex];
+            Placement.AddToTranslation(Adjustments[TransformIndex]);
+        }
+        if (bIsBlocked)
+        {
+            continue;
+        }
+        // As in SpawnAtPlacement(), a moved placement must not overlap one placed before it.
+        const bool bMoved = Placement.GetLocation() != Transforms[TransformIndex].GetLocation();
+        if (bMoved && bRemoveOverlaps && Footprint.IsValid && Broadphase.Overlaps(Footprint, Placement))
+        {
+            continue;
+        }
+        if (bRemoveOverlaps && Footprint.IsValid)
+        {
+            Broadphase.Add(Footprint, Placement);
+        }
+        if (bRemoveOverlaps && Scene.IsValid())
+        {
+            Scene->AddObstacle(Collision, Placement);
+        }
+        OutPlacements.Add(PathNames[ClassIndex], FTransform(Placement.GetRotation(), Placement.GetLocation(),
+                                                            RootScales[ClassIndex]));
+    }
+}
+
+bool ASpawnerBase::PrepareToGenerate(TArray<FTransform>& OutTransforms)
+{
+    OutTransforms.Empty();
+    CompleteSpawnJob();
+    if (!AreParametersValid())
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel());
+        return false;
+    }
+
+    UE_LOG(LogAmbit, Display, TEXT("%s: Generating actors."), *this->GetActorLabel());
+
+    // Remove any previously spawned actors.
+    DestroyGeneratedActors();
+
+    const TArray<AActor*>& SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
+        MatchBy, SurfaceNamePattern, SurfaceTags);
+
+    OutTransforms = GenerateTransforms(SurfaceActors);
+    return OutTransforms.Num() > 0;
+}
+
 void ASpawnerBase::DestroyGeneratedActors()
 {
     // Remove previously created actors.
@@ -132,11 +508,43 @@ void ASpawnerBase::DestroyGeneratedActors()
         // accommodate cases where the actor no longer exists.
         if (IsValid(Actor))
         {
-            Actor->Destroy();
+            ReleaseActor(Actor);
         }
     }
 
     SpawnedActors.Empty();
+    SpawnedPlacements.Empty();
+
+    if (IsValid(SpawnedInstances))
+    {
+        SpawnedInstances->ClearInstances();
+    }
+}
+
+AActor* ASpawnerBase::AcquireActor(UClass* Class, const FVector& Location, const FRotator& Rotation,
+                                  const FSpawnedObstacleCollision& Collision)
+{
+    if (bPoolActors)
+    {
+        if (UAmbitActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UAmbitActorPoolSubsystem>())
+        {
+            return ActorPool->Acquire(Class, Location, Rotation, &Collision);
+        }
+    }
+    return AmbitSpawnerCollisionHelpers::SpawnObstacle(GetWorld(), Class, FTransform(Rotation, Location), Collision);
+}
+
+void ASpawnerBase::ReleaseActor(AActor* Actor)
+{
+    if (bPoolActors)
+    {
+        if (UAmbitActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UAmbitActorPoolSubsystem>())
+        {
+            ActorPool->Release(Actor);
+            return;
+        }
+    }
+    Actor->Destroy();
 }
 
 bool ASpawnerBase::HasActorsToSpawn() const
@@ -151,6 +559,121 @@ void ASpawnerBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
     PostEditErrorFixes();
 }
 
+void ASpawnerBase::ScheduleRegeneration(const FPropertyChangedEvent& PropertyChangedEvent)
+{
+    // These change how every spawned actor is set up.
+    const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(ASpawnerBase, bAddPhysics)
+        || PropertyName == GET_MEMBER_NAME_CHECKED(ASpawnerBase, bRemoveOverlaps))
+    {
+        bFullRegenerationPending = true;
+    }
+
+    // Setting the timer again restarts it.
+    GetWorldTimerManager().SetTimer(RegenerationTimer, this, &ASpawnerBase::StartRegeneration,
+                                    KRegenerationDelaySeconds);
+}
+
+void ASpawnerBase::StartRegeneration()
+{
+    if (!AreParametersValid())
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("%s: Parameters are invalid."), *this->GetActorLabel());
+        return;
+    }
+
+    UE_LOG(LogAmbit, Display, TEXT("%s: Regenerating actors."), *this->GetActorLabel());
+
+    // Matching surfaces uses the actor index, and the generator copies this spawner's parameters
+    // and what it needs from the surfaces, so all of it happens here on the game thread.
+    const TArray<AActor*> SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
+        MatchBy, SurfaceNamePattern, SurfaceTags);
+    FSpawnerTransformGenerator Generator = MakeTransformGenerator(SurfaceActors);
+    TArray<TWeakObjectPtr<AActor>> WeakSurfaceActors;
+    for (AActor* SurfaceActor : SurfaceActors)
+    {
+        WeakSurfaceActors.Add(SurfaceActor);
+    }
+    const int32 Request = ++RegenerationRequest;
+    const TWeakObjectPtr<ASpawnerBase> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Generator = MoveTemp(Generator), WeakSurfaceActors, Request]()
+    {
+        // Only the data the generator copied is read here.
+        AmbitWorldHelpers::FPlacementCandidates Candidates = Generator.Draw();
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Request, Snap = Generator.Snap, WeakSurfaceActors,
+                      Candidates = MoveTemp(Candidates)]()
+        {
+            ASpawnerBase* Spawner = WeakThis.Get();
+            // A later edit has already started another regeneration.
+            if (Spawner == nullptr || Spawner->RegenerationRequest != Request)
+            {
+                return;
+            }
+
+            TArray<AActor*> SurfaceActors;
+            for (const TWeakObjectPtr<AActor>& SurfaceActor : WeakSurfaceActors)
+            {
+                if (!SurfaceActor.IsValid())
+                {
+                    // The candidates were drawn for a surface that is gone, so they are drawn again.
+                    Spawner->StartRegeneration();
+                    return;
+                }
+                SurfaceActors.Add(SurfaceActor.Get());
+            }
+            Spawner->FinishRegeneration(Snap(Candidates, SurfaceActors));
+        });
+    });
+}
+
+void ASpawnerBase::FinishRegeneration(const TArray<FTransform>& Transforms)
+{
+    CompleteSpawnJob();
+    if (bFullRegenerationPending || Transforms.Num() == 0)
+    {
+        bFullRegenerationPending = false;
+        DestroyGeneratedActors();
+    }
+    if (Transforms.Num() == 0)
+    {
+        return;
+    }
+
+    ReusableActors = MoveTemp(SpawnedActors);
+    ReusablePlacements = MoveTemp(SpawnedPlacements);
+    SpawnedActors.Reset();
+    SpawnedPlacements.Reset();
+
+    SpawnActorsOverFrames(Transforms, [](FPlacementBuffer&)
+    {
+    });
+}
+
+float ASpawnerBase::GetMinimumSpacing() const
+{
+    float LargestRadius = 0.f;
+    for (const TSubclassOf<AActor>& Actor : ActorsToSpawn)
+    {
+        if (!IsValid(Actor))
+        {
+            continue;
+        }
+
+        const FBox& Footprint = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(Actor.Get());
+        if (!Footprint.IsValid)
+        {
+            continue;
+        }
+
+        // The farthest corner from the pivot bounds the footprint under any yaw.
+        const float CornerX = FMath::Max(FMath::Abs(Footprint.Min.X), FMath::Abs(Footprint.Max.X));
+        const float CornerY = FMath::Max(FMath::Abs(Footprint.Min.Y), FMath::Abs(Footprint.Max.Y));
+        LargestRadius = FMath::Max(LargestRadius, FVector2D(CornerX, CornerY).Size());
+    }
+    return LargestRadius * 2.f;
+}
+
 bool ASpawnerBase::AreParametersValid() const
 {
     if (ActorsToSpawn.Num() > 0)
@@ -218,10 +741,8 @@ void ASpawnerBase::PostEditErrorFixes()
     }
 }
 
-void ASpawnerBase::CleanAndSetUpActorsToSpawn(TArray<TSubclassOf<AActor>>& OutArray,
-                                              TMap<FString, TArray<FCollisionResponseTemplate>>& OutMap)
+void ASpawnerBase::CleanActorsToSpawn(TArray<TSubclassOf<AActor>>& OutArray) const
 {
-    OutMap.Empty();
     OutArray.Empty();
     for (const TSubclassOf<AActor>& Actor : ActorsToSpawn)
     {
@@ -236,176 +757,576 @@ void ASpawnerBase::CleanAndSetUpActorsToSpawn(TArray<TSubclassOf<AActor>>& OutAr
             UE_LOG(LogAmbit, Warning, TEXT("%s: Duplicate of %s found in ActorsToSpawn. Ignoring..."),
                    *this->GetActorLabel(), *Actor->GetName());
         }
-        else
+    }
+}
+
+void ASpawnerBase::SpawnActorsAtTransforms(const TArray<FTransform>& Transforms, FPlacementBuffer& OutPlacements)
+{
+    OutPlacements.Empty();
+    CompleteSpawnJob();
+
+    FAmbitSpawnJob Job(Transforms, FAmbitCounterRandom(RandomSeed, FAmbitCounterRandom::GetSpawnerId(this)),
+                       [&OutPlacements](FPlacementBuffer& SpawnedObjects)
+                       {
+                           OutPlacements = MoveTemp(SpawnedObjects);
+                       });
+    BeginSpawnJob(Job);
+    ContinueSpawnJob(Job, TNumericLimits<double>::Max());
+    EndSpawnJob(Job);
+}
+
+void ASpawnerBase::SpawnActorsOverFrames(const TArray<FTransform>& Transforms,
+                                         TFunction<void(FPlacementBuffer&)> OnCompleted)
+{
+    if (SpawnBudgetMilliseconds <= 0.f)
+    {
+        FPlacementBuffer SpawnedObjects;
+        SpawnActorsAtTransforms(Transforms, SpawnedObjects);
+        OnCompleted(SpawnedObjects);
+        return;
+    }
+
+    CompleteSpawnJob();
+    SpawnJob = MakeShared<FAmbitSpawnJob>(
+        Transforms, FAmbitCounterRandom(RandomSeed, FAmbitCounterRandom::GetSpawnerId(this)), MoveTemp(OnCompleted));
+    SpawnJob->Spawner = this;
+    SpawnQueue.Add(SpawnJob);
+    if (!SpawnQueueTicker.IsValid())
+    {
+        SpawnQueueTicker = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickSpawnQueue));
+    }
+}
+
+bool ASpawnerBase::TickSpawnQueue(float DeltaTime)
+{
+    const double FrameStart = FPlatformTime::Seconds();
+    while (SpawnQueue.Num() > 0)
+    {
+        const TSharedPtr<FAmbitSpawnJob> Job = SpawnQueue[0];
+        ASpawnerBase* Spawner = Job->Spawner.Get();
+        if (Spawner == nullptr)
         {
-            TArray<UStaticMeshComponent*> StaticMeshComponents;
-            AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(Actor.Get(), StaticMeshComponents);
-            AmbitSpawnerCollisionHelpers::StoreCollisionProfiles(Actor->GetPathName(), StaticMeshComponents, OutMap);
-            AmbitSpawnerCollisionHelpers::SetCollisionForAllStaticMeshComponents(StaticMeshComponents, bRemoveOverlaps);
+            // The spawner went away without ending play.
+            SpawnQueue.RemoveAt(0);
+            continue;
         }
+
+        // The budget may have been set to 0 after the job was queued.
+        const double Deadline = Spawner->SpawnBudgetMilliseconds > 0.f
+                                    ? FrameStart + Spawner->SpawnBudgetMilliseconds / 1000.0
+                                    : TNumericLimits<double>::Max();
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+        if (!Job->bStarted)
+        {
+            Spawner->BeginSpawnJob(*Job);
+        }
+        if (!Spawner->ContinueSpawnJob(*Job, Deadline))
+        {
+            UE_LOG(LogAmbit, Display, TEXT("%s: Handled %i of %i placements."), *Spawner->GetActorLabel(),
+                   Job->NextIndex, Job->Transforms.Num());
+            break;
+        }
+        SpawnQueue.RemoveAt(0);
+        Spawner->SpawnJob.Reset();
+        Spawner->EndSpawnJob(*Job);
     }
+
+    if (SpawnQueue.Num() == 0)
+    {
+        SpawnQueueTicker.Reset();
+        return false;
+    }
+    return true;
 }
 
-void ASpawnerBase::SpawnActorsAtTransforms(const TArray<FTransform>& Transforms,
-                                           TMap<FString, TArray<FTransform>>& OutMap)
+void ASpawnerBase::CompleteSpawnJob()
 {
-    OutMap.Empty();
+    if (!SpawnJob.IsValid())
+    {
+        return;
+    }
 
-    Random.Initialize(RandomSeed);
-    UWorld* World = GetWorld();
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    TMap<FString, TArray<bool>> OriginalGenerateOverlapEventsMap;
-    for (AActor* Actor : AllActors)
+    const TSharedPtr<FAmbitSpawnJob> Job = SpawnJob;
+    SpawnJob.Reset();
+    SpawnQueue.Remove(Job);
+    if (!Job->bStarted)
     {
-        TArray<bool> OriginalGenerateOverlapEvents;
-        // Set GenerateOverlapEvents to true while Play mode is active
-        AmbitSpawnerCollisionHelpers::SetGenerateOverlapEventsForActor(Actor, OriginalGenerateOverlapEvents);
-        // Store original overlap event settings
-        OriginalGenerateOverlapEventsMap.Add(Actor->GetName(), OriginalGenerateOverlapEvents);
+        BeginSpawnJob(*Job);
     }
+    ContinueSpawnJob(*Job, TNumericLimits<double>::Max());
+    EndSpawnJob(*Job);
+}
 
-    // Remove duplicates from array and set up collision profiles for ActorsToSpawn
-    TArray<TSubclassOf<AActor>> ActorsToSpawnClean;
-    TMap<FString, TArray<FCollisionResponseTemplate>> OriginalCollisionProfiles;
-    CleanAndSetUpActorsToSpawn(ActorsToSpawnClean, OriginalCollisionProfiles);
+void ASpawnerBase::CancelSpawnJob()
+{
+    if (!SpawnJob.IsValid())
+    {
+        return;
+    }
 
-    for (const FTransform& Transform : Transforms)
+    SpawnQueue.Remove(SpawnJob);
+    SpawnJob.Reset();
+}
+
+float ASpawnerBase::GetSpawnProgress() const
+{
+    if (!SpawnJob.IsValid() || SpawnJob->Transforms.Num() == 0)
     {
-        FVector SpawnedActorLocation = Transform.GetLocation();
-        const FRotator& SpawnedActorRotation = Transform.Rotator();
+        return 1.f;
+    }
+    return static_cast<float>(SpawnJob->NextIndex) / SpawnJob->Transforms.Num();
+}
 
-        int32 RandomIndex = 0;
-        if (ActorsToSpawnClean.Num() > 1)
+void ASpawnerBase::BeginSpawnJob(FAmbitSpawnJob& Job)
+{
+    Job.bStarted = true;
+
+    // Remove duplicates from array and find the collision of the obstacles of each class.
+    // The class defaults are not changed.
+    CleanActorsToSpawn(Job.ActorsToSpawnClean);
+    UAmbitCollisionTemplateSubsystem* Templates = GEngine->GetEngineSubsystem<UAmbitCollisionTemplateSubsystem>();
+    for (const TSubclassOf<AActor>& Actor : Job.ActorsToSpawnClean)
+    {
+        Job.Collisions.Add(Templates->FindOrAdd(Actor.Get(), bRemoveOverlaps));
+        Job.PathNames.Add(*Actor.Get()->GetPathName());
+    }
+
+    // Classes made of static meshes only are drawn as instances, unless physics needs actors.
+    Job.InstanceableMeshes.SetNum(Job.ActorsToSpawnClean.Num());
+    Job.InstanceRootScales.Init(FVector::OneVector, Job.ActorsToSpawnClean.Num());
+    if (OutputMode == ESpawnerOutputMode::InstancedStaticMeshes && !bAddPhysics)
+    {
+        for (int32 i = 0; i < Job.ActorsToSpawnClean.Num(); i++)
         {
-            RandomIndex = Random.RandRange(0, ActorsToSpawnClean.Num() - 1);
+            UClass* Actor = Job.ActorsToSpawnClean[i].Get();
+            if (!AmbitSpawnerCollisionHelpers::GetInstanceableMeshes(Actor, Job.InstanceableMeshes[i],
+                                                                     Job.InstanceRootScales[i]))
+            {
+                UE_LOG(LogAmbit, Display, TEXT("%s: %s is not made of static meshes only, so it is spawned as actors."),
+                       *this->GetActorLabel(), *Actor->GetName());
+            }
         }
-        // ActorsToSpawnClean will always have at least one element;
-        // it contains all elements of a non-empty ActorsToSpawn (with duplicates removed)
-        TSubclassOf<AActor> ChosenActor = ActorsToSpawnClean[RandomIndex];
+    }
+    if (IsValid(SpawnedInstances))
+    {
+        SpawnedInstances->ClearInstances();
+    }
 
-        FActorSpawnParameters ActorSpawnParams;
-        ActorSpawnParams.SpawnCollisionHandlingOverride =
-                ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+    // Spawned obstacles that overlap each other are destroyed below, so placements whose
+    // footprint overlaps an obstacle that has already been spawned are rejected in memory
+    // instead of paying for SpawnActor. Physics stacking relies on failed spawns,
+    // so the footprints are only used when physics is off.
+    Job.bUseFootprints = bRemoveOverlaps && !bAddPhysics;
+    // The rest of the world is tested with the shapes of each class before spawning for the same reason,
+    // except with physics, which needs an actor to try stacking it.
+    Job.bTestWorldBeforeSpawn = !bAddPhysics;
+    float LargestFootprint = 0.f;
+    for (const TSubclassOf<AActor>& Actor : Job.ActorsToSpawnClean)
+    {
+        const FBox& Footprint = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(Actor.Get());
+        Job.Footprints.Add(Footprint);
+        if (Footprint.IsValid)
+        {
+            LargestFootprint = FMath::Max3(LargestFootprint, Footprint.GetSize().X, Footprint.GetSize().Y);
+        }
+    }
+    Job.Broadphase = FAmbitPlacementBroadphase(LargestFootprint > 0.f ? LargestFootprint : 100.f);
 
-        // Try to spawn actor at location
-        // will do nothing if it would overlap with any other spawned actor
-        AActor* SpawnedActor = World->SpawnActor(ChosenActor.Get(), &SpawnedActorLocation, &SpawnedActorRotation,
-                                                 ActorSpawnParams);
+    const TArray<FTransform>& Transforms = Job.Transforms;
+    const TArray<TSubclassOf<AActor>>& ActorsToSpawnClean = Job.ActorsToSpawnClean;
+    Job.ClassIndices = ChooseClassIndices(Job.Random, Transforms.Num(), ActorsToSpawnClean.Num());
+    ReservePlacements(Job.ClassIndices, Job.PathNames, Job.SpawnedObjects);
 
-        // Try to spawn actor again at offset
-        // if bAddPhysics is true and first spawn attempt failed
-        // in order to potentially "stack"
-        // TODO: If Add Physics is turned on, should AmbitSpawners spawn obstacles one at a time?
-        // TODO: Unreal Engine does not necessarily have a set order in which Actors are processed,
-        // so this may be non-deterministic
-        if (!IsValid(SpawnedActor) && bAddPhysics)
+    // During a regeneration, find the actors that are placed again with the same class and location.
+    // The others are destroyed before anything is spawned, so that they cannot block new actors.
+    Job.KeptActorIndices.Init(INDEX_NONE, Transforms.Num());
+    Job.ReusableCount = ReusableActors.Num();
+    if (ReusableActors.Num() > 0)
+    {
+        TMultiMap<FIntVector, int32> ReusableByLocation;
+        for (int32 i = 0; i < ReusableActors.Num(); i++)
         {
-            FVector LocationOffset(0, 0, 100);
-            SpawnedActorLocation = SpawnedActorLocation + LocationOffset;
-            SpawnedActor = World->SpawnActor(ChosenActor.Get(), &SpawnedActorLocation, &SpawnedActorRotation,
-                                             ActorSpawnParams);
+            if (IsValid(ReusableActors[i]))
+            {
+                ReusableByLocation.Add(FIntVector(ReusablePlacements[i].GetLocation()), i);
+            }
         }
-
-        if (IsValid(SpawnedActor))
+        for (int32 TransformIndex = 0; TransformIndex < Transforms.Num(); TransformIndex++)
         {
-            UStaticMeshComponent* PhysicsComponent = SpawnedActor->FindComponentByClass<UStaticMeshComponent>();
-            if (bAddPhysics)
+            const FVector& Location = Transforms[TransformIndex].GetLocation();
+            // Instanced classes do not keep actors.
+            if (Job.InstanceableMeshes[Job.ClassIndices[TransformIndex]].Num() > 0)
             {
-                // Set mobility
-                PhysicsComponent->SetMobility(EComponentMobility::Movable);
-
-                // If actor could not be spawned at surface level,
-                // we want to sweep it to the surface and check for collision along the way
-                // before enabling SimulatePhysics
-                if (SpawnedActor->GetActorLocation() != Transform.GetLocation())
-                {
-                    PhysicsComponent->SetWorldLocation(Transform.GetLocation(), true, nullptr,
-                                                       ETeleportType::ResetPhysics);
-                }
+                continue;
             }
-            // Check for any overlaps and verify that overlaps are not beyond the surface
-            // of the overlapping actor
-            TArray<UPrimitiveComponent*> OverlappingComponents;
-            SpawnedActor->GetOverlappingComponents(OverlappingComponents);
-            for (UPrimitiveComponent* OverlappingComponent : OverlappingComponents)
+            const UClass* ChosenClass = ActorsToSpawnClean[Job.ClassIndices[TransformIndex]].Get();
+            for (auto It = ReusableByLocation.CreateKeyIterator(FIntVector(Location)); It; ++It)
             {
-                if (AmbitSpawnerCollisionHelpers::IsPenetratingOverlap(OverlappingComponent, SpawnedActor))
+                const int32 Reusable = It.Value();
+                if (ReusableActors[Reusable]->GetClass() == ChosenClass
+                    && ReusablePlacements[Reusable].GetLocation().Equals(Location, KINDA_SMALL_NUMBER))
                 {
-                    SpawnedActor->Destroy();
+                    Job.KeptActorIndices[TransformIndex] = Reusable;
+                    It.RemoveCurrent();
                     break;
                 }
             }
+        }
+        for (const TPair<FIntVector, int32>& Unused : ReusableByLocation)
+        {
+            ReleaseActor(ReusableActors[Unused.Value]);
+        }
+    }
 
-            // Makes sure that SpawnedActor did not have any overlaps
-            // and was not destroyed
-            if (IsValid(SpawnedActor))
-            {
-                // Set the collision profile(s) of this ActorToSpawn instance
-                // to the original collision profile(s) of the class default object
-                TArray<UStaticMeshComponent*> StaticMeshComponents;
-                SpawnedActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
-
-                const FString& PathName = ChosenActor.Get()->GetPathName();
-                const TArray<FCollisionResponseTemplate> OriginalResponses = OriginalCollisionProfiles.FindChecked(
-                    PathName);
-                for (int i = 0; i < StaticMeshComponents.Num(); i++)
-                {
-                    UStaticMeshComponent* StaticMeshComponent = StaticMeshComponents[i];
-                    FCollisionResponseTemplate Response = OriginalResponses[i];
-
-                    // Restores the collision profile of this specific actor
-                    // to match expected collision behavior of the asset
-                    // Maintains ObjectType as "AmbitSpawnerObstacle"
-                    // to ensure no overlaps occur with future spawned objects
-                    StaticMeshComponent->SetCollisionResponseToChannels(Response.ResponseToChannels);
-                    StaticMeshComponent->SetCollisionEnabled(Response.CollisionEnabled);
-
-                    // Maintains that "Overlappable" Obstacles
-                    // are continued to be recognized as such
-                    // This is set to Overlap to ensure that
-                    // actors (not spawned by AmbitSpawners)
-                    // will respond to the spawned obstacle correctly
-                    // if it is supposed to generate overlap events.
-                    // The AmbitSpawner Overlap detection/destruction
-                    // will ignore AMBIT_SPAWNER_OVERLAP typed objects.
-                    StaticMeshComponent->SetCollisionResponseToChannel(ECC_GameTraceChannel2, // AMBIT_SPAWNED_OVERLAP
-                                                                       ECR_Overlap);
-                }
+    // Built once the actors that are not kept are gone, so that they are not in the scene.
+    if (bUsePlacementScene && Job.bTestWorldBeforeSpawn)
+    {
+        TArray<const FSpawnedObstacleCollision*> Collisions;
+        for (const FSpawnedObstacleCollisionRef& Collision : Job.Collisions)
+        {
+            Collisions.Add(&Collision.Get());
+        }
+        Job.PlacementScene = MakePlacementScene(Transforms, Collisions, TArray<const AActor*>());
+    }
+}
 
-                // Turn on Simulate Physics if bAddPhysics is true
-                if (bAddPhysics && !PhysicsComponent->IsSimulatingPhysics())
-                {
-                    PhysicsComponent->SetSimulatePhysics(true);
-                }
+bool ASpawnerBase::ContinueSpawnJob(FAmbitSpawnJob& Job, double Deadline)
+{
+    while (Job.NextIndex < Job.Transforms.Num())
+    {
+        if (Job.bTestWorldBeforeSpawn && Job.NextIndex >= Job.WorldTestedCount)
+        {
+            TestWorldBeforeSpawn(Job, FMath::Min(Job.NextIndex + KWorldTestBatchSize, Job.Transforms.Num()));
+        }
+        SpawnAtPlacement(Job, Job.NextIndex++);
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+    return Job.NextIndex >= Job.Transforms.Num();
+}
 
-                // Add FTransform to map for SDF export
-                SpawnedActors.Push(SpawnedActor);
-                TArray<FTransform> PathNameTransforms;
-                if (bAddPhysics)
-                {
-                    PathNameTransforms.Add(PhysicsComponent->GetComponentTransform());
-                }
-                else
-                {
-                    PathNameTransforms.Add(SpawnedActor->GetActorTransform());
-                }
-                // Update map array value to include new transform
-                if (OutMap.Find(PathName) != nullptr)
-                {
-                    PathNameTransforms.Append(OutMap.FindAndRemoveChecked(PathName));
-                }
-                OutMap.Add(PathName, PathNameTransforms);
+void ASpawnerBase::TestWorldBeforeSpawn(FAmbitSpawnJob& Job, int32 EndIndex) const
+{
+    const int32 StartIndex = Job.WorldTestedCount;
+    Job.BlockedByWorld.SetNumZeroed(EndIndex);
+    Job.Adjustments.SetNumZeroed(EndIndex);
+    Job.WorldTestedCount = EndIndex;
+
+    // Nothing changes the world while the placements are tested, so they are tested in parallel.
+    // Kept actors are already in the world, where they would block their own placement.
+    const UWorld* World = GetWorld();
+    const FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitPlacementBeforeSpawn));
+    const bool bAdjust = bAdjustOverlappingPlacements;
+    ParallelFor(EndIndex - StartIndex, [&Job, World, &Params, bAdjust, StartIndex](int32 Offset)
+    {
+        const int32 TransformIndex = StartIndex + Offset;
+        if (Job.KeptActorIndices[TransformIndex] != INDEX_NONE)
+        {
+            return;
+        }
+        const FSpawnedObstacleCollision& Collision = *Job.Collisions[Job.ClassIndices[TransformIndex]];
+        FTransform Placement = Job.Transforms[TransformIndex];
+        bool bIsBlocked = Job.PlacementScene.IsValid()
+                              ? AmbitSpawnerCollisionHelpers::IsPlacementBlocked(
+                                  *Job.PlacementScene, Collision, Placement)
+                              : AmbitSpawnerCollisionHelpers::IsPlacementBlocked(World, Collision, Placement, Params);
+        if (bIsBlocked && bAdjust)
+        {
+            bIsBlocked = Job.PlacementScene.IsValid()
+                             ? !AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(
+                                 *Job.PlacementScene, Collision, Placement)
+                             : !AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(
+                                 World, Collision, Placement, Params);
+            Job.Adjustments[TransformIndex] = Placement.GetLocation() - Job.Transforms[TransformIndex].GetLocation();
+        }
+        Job.BlockedByWorld[TransformIndex] = bIsBlocked;
+    });
+}
+
+void ASpawnerBase::SpawnAtPlacement(FAmbitSpawnJob& Job, int32 TransformIndex)
+{
+    const FTransform& Transform = Job.Transforms[TransformIndex];
+    FVector SpawnedActorLocation = Transform.GetLocation();
+    const FRotator& SpawnedActorRotation = Transform.Rotator();
+
+    const int32 RandomIndex = Job.ClassIndices[TransformIndex];
+    // ActorsToSpawnClean will always have at least one element;
+    // it contains all elements of a non-empty ActorsToSpawn (with duplicates removed)
+    TSubclassOf<AActor> ChosenActor = Job.ActorsToSpawnClean[RandomIndex];
+    const FName PathName = Job.PathNames[RandomIndex];
+
+    const FBox& Footprint = Job.Footprints[RandomIndex];
+    if (Job.bUseFootprints && Footprint.IsValid
+        && Job.Broadphase.Overlaps(Footprint, FTransform(Transform.GetRotation(), SpawnedActorLocation)))
+    {
+        Job.RejectedBeforeSpawn++;
+        return;
+    }
+
+    if (Job.bTestWorldBeforeSpawn && Job.BlockedByWorld[TransformIndex])
+    {
+        Job.RejectedBeforeSpawn++;
+        return;
+    }
+
+    // A placement moved out of the obstacles in the world must not be moved into one placed by this job.
+    if (Job.bTestWorldBeforeSpawn && !Job.Adjustments[TransformIndex].IsZero())
+    {
+        SpawnedActorLocation += Job.Adjustments[TransformIndex];
+        if (Job.bUseFootprints && Footprint.IsValid
+            && Job.Broadphase.Overlaps(Footprint, FTransform(Transform.GetRotation(), SpawnedActorLocation)))
+        {
+            Job.RejectedBeforeSpawn++;
+            return;
+        }
+    }
+    const FTransform Placement(Transform.GetRotation(), SpawnedActorLocation, Transform.GetScale3D());
+
+    if (Job.InstanceableMeshes[RandomIndex].Num() > 0)
+    {
+        PlaceInstances(Job, RandomIndex, Placement);
+        if (Job.bUseFootprints && Footprint.IsValid)
+        {
+            Job.Broadphase.Add(Footprint, FTransform(Transform.GetRotation(), SpawnedActorLocation));
+        }
+        if (bRemoveOverlaps && Job.PlacementScene.IsValid())
+        {
+            Job.PlacementScene->AddObstacle(*Job.Collisions[RandomIndex], Placement);
+        }
+        RecordSpawnedInstance(FTransform(Transform.GetRotation(), SpawnedActorLocation,
+                                         Job.InstanceRootScales[RandomIndex]), PathName, Job.SpawnedObjects);
+        return;
+    }
+
+    const int32 KeptActorIndex = Job.KeptActorIndices[TransformIndex];
+    if (KeptActorIndex != INDEX_NONE && IsValid(ReusableActors[KeptActorIndex]))
+    {
+        AActor* KeptActor = ReusableActors[KeptActorIndex];
+        ReusableActors[KeptActorIndex] = nullptr;
+        // Only the rotation can differ, for example when the rotation range was edited.
+        if (!ReusablePlacements[KeptActorIndex].GetRotation().Equals(Transform.GetRotation()))
+        {
+            KeptActor->SetActorRotation(Transform.GetRotation(), ETeleportType::ResetPhysics);
+        }
+        if (Job.bUseFootprints && Footprint.IsValid)
+        {
+            Job.Broadphase.Add(Footprint, FTransform(KeptActor->GetActorQuat(), KeptActor->GetActorLocation()));
+        }
+        RecordSpawnedActor(KeptActor, Transform, PathName, Job.SpawnedObjects);
+        Job.KeptActors++;
+        return;
+    }
+
+    // Spawn actor at location
+    // it is released again below if it cannot stay there
+    const FSpawnedObstacleCollision& Collision = *Job.Collisions[RandomIndex];
+    AActor* SpawnedActor = AcquireActor(ChosenActor.Get(), SpawnedActorLocation, SpawnedActorRotation, Collision);
+    if (!IsValid(SpawnedActor))
+    {
+        return;
+    }
+
+    UStaticMeshComponent* PhysicsComponent = SpawnedActor->FindComponentByClass<UStaticMeshComponent>();
+    if (bAddPhysics)
+    {
+        // Set mobility
+        PhysicsComponent->SetMobility(EComponentMobility::Movable);
+    }
+
+    // Without physics the placement was already tested against the world before spawning.
+    // Otherwise check for any overlaps and verify that overlaps are not beyond the surface
+    // of the overlapping actor
+    bool bIsBlocked = bAddPhysics && AmbitSpawnerCollisionHelpers::IsPlacementBlocked(SpawnedActor, Collision);
+
+    // Move it out of the obstacles that block it if possible, as placements without physics were moved above
+    if (bIsBlocked && bAdjustOverlappingPlacements)
+    {
+        FTransform Adjusted = Placement;
+        const FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitPlacementAdjustment), false, SpawnedActor);
+        if (AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(GetWorld(), Collision, Adjusted, Params))
+        {
+            SpawnedActorLocation = Adjusted.GetLocation();
+            SpawnedActor->SetActorLocation(SpawnedActorLocation, false, nullptr, ETeleportType::ResetPhysics);
+            bIsBlocked = AmbitSpawnerCollisionHelpers::IsPlacementBlocked(SpawnedActor, Collision);
+        }
+    }
+
+    // Try to place actor again at offset
+    // if bAddPhysics is true and first attempt failed
+    // in order to potentially "stack"
+    // TODO: If Add Physics is turned on, should AmbitSpawners spawn obstacles one at a time?
+    // TODO: Unreal Engine does not necessarily have a set order in which Actors are processed,
+    // so this may be non-deterministic
+    if (bIsBlocked && bAddPhysics)
+    {
+        FVector LocationOffset(0, 0, 100);
+        SpawnedActorLocation = SpawnedActorLocation + LocationOffset;
+        SpawnedActor->SetActorLocation(SpawnedActorLocation, false, nullptr, ETeleportType::ResetPhysics);
+        bIsBlocked = AmbitSpawnerCollisionHelpers::IsPlacementBlocked(SpawnedActor, Collision);
+        if (!bIsBlocked)
+        {
+            // If actor could not be placed at surface level,
+            // we want to sweep it to the surface and check for collision along the way
+            // before enabling SimulatePhysics
+            PhysicsComponent->SetWorldLocation(Transform.GetLocation(), true, nullptr, ETeleportType::ResetPhysics);
+            bIsBlocked = AmbitSpawnerCollisionHelpers::IsPlacementBlocked(SpawnedActor, Collision);
+        }
+    }
+
+    if (bIsBlocked)
+    {
+        ReleaseActor(SpawnedActor);
+        return;
+    }
+
+    // Simulate Physics is turned on once every actor is spawned, so that actors spawned
+    // in earlier frames have not moved when later ones are spawned.
+    if (bAddPhysics && !PhysicsComponent->IsSimulatingPhysics())
+    {
+        Job.ComponentsToSimulate.Add(PhysicsComponent);
+    }
+
+    if (Job.bUseFootprints && Footprint.IsValid)
+    {
+        // The footprint already includes the scale of the default components.
+        Job.Broadphase.Add(Footprint, FTransform(SpawnedActor->GetActorQuat(), SpawnedActor->GetActorLocation()));
+    }
+    if (bRemoveOverlaps && Job.PlacementScene.IsValid())
+    {
+        Job.PlacementScene->AddObstacle(Collision, Placement);
+    }
+
+    RecordSpawnedActor(SpawnedActor, Transform, PathName, Job.SpawnedObjects);
+}
+
+void ASpawnerBase::EndSpawnJob(FAmbitSpawnJob& Job)
+{
+    if (Job.bUseFootprints || Job.bTestWorldBeforeSpawn)
+    {
+        UE_LOG(LogAmbit, Display, TEXT("%s: Rejected %i of %i placements before spawning."), *this->GetActorLabel(),
+               Job.RejectedBeforeSpawn, Job.Transforms.Num());
+    }
+    if (Job.ReusableCount > 0)
+    {
+        UE_LOG(LogAmbit, Display, TEXT("%s: Kept %i of %i actors."), *this->GetActorLabel(), Job.KeptActors,
+               Job.ReusableCount);
+
+        // Kept actors whose placement was rejected.
+        for (AActor* Actor : ReusableActors)
+        {
+            if (IsValid(Actor))
+            {
+                ReleaseActor(Actor);
             }
         }
+        ReusableActors.Empty();
+        ReusablePlacements.Empty();
+    }
+
+    if (IsValid(SpawnedInstances))
+    {
+        SpawnedInstances->BuildTrees();
+    }
+
+    for (const TWeakObjectPtr<UStaticMeshComponent>& Component : Job.ComponentsToSimulate)
+    {
+        if (Component.IsValid())
+        {
+            Component->SetSimulatePhysics(true);
+        }
+    }
+
+    if (Job.OnCompleted)
+    {
+        Job.OnCompleted(Job.SpawnedObjects);
+    }
+}
+
+TUniquePtr<FAmbitPlacementScene> ASpawnerBase::MakePlacementScene(
+    const TArray<FTransform>& Transforms, const TArray<const FSpawnedObstacleCollision*>& Collisions,
+    const TArray<const AActor*>& IgnoredActors) const
+{
+    // How far the shapes of an obstacle reach from its placement.
+    float Reach = 0.f;
+    for (const FSpawnedObstacleCollision* Collision : Collisions)
+    {
+        for (const FSpawnedObstacleShape& Shape : Collision->Shapes)
+        {
+            Reach = FMath::Max(Reach, Shape.ActorSpaceTransform.GetLocation().Size() + Shape.Shape.GetExtent().Size());
+        }
     }
-    // Restore CDO collision profiles to original
-    AmbitSpawnerCollisionHelpers::ResetCollisionProfiles(OriginalCollisionProfiles, ActorsToSpawnClean);
 
-    for (const auto& Actor : AllActors)
+    FBox Bounds(ForceInit);
+    for (const FTransform& Transform : Transforms)
+    {
+        Bounds += Transform.GetLocation();
+    }
+    if (Bounds.IsValid)
+    {
+        Bounds = Bounds.ExpandBy(Reach);
+    }
+
+    const TArray<AActor*>& SurfaceActors = AmbitWorldHelpers::GetActorsByMatchBy(
+        MatchBy, SurfaceNamePattern, SurfaceTags);
+    TUniquePtr<FAmbitPlacementScene> Scene = MakeUnique<FAmbitPlacementScene>(
+        GetWorld(), SurfaceActors, Bounds, IgnoredActors, Reach > 0.f ? 2 * Reach : 100.f);
+    UE_LOG(LogAmbit, Display, TEXT("%s: Placing in a scene of %i components."), *this->GetActorLabel(),
+           Scene->NumComponents());
+    return Scene;
+}
+
+void ASpawnerBase::PlaceInstances(FAmbitSpawnJob& Job, int32 ClassIndex, const FTransform& Transform)
+{
+    if (!IsValid(SpawnedInstances))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnedInstances = GetWorld()->SpawnActor<ASpawnedInstances>(SpawnParams);
+#if WITH_EDITOR
+        SpawnedInstances->SetActorLabel(this->GetActorLabel() + TEXT("_Instances"));
+#endif
+    }
+
+    const TArray<FInstanceableMesh>& Meshes = Job.InstanceableMeshes[ClassIndex];
+    const FSpawnedObstacleCollision& Collision = *Job.Collisions[ClassIndex];
+    const FTransform Placement(Transform.GetRotation(), Transform.GetLocation());
+    for (const FInstanceableMesh& Mesh : Meshes)
+    {
+        int32 Index;
+        SpawnedInstances->AddInstance(Mesh.Template, Collision.Components[Mesh.ComponentIndex],
+                                      Mesh.ActorSpaceTransform * Placement, Index);
+    }
+}
+
+int32 ASpawnerBase::GetSpawnedInstanceCount() const
+{
+    return IsValid(SpawnedInstances) ? SpawnedInstances->GetInstanceCount() : 0;
+}
+
+void ASpawnerBase::RecordSpawnedInstance(const FTransform& ActorTransform, FName PathName,
+                                         FPlacementBuffer& OutPlacements)
+{
+    // Recorded as RecordSpawnedActor does, so that the export does not depend on the output mode.
+    OutPlacements.Add(PathName, ActorTransform);
+}
+
+void ASpawnerBase::RecordSpawnedActor(AActor* Actor, const FTransform& Placement, FName PathName,
+                                      FPlacementBuffer& OutPlacements)
+{
+    // Add FTransform to placements for SDF export
+    SpawnedActors.Push(Actor);
+    SpawnedPlacements.Push(Placement);
+    if (bAddPhysics)
+    {
+        OutPlacements.Add(PathName, Actor->FindComponentByClass<UStaticMeshComponent>()->GetComponentTransform());
+    }
+    else
     {
-        TArray<bool> OriginalGenerateOverlapEvents = OriginalGenerateOverlapEventsMap.FindChecked(Actor->GetName());
-        // Reset GenerateOverlapEvents
-        AmbitSpawnerCollisionHelpers::SetGenerateOverlapEventsForActor(Actor, OriginalGenerateOverlapEvents, true);
+        OutPlacements.Add(PathName, Actor->GetActorTransform());
     }
 }
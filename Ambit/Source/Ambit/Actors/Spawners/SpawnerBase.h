@@ -19,13 +19,34 @@
 #include "GameFramework/Actor.h"
 
 #include "AmbitSpawner.h"
+#include "Ambit/Utils/AmbitWorldHelpers.h"
 #include "Ambit/Utils/MatchBy.h"
+#include "Ambit/Utils/PlacementBuffer.h"
+#include "Ambit/Utils/PlacementDistribution.h"
+#include "Ambit/Utils/SpawnerOutputMode.h"
 
 #include "SpawnerBase.generated.h"
 
+class ASpawnedInstances;
+class FAmbitPlacementScene;
+struct FAmbitSpawnJob;
 struct FSpawnerBaseConfig;
+struct FSpawnedObstacleCollision;
 class USpawnedObjectConfig;
 
+/**
+ * How a spawner finds where to place obstacles, in two steps: Draw computes candidate placements
+ * from data the spawner copied from itself and its surfaces, and Snap snaps them to the surfaces.
+ */
+struct FSpawnerTransformGenerator
+{
+    // Reads no UObjects, so regeneration runs it on a worker thread while the user keeps editing.
+    TFunction<AmbitWorldHelpers::FPlacementCandidates()> Draw;
+
+    // Traces against the world, so it runs on the game thread. It is given the surfaces the spawner matched.
+    TFunction<TArray<FTransform>(const AmbitWorldHelpers::FPlacementCandidates&, const TArray<AActor*>&)> Snap;
+};
+
 /**
  * This abstract class is a base class for Ambit Spawners that generate
  * BP actor obstacles to screen (e.g.SpawnOnSpline)
@@ -114,12 +135,65 @@ public:
     UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = "Ambit Spawner")
     bool bRemoveOverlaps = true;
 
+    /**
+     * Whether a placement that is blocked by an obstacle already in the world is moved out of it
+     * where possible, as SpawnActor moves actors with AdjustIfPossibleButDontSpawnIfColliding,
+     * instead of being skipped. Without physics, placements whose static mesh bounds overlap
+     * an obstacle placed earlier by the same spawn are skipped either way.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = "Ambit Spawner")
+    bool bAdjustOverlappingPlacements = true;
+
+    /**
+     * How spawn locations are distributed. Poisson disk keeps locations at least
+     * one obstacle apart, so fewer of them are lost to overlaps and obstacles do not cluster.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    TEnumAsByte<EPlacementDistribution> PlacementDistribution = EPlacementDistribution::UniformRandom;
+
     /**
      * Change this value to generate different random arrangements.
      */
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
     int32 RandomSeed = 0;
 
+    /**
+     * How many milliseconds per frame spawning may take. Spawning continues
+     * on the following frames until every actor is placed. 0 spawns everything at once.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner", meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float SpawnBudgetMilliseconds = 8.f;
+
+    /**
+     * Whether removed actors are kept hidden and reused by later generations
+     * instead of being destroyed and spawned again.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    bool bPoolActors = true;
+
+    /**
+     * Whether to spawn an actor per placement, or to draw actors that are made of static meshes only
+     * as instances on a single actor. Actors with physics are always spawned.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    TEnumAsByte<ESpawnerOutputMode> OutputMode = ESpawnerOutputMode::ActorPerPlacement;
+
+    /**
+     * Whether exports find the placements that spawning would keep without spawning anything, by testing
+     * the collision of ActorsToSpawn against the world and against each other's static mesh bounds.
+     * Spawners with physics always spawn to export.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    bool bExportWithoutSpawning = true;
+
+    /**
+     * Whether placements are tested against a private scene, built once per spawn or export,
+     * that holds only the matched surfaces, the components around the placements and the obstacles
+     * placed so far, instead of against the whole world. Spawners with physics always use the world.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Ambit Spawner")
+    bool bUsePlacementScene = false;
+
     /**
      * @inheritDoc
      */
@@ -160,40 +234,164 @@ public:
      */
     void GenerateSpawnedObjectConfiguration(int32 Seed) override;
 
+    /**
+     * Returns the fraction of placements handled by the spawning in progress,
+     * or 1 if this instance is not spawning.
+     */
+    float GetSpawnProgress() const;
 
 protected:
     TArray<AActor*> SpawnedActors;
 
-    // Used to generate repeatable random numbers.
-    FRandomStream Random;
-
     // Called when the game starts or when spawned
     void BeginPlay() override;
 
     // Called when an actor is done spawning into the world
     void PostActorCreated() override;
 
-    // Creates no-duplicate version of ActorsToSpawn array and adjusts
-    // collision profiles to match ambit spawned obstacles profile
-    void CleanAndSetUpActorsToSpawn(TArray<TSubclassOf<AActor>>& OutArray,
-                                    TMap<FString, TArray<FCollisionResponseTemplate>>& OutMap);
+    // Called when play ends for this actor
+    void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Called when this actor is explicitly being destroyed
+    void Destroyed() override;
+
+    // Creates no-duplicate version of ActorsToSpawn array
+    void CleanActorsToSpawn(TArray<TSubclassOf<AActor>>& OutArray) const;
+
+    // Spawns actors as specified by this object's parameters.
+    virtual FPlacementBuffer GenerateActors();
+
+    // Spawns actors as specified by this object's parameters within SpawnBudgetMilliseconds per frame,
+    // then calls OnCompleted with the transforms of the spawned actors.
+    void GenerateActorsOverFrames(TFunction<void(FPlacementBuffer&)> OnCompleted);
 
-    virtual TMap<FString, TArray<FTransform>> GenerateActors()
-    PURE_VIRTUAL(AmbitSpawnerParent::GenerateActors, 
-                 return TMap<FString, TArray<FTransform>>(););
+    // Returns where to place obstacles, given the surfaces that match this spawner.
+    TArray<FTransform> GenerateTransforms(const TArray<AActor*>& SurfaceActors) const;
+
+    // Returns the steps that compute GenerateTransforms(SurfaceActors). Draw copies everything it needs from
+    // this spawner and SurfaceActors up front, on the game thread.
+    virtual FSpawnerTransformGenerator MakeTransformGenerator(const TArray<AActor*>& SurfaceActors) const
+    PURE_VIRTUAL(ASpawnerBase::MakeTransformGenerator,
+                 return FSpawnerTransformGenerator(););
+
+    // Regenerates actors once the user has stopped editing for a moment.
+    // Placements are computed in the background, and actors whose placement
+    // did not change are kept instead of being spawned again.
+    void ScheduleRegeneration(const FPropertyChangedEvent& PropertyChangedEvent);
 
     // Spawns actors using locations and rotations in provided array
-    void SpawnActorsAtTransforms(const TArray<FTransform>& Transforms, TMap<FString, TArray<FTransform>>& OutMap);
+    void SpawnActorsAtTransforms(const TArray<FTransform>& Transforms, FPlacementBuffer& OutPlacements);
+
+    // Spawns actors using locations and rotations in provided array within SpawnBudgetMilliseconds per frame,
+    // then calls OnCompleted with the transforms of the spawned actors.
+    void SpawnActorsOverFrames(const TArray<FTransform>& Transforms,
+                               TFunction<void(FPlacementBuffer&)> OnCompleted);
+
+    // Adds the placements among Transforms that SpawnActorsAtTransforms would keep to OutPlacements,
+    // resolving overlaps between the bounds of the static meshes of each class instead of spawning it,
+    // and testing the placements against the placement scene if bUsePlacementScene is set.
+    // Nothing is added to or changed in the world.
+    void PlaceWithoutSpawning(const TArray<FTransform>& Transforms, FPlacementBuffer& OutPlacements) const;
 
     // Destroys any actors that were previously generated.
     void DestroyGeneratedActors();
 
+    // Returns an actor of Class at Location and Rotation with the provided collision, even if it collides.
+    // Reuses an actor from the actor pool if bPoolActors is set.
+    AActor* AcquireActor(UClass* Class, const FVector& Location, const FRotator& Rotation,
+                         const FSpawnedObstacleCollision& Collision);
+
+    // Removes Actor from the world, keeping it in the actor pool if bPoolActors is set.
+    void ReleaseActor(AActor* Actor);
+
+    // Returns the number of placements drawn as instances.
+    int32 GetSpawnedInstanceCount() const;
+
+    // Adds ActorTransform, the transform an actor drawn as instances would have, to OutPlacements for SDF export.
+    void RecordSpawnedInstance(const FTransform& ActorTransform, FName PathName, FPlacementBuffer& OutPlacements);
+
+    // Adds Actor, placed at Placement, to SpawnedActors and its transform to OutPlacements for SDF export.
+    void RecordSpawnedActor(AActor* Actor, const FTransform& Placement, FName PathName,
+                            FPlacementBuffer& OutPlacements);
+
+    // Returns the distance that keeps any two of the ActorsToSpawn from overlapping
+    // whatever their rotation, based on the bounds of their static meshes.
+    float GetMinimumSpacing() const;
+
     // Determines whether the required user parameters have been set.
-    bool AreParametersValid() const;
+    virtual bool AreParametersValid() const;
 
     // Warns the user if the values they've entered pose a potential performance problem
     void PostEditErrorFixes();
 
     // Determines if the min/max fields are valid
     bool AreMinMaxValid() const;
+
+private:
+    // The transform each of SpawnedActors was placed at, before any physics or spawn adjustment.
+    TArray<FTransform> SpawnedPlacements;
+
+    // Actors from before a regeneration, and their placements,
+    // that SpawnActorsAtTransforms keeps when they are placed again.
+    TArray<AActor*> ReusableActors;
+    TArray<FTransform> ReusablePlacements;
+
+    FTimerHandle RegenerationTimer;
+
+    // Counts regenerations, so that placements computed for an outdated edit are dropped.
+    int32 RegenerationRequest = 0;
+
+    // Set when an edit changes how every actor is set up, so that none can be kept.
+    bool bFullRegenerationPending = false;
+
+    // Starts computing placements in the background for the current parameters.
+    void StartRegeneration();
+
+    // Replaces the spawned actors with actors at Transforms, keeping the ones already in place.
+    void FinishRegeneration(const TArray<FTransform>& Transforms);
+
+    // Holds the placements drawn as instances.
+    UPROPERTY()
+    ASpawnedInstances* SpawnedInstances = nullptr;
+
+    // Returns the scene that placements among Transforms, of obstacles with one of Collisions, are tested in,
+    // leaving out the components of IgnoredActors.
+    TUniquePtr<FAmbitPlacementScene> MakePlacementScene(const TArray<FTransform>& Transforms,
+                                                        const TArray<const FSpawnedObstacleCollision*>& Collisions,
+                                                        const TArray<const AActor*>& IgnoredActors) const;
+
+    // Adds the instances of the class at ClassIndex at Transform.
+    void PlaceInstances(FAmbitSpawnJob& Job, int32 ClassIndex, const FTransform& Transform);
+
+    // The spawning this instance has queued or started, if any.
+    TSharedPtr<FAmbitSpawnJob> SpawnJob;
+
+    // Validates the parameters, removes previously spawned actors,
+    // and returns whether OutTransforms holds the placements to spawn at.
+    bool PrepareToGenerate(TArray<FTransform>& OutTransforms);
+
+    // Works out the collision and footprint of each class for spawning, and matches the actors to keep.
+    void BeginSpawnJob(FAmbitSpawnJob& Job);
+
+    // Handles placements until Deadline, in FPlatformTime::Seconds, and returns whether all are handled.
+    bool ContinueSpawnJob(FAmbitSpawnJob& Job, double Deadline);
+
+    // Tests the placements from the job's WorldTestedCount up to EndIndex against the world.
+    void TestWorldBeforeSpawn(FAmbitSpawnJob& Job, int32 EndIndex) const;
+
+    // Spawns, or keeps, the actor for the placement at TransformIndex.
+    void SpawnAtPlacement(FAmbitSpawnJob& Job, int32 TransformIndex);
+
+    // Releases the kept actors that were not reused, builds the instance trees, starts physics
+    // and calls the job's OnCompleted.
+    void EndSpawnJob(FAmbitSpawnJob& Job);
+
+    // Finishes the spawning in progress at once, so that it cannot interleave with new spawning.
+    void CompleteSpawnJob();
+
+    // Stops the spawning in progress without calling its OnCompleted.
+    void CancelSpawnJob();
+
+    // Advances the queued spawning of all spawners, one spawner at a time.
+    static bool TickSpawnQueue(float DeltaTime);
 };
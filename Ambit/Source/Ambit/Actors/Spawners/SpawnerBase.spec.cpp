@@ -0,0 +1,211 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "SpawnerBase.h"
+
+#include "EngineUtils.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
+#include "Ambit/Actors/Spawners/SpawnOnSurface.h"
+
+BEGIN_DEFINE_SPEC(SpawnerBaseSpec, "Ambit.Unit.SpawnerBase",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UClass* PropClass;
+    ASpawnOnSurface* Spawner;
+
+    // Returns the objects that Spawner exports for Seed, with or without spawning them.
+    FPlacementBuffer Export(int32 Seed, bool bWithoutSpawning)
+    {
+        FPlacementBuffer Exported;
+        Spawner->bExportWithoutSpawning = bWithoutSpawning;
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().BindLambda(
+            [&Exported](TScriptInterface<IConfigJsonSerializer>& Config, bool bSuccess)
+            {
+                Exported = Cast<USpawnedObjectConfig>(Config.GetObject())->SpawnedObjects;
+            });
+        Spawner->GenerateSpawnedObjectConfiguration(Seed);
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().Unbind();
+        return Exported;
+    }
+
+    // Checks that exporting without spawning finds the objects that spawning them finds.
+    void TestSameExports(int32 Seeds)
+    {
+        for (int32 Seed = 0; Seed < Seeds; Seed++)
+        {
+            const FPlacementBuffer Spawned = Export(Seed, false);
+            const FPlacementBuffer Placed = Export(Seed, true);
+
+            TestEqual(FString::Printf(TEXT("Seed %i exports the same number of objects."), Seed), Placed.Num(),
+                      Spawned.Num());
+            for (const TPair<FName, FPlacementBuffer::FPlacements>& Class : Spawned.GetClasses())
+            {
+                const FPlacementBuffer::FPlacements* PlacedClass = Placed.Find(Class.Key);
+                const TArray<FTransform> SpawnedTransforms = Class.Value.GetTransforms();
+                const TArray<FTransform> PlacedTransforms = PlacedClass != nullptr
+                                                                ? PlacedClass->GetTransforms()
+                                                                : TArray<FTransform>();
+                TestEqual(FString::Printf(TEXT("Seed %i exports the same number of %s."), Seed,
+                                          *Class.Key.ToString()), PlacedTransforms.Num(), SpawnedTransforms.Num());
+                for (int32 i = 0; i < PlacedTransforms.Num() && i < SpawnedTransforms.Num(); i++)
+                {
+                    TestTrue(FString::Printf(TEXT("Seed %i exports object %i at the same transform."), Seed, i),
+                             PlacedTransforms[i].Equals(SpawnedTransforms[i], 0.01f));
+                }
+            }
+        }
+    }
+
+    int32 CountActors() const
+    {
+        int32 Count = 0;
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            Count++;
+        }
+        return Count;
+    }
+END_DEFINE_SPEC(SpawnerBaseSpec)
+
+void SpawnerBaseSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        PropClass = FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C").TryLoadClass<AActor>();
+        TestNotNull("Check if the prop class is loaded", PropClass);
+
+        FActorSpawnParameters SurfaceParams;
+        SurfaceParams.Name = FName("ExportSurface");
+        AStaticMeshActor* Surface = World->SpawnActor<AStaticMeshActor>(
+            AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector::ZeroVector,
+                                                        FVector(20, 20, 1)), SurfaceParams);
+        Surface->GetStaticMeshComponent()->SetStaticMesh(
+            LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'")));
+
+        Spawner = World->SpawnActor<ASpawnOnSurface>();
+        Spawner->SurfaceNamePattern = "ExportSurface";
+        Spawner->ActorsToSpawn.Add(PropClass);
+        Spawner->DensityMin = 0.5f;
+        Spawner->DensityMax = 0.5f;
+        Spawner->SpawnBudgetMilliseconds = 0.f;
+    });
+
+    Describe("GenerateSpawnedObjectConfiguration()", [this]()
+    {
+        It("exports the objects that spawning finds when they all face the same way", [this]()
+        {
+            Spawner->bRestrictToOneRotation = true;
+            Spawner->RotationMin = 0.f;
+
+            TestSameExports(5);
+        });
+
+        It("exports the objects that spawning finds when they are rotated", [this]()
+        {
+            Spawner->RotationMin = 0.f;
+            Spawner->RotationMax = 360.f;
+
+            TestSameExports(5);
+        });
+
+        It("exports the objects that spawning finds when overlaps are kept", [this]()
+        {
+            Spawner->bRemoveOverlaps = false;
+
+            TestSameExports(2);
+        });
+
+        It("exports the objects that spawning finds when they are drawn as instances", [this]()
+        {
+            Spawner->OutputMode = ESpawnerOutputMode::InstancedStaticMeshes;
+
+            TestSameExports(2);
+        });
+
+        It("exports the objects that spawning finds when a static mesh blocks part of the surface", [this]()
+        {
+            AStaticMeshActor* Blocker = World->SpawnActor<AStaticMeshActor>(
+                AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector(0, 0, 200),
+                                                            FVector(6, 6, 4)));
+            Blocker->GetStaticMeshComponent()->SetStaticMesh(
+                LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'")));
+            const FBox BlockedArea = Blocker->GetComponentsBoundingBox();
+
+            TestSameExports(2);
+
+            const FPlacementBuffer Placed = Export(0, true);
+            TestTrue("Objects are exported", Placed.Num() > 0);
+            for (const TPair<FName, FPlacementBuffer::FPlacements>& Class : Placed.GetClasses())
+            {
+                for (const FTransform& Transform : Class.Value.GetTransforms())
+                {
+                    TestFalse("No object is exported inside the static mesh",
+                              BlockedArea.IsInsideXY(Transform.GetLocation()));
+                }
+            }
+        });
+
+        It("spawns without turning on the overlap events of the actors in the level", [this]()
+        {
+            AStaticMeshActor* Blocker = World->SpawnActor<AStaticMeshActor>(
+                AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector(0, 0, 200),
+                                                            FVector(6, 6, 4)));
+            UStaticMeshComponent* BlockerMesh = Blocker->GetStaticMeshComponent();
+            BlockerMesh->SetStaticMesh(
+                LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'")));
+            BlockerMesh->SetGenerateOverlapEvents(false);
+            const FBox BlockedArea = Blocker->GetComponentsBoundingBox();
+
+            // Checked as each actor is spawned, since a setting that is restored afterwards looks unchanged.
+            bool bTurnedOn = false;
+            const FDelegateHandle Handle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda(
+                [BlockerMesh, &bTurnedOn](AActor*)
+                {
+                    bTurnedOn |= BlockerMesh->GetGenerateOverlapEvents();
+                }));
+            const FPlacementBuffer Spawned = Export(0, false);
+            World->RemoveOnActorSpawnedHandler(Handle);
+
+            TestTrue("Objects are spawned", Spawned.Num() > 0);
+            TestFalse("Overlap events are never turned on", bTurnedOn || BlockerMesh->GetGenerateOverlapEvents());
+            for (const TPair<FName, FPlacementBuffer::FPlacements>& Class : Spawned.GetClasses())
+            {
+                for (const FTransform& Transform : Class.Value.GetTransforms())
+                {
+                    TestFalse("No object is spawned inside the static mesh",
+                              BlockedArea.IsInsideXY(Transform.GetLocation()));
+                }
+            }
+        });
+
+        It("adds no actors to the world when exporting without spawning", [this]()
+        {
+            const int32 ActorsBefore = CountActors();
+            const FPlacementBuffer Placed = Export(0, true);
+
+            TestTrue("Objects are exported", Placed.Num() > 0);
+            TestEqual("No actors are added", CountActors(), ActorsBefore);
+        });
+    });
+}
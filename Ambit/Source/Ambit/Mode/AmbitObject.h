@@ -131,6 +131,13 @@ public:
     UPROPERTY(VisibleAnywhere, Category = "Permutation Settings")
     int NumberOfPermutations = 1;
 
+    /**
+     * Cell size in cm of the surface height field that spawners snap to while exporting.
+     * Set to 0 to trace every placement against the world instead.
+     */
+    UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Permutation Settings", meta = (ClampMin = "0"))
+    float SurfaceCacheCellSize = 50.f;
+
     /**
      * Platforms to export the map to
      */
@@ -43,6 +43,21 @@ TSharedPtr<FJsonObject> FBulkScenarioConfiguration::SerializeToJson() const
     return JsonObject;
 }
 
+void FBulkScenarioConfiguration::WriteFieldsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const
+{
+    Writer->WriteValue(JsonConstants::KVersionKey, KCurrentVersion);
+    Writer->WriteValue(JsonConstants::KConfigurationNameKey, this->ConfigurationName);
+    Writer->WriteValue(JsonConstants::KBatchNameKey, this->BatchName);
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KTimeOfDayTypesKey, this->TimeOfDayTypes.SerializeToJson());
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KWeatherTypesKey, this->WeatherTypes.SerializeToJson());
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KBatchPedestrianDensityKey,
+                              this->PedestrianDensity.SerializeToJson());
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KBatchTrafficDensityKey, this->VehicleDensity.SerializeToJson());
+    // Widened to double to print as the FJsonValueNumber field of SerializeToJson does.
+    Writer->WriteValue(JsonConstants::KNumberOfPermutationsKey, static_cast<double>(this->NumberOfPermutations));
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KAllSpawnersConfigsKey, this->AllSpawnersConfigs);
+}
+
 /**
  *Deserialize the BSC Json object into Unreal engine editor
  */
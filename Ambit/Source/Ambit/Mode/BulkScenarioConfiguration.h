@@ -22,6 +22,7 @@
 #include "WeatherTypes.h"
 
 #include <AmbitUtils/ConfigJsonSerializer.h>
+#include <AmbitUtils/JsonHelpers.h>
 
 struct FScenarioDefinition;
 class FJsonObject;
@@ -46,6 +47,11 @@ struct FBulkScenarioConfiguration : public FConfigJsonSerializer
 
     TSharedPtr<FJsonObject> SerializeToJson() const override;
 
+    /**
+     * Writes the fields of SerializeToJson, in the same order, into the object that is open on Writer.
+     */
+    void WriteFieldsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const;
+
     void DeserializeFromJson(TSharedPtr<FJsonObject> JsonObject) override;
 
     /**
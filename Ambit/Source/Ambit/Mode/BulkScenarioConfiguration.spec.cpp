@@ -101,6 +101,27 @@ void BulkScenarioConfigurationSpec::Define()
         });
     });
 
+    Describe("WriteFieldsToJson()", [this]()
+    {
+        It("writes the same document as SerializeToJson", [this]()
+        {
+            BulkConfig = FBulkScenarioConfiguration{};
+            BulkConfig.ConfigurationName = "TestConfigurationName";
+            BulkConfig.BatchName = "TestBatchName";
+            BulkConfig.TimeOfDayTypes.SetMorning(true);
+            BulkConfig.NumberOfPermutations = 3;
+            BulkConfig.AllSpawnersConfigs = FJsonHelpers::DeserializeJson("{\"SpawnerOnSurface\": [{\"Seed\": 1.5}]}");
+
+            const FString Streamed = FJsonHelpers::WriteJson(
+                [this](const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+                {
+                    BulkConfig.WriteFieldsToJson(Writer);
+                });
+
+            TestEqual("Streamed Json", Streamed, FJsonHelpers::SerializeJson(BulkConfig.SerializeToJson()));
+        });
+    });
+
     Describe("DeserializeFromJson()", [this]()
     {
         BeforeEach([this]()
@@ -45,7 +45,10 @@
 #include "Ambit/Actors/Spawners/SpawnVehiclePath.h"
 #include "Ambit/Actors/Spawners/SpawnWithHoudini.h"
 #include "Ambit/Mode/GltfExportInterface.h"
+#include "Ambit/Utils/AmbitActorPoolSubsystem.h"
 #include "Ambit/Utils/AmbitFileHelpers.h"
+#include "Ambit/Utils/AmbitSurfaceHeightField.h"
+#include "Ambit/Utils/AmbitWorldSnapshot.h"
 #include "Ambit/Utils/AWSWrapper.h"
 #include "Ambit/Utils/UserMetricsSubsystem.h"
 
@@ -69,6 +72,18 @@ static TFunction<TSet<FString>()> LambdaS3ListBuckets = AWSWrapper::ListBuckets;
 static TFunction<void(const FString& Region, const FString& BucketName)> LambdaS3CreateBucket =
         AWSWrapper::CreateBucketWithEncryption;
 
+// Destroys the actors that spawners kept for reuse, once nothing will reuse them.
+static void EmptyActorPool(UWorld* World)
+{
+    UAmbitActorPoolSubsystem* ActorPool = World != nullptr
+                                              ? World->GetSubsystem<UAmbitActorPoolSubsystem>()
+                                              : nullptr;
+    if (ActorPool != nullptr)
+    {
+        ActorPool->Trim();
+    }
+}
+
 //Constructor
 UConfigImportExport::UConfigImportExport()
 {
@@ -132,6 +147,8 @@ FReply UConfigImportExport::OnImportSdf()
 
 FReply UConfigImportExport::OnExportSdf()
 {
+    BeginSurfaceCache();
+    BeginWorldSnapshot();
     PrepareAllSpawnersObjectConfigs(false);
 
     GEngine->GetEngineSubsystem<UUserMetricsSubsystem>()->Track(UserMetrics::AmbitMode::KAmbitModeExportSDF,
@@ -142,6 +159,18 @@ FReply UConfigImportExport::OnExportSdf()
 
 bool UConfigImportExport::ProcessSdfForExport(const TMap<FString, TSharedPtr<FJsonObject>>& AmbitSpawnerArray,
                                               bool bToS3)
+{
+    return StreamSdfForExport([&AmbitSpawnerArray](const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+    {
+        for (const auto& SpawnerKeyValue : AmbitSpawnerArray)
+        {
+            FJsonHelpers::WriteObject(Writer, SpawnerKeyValue.Key, SpawnerKeyValue.Value);
+        }
+    }, bToS3);
+}
+
+bool UConfigImportExport::StreamSdfForExport(
+    TFunctionRef<void(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>&)> WriteSpawnerConfigurations, bool bToS3)
 {
     FAmbitMode* AmbitMode = FAmbitMode::GetEditorMode();
     check(AmbitMode);
@@ -164,16 +193,16 @@ bool UConfigImportExport::ProcessSdfForExport(const TMap<FString, TSharedPtr<FJs
         SerializeSpawnerConfigs<ASpawnVehiclePath, FSpawnVehiclePathConfig>(
             ScenarioToProcess->AllSpawnersConfigs, JsonConstants::KSpawnerVehiclePathKey);
 
-        const TSharedPtr<FJsonObject> JsonObject = ScenarioToProcess->SerializeToJson();
-
-        for (const auto& SpawnerKeyValue : AmbitSpawnerArray)
-        {
-            JsonObject->SetObjectField(SpawnerKeyValue.Key, SpawnerKeyValue.Value);
-        }
+        const FString OutputString = FJsonHelpers::WriteJson(
+            [&ScenarioToProcess, WriteSpawnerConfigurations](const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+            {
+                ScenarioToProcess->WriteFieldsToJson(Writer);
+                WriteSpawnerConfigurations(Writer);
+            });
 
         const FString Name = ScenarioToProcess->ScenarioName;
 
-        bWriteSuccess = WriteJsonFile(JsonObject, Name, FileExtensions::KSDFExtension, bToS3);
+        bWriteSuccess = WriteJsonString(OutputString, Name, FileExtensions::KSDFExtension, bToS3);
     }
 
     // Once we have finished, we cycle to the next item in the queue for its SDF creation.
@@ -183,12 +212,19 @@ bool UConfigImportExport::ProcessSdfForExport(const TMap<FString, TSharedPtr<FJs
     }
     else if (bToS3)
     {
+        AmbitSurfaceHeightFieldCache::EndExport();
+        AmbitWorldSnapshot::EndExport();
+        EmptyActorPool(GEngine->GetWorldContexts()[0].World());
+
         const FText NotificationText = NSLOCTEXT("Ambit", "ScenariosUploadComplete",
                                                  "Scenarios successfully uploaded to Amazon S3.");
         FAmbitModule::CreateAmbitNotification(NotificationText);
     }
     else
     {
+        AmbitSurfaceHeightFieldCache::EndExport();
+        AmbitWorldSnapshot::EndExport();
+        EmptyActorPool(GEngine->GetWorldContexts()[0].World());
         SdfProcessDone.ExecuteIfBound();
     }
 
@@ -266,6 +302,8 @@ FReply UConfigImportExport::OnGeneratePermutations()
     BscScenario.VehicleDensity = AmbitMode->UISettings->BulkVehicleTraffic;
     BscScenario.NumberOfPermutations = AmbitMode->UISettings->NumberOfPermutations;
 
+    // Every permutation reads the same snapshot, starting with the spawner configurations below.
+    BeginWorldSnapshot();
     BscScenario.AllSpawnersConfigs = MakeShareable(new FJsonObject);
     SerializeSpawnerConfigs<ASpawnOnSurface, FSpawnerBaseConfig>(BscScenario.AllSpawnersConfigs,
                                                                  JsonConstants::KSpawnerSurfaceKey);
@@ -278,14 +316,19 @@ FReply UConfigImportExport::OnGeneratePermutations()
     SerializeSpawnerConfigs<ASpawnVehiclePath, FSpawnVehiclePathConfig>(BscScenario.AllSpawnersConfigs,
                                                                         JsonConstants::KSpawnerVehiclePathKey);
 
-    // Serialize the whole object into Json format
-    TSharedPtr<FJsonObject> JsonObject = BscScenario.SerializeToJson();
+    // Write the whole configuration out in Json format
+    const FString OutputString = FJsonHelpers::WriteJson([&BscScenario](
+        const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+        {
+            BscScenario.WriteFieldsToJson(Writer);
+        });
 
     FString BucketName = AmbitMode->UISettings->S3BucketName;
 
-    const bool BscWroteSuccess = WriteJsonFile(JsonObject, Name, FileExtensions::KBSCExtension, true);
+    const bool BscWroteSuccess = WriteJsonString(OutputString, Name, FileExtensions::KBSCExtension, true);
     if (!BscWroteSuccess)
     {
+        AmbitWorldSnapshot::EndExport();
         return FReply::Handled();
     }
 
@@ -326,6 +369,7 @@ FReply UConfigImportExport::OnGeneratePermutations()
     }
 
     // Start the process for SDF output
+    BeginSurfaceCache();
     PrepareAllSpawnersObjectConfigs(true);
 
     return FReply::Handled();
@@ -579,6 +623,9 @@ FReply UConfigImportExport::OnExportGltf()
     const FString OutputDir = FPaths::Combine(*FPaths::ProjectDir(), TEXT("Saved"), TEXT("Cooked"), FolderName);
     const FString FilePath = FPaths::Combine(OutputDir, Filename);
 
+    // Hidden actors waiting for reuse are not part of the map.
+    EmptyActorPool(CurrentWorldContext);
+
     // Perform the export to glTF.
     const bool IsExportSuccess = GltfExporter->Export(CurrentWorldContext, FilePath);
     if (!IsExportSuccess)
@@ -604,12 +651,57 @@ FReply UConfigImportExport::OnExportGltf()
     return FReply::Handled();
 }
 
+void UConfigImportExport::BeginSurfaceCache()
+{
+    const FAmbitMode* AmbitMode = FAmbitMode::GetEditorMode();
+    const float CellSize = AmbitMode != nullptr ? AmbitMode->UISettings->SurfaceCacheCellSize : 0.f;
+    AmbitSurfaceHeightFieldCache::BeginExport(CellSize);
+}
+
+void UConfigImportExport::BeginWorldSnapshot()
+{
+    UWorld* World = GEngine->GetWorldContexts()[0].World();
+    TArray<AActor*> Spawners;
+    // Further reading: https://exiin.com/blog/unreal-c-interface-and-what-to-do-with-it/
+    UGameplayStatics::GetAllActorsWithInterface(World, UAmbitSpawner::StaticClass(), Spawners);
+
+    TArray<FAmbitSurfaceQuery> SurfaceQueries;
+    for (const AActor* Actor : Spawners)
+    {
+        if (const ASpawnerBase* Spawner = Cast<ASpawnerBase>(Actor))
+        {
+            SurfaceQueries.Add({Spawner->MatchBy, Spawner->SurfaceNamePattern, Spawner->SurfaceTags});
+        }
+        else if (const ASpawnWithHoudini* HoudiniSpawner = Cast<ASpawnWithHoudini>(Actor))
+        {
+            SurfaceQueries.Add({HoudiniSpawner->MatchBy, HoudiniSpawner->SurfaceNamePattern,
+                                HoudiniSpawner->SurfaceTags});
+        }
+    }
+    AmbitWorldSnapshot::BeginExport(World, Spawners, SurfaceQueries);
+}
+
 void UConfigImportExport::PrepareAllSpawnersObjectConfigs(bool bToS3)
 {
+    // Permutations reuse the snapshot the export started with, unless the world has changed since.
+    TSharedPtr<const FAmbitWorldSnapshot> Snapshot = AmbitWorldSnapshot::Get();
+    if (Snapshot.IsValid() && !Snapshot->IsUpToDate())
+    {
+        UE_LOG(LogAmbit, Display, TEXT("The world has changed during the export, so it is read again."));
+        BeginWorldSnapshot();
+        Snapshot = AmbitWorldSnapshot::Get();
+    }
+
     TArray<AActor*> AllActorsToSerialize;
-    // Further reading: https://exiin.com/blog/unreal-c-interface-and-what-to-do-with-it/
-    UGameplayStatics::GetAllActorsWithInterface(GEngine->GetWorldContexts()[0].World(), UAmbitSpawner::StaticClass(),
-                                                AllActorsToSerialize);
+    if (Snapshot.IsValid())
+    {
+        AllActorsToSerialize = Snapshot->GetSpawners();
+    }
+    else
+    {
+        UGameplayStatics::GetAllActorsWithInterface(GEngine->GetWorldContexts()[0].World(),
+                                                    UAmbitSpawner::StaticClass(), AllActorsToSerialize);
+    }
 
     TArray<AActor*> ValidActors = AllActorsToSerialize.FilterByPredicate([](AActor* Actor)
     {
@@ -625,6 +717,8 @@ void UConfigImportExport::PrepareAllSpawnersObjectConfigs(bool bToS3)
     }
 
     UAmbitExporterDelegateWatcher* ConfigurationDelegateWatcher = NewObject<UAmbitExporterDelegateWatcher>();
+    // Spawners may take several frames to respond, and only hold the watcher weakly.
+    ConfigurationDelegateWatcher->AddToRoot();
     ConfigurationDelegateWatcher->SpawnerCount = ValidActors.Num();
     ConfigurationDelegateWatcher->bSendToS3 = bToS3;
     ConfigurationDelegateWatcher->Parent = this;
@@ -700,7 +794,16 @@ void UConfigImportExport::SerializeSpawnerConfigs(TSharedPtr<FJsonObject>& Spawn
 {
     TArray<TSharedPtr<FJsonValue>> SpawnerTypeSpecificArray;
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GEngine->GetWorldContexts()[0].World(), ClassType::StaticClass(), AllActors);
+    const TSharedPtr<const FAmbitWorldSnapshot> Snapshot = AmbitWorldSnapshot::Get();
+    if (Snapshot.IsValid())
+    {
+        AllActors = Snapshot->GetSpawners(ClassType::StaticClass());
+    }
+    else
+    {
+        UGameplayStatics::GetAllActorsOfClass(GEngine->GetWorldContexts()[0].World(), ClassType::StaticClass(),
+                                              AllActors);
+    }
     // Get each AmbitSpawner's configuration and add to AmbitSpawnerArray
     for (AActor* Actor : AllActors)
     {
@@ -749,9 +852,13 @@ TSharedPtr<FScenarioDefinition> UConfigImportExport::DequeueOrDefaultNextSdfConf
 bool UConfigImportExport::WriteJsonFile(const TSharedPtr<FJsonObject>& OutputContents, const FString& FileName,
                                         const FString& FileExtension, bool bToS3)
 {
-    const FAmbitMode* AmbitMode = FAmbitMode::GetEditorMode();
+    return WriteJsonString(FJsonHelpers::SerializeJson(OutputContents), FileName, FileExtension, bToS3);
+}
 
-    const FString& OutputString = FJsonHelpers::SerializeJson(OutputContents);
+bool UConfigImportExport::WriteJsonString(const FString& OutputString, const FString& FileName,
+                                          const FString& FileExtension, bool bToS3)
+{
+    const FAmbitMode* AmbitMode = FAmbitMode::GetEditorMode();
 
     if (OutputString.IsEmpty() || FileName.IsEmpty() || FileExtension.IsEmpty())
     {
@@ -883,43 +990,94 @@ void UAmbitExporterDelegateWatcher::SpawnedObjectConfigCompleted_Handler(
         UE_LOG(LogAmbit, Error, TEXT("One of the SDF configurations have failed to generate properly"));
 
         AllSpawnerConfiguration.Empty();
+        CompletedConfigs.Empty();
+        RemoveFromRoot();
         return;
     }
 
-    const TSharedPtr<FJsonObject> SerializedJsonObject = Config->SerializeToJson();
+    // Configurations are kept as they are and only serialized once every spawner has responded,
+    // so that their spawned objects can be streamed straight into the SDF.
+    AllSpawnerConfiguration.FindOrAdd(Config->GetOutputConfigurationName()).Add(Config);
+    CompletedConfigs.Add(Config.GetObject());
 
-    const FString ConfigName = Config->GetOutputConfigurationName();
+    CurrentCompleted++;
 
-    if (!AllSpawnerConfiguration.Contains(ConfigName))
+    if (SpawnerCount == CurrentCompleted)
     {
-        AllSpawnerConfiguration.Add(ConfigName, SerializedJsonObject);
+        Parent->StreamSdfForExport([this](const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer)
+        {
+            WriteSpawnerConfigurations(Writer);
+        }, bSendToS3);
+        AllSpawnerConfiguration.Empty();
+        CompletedConfigs.Empty();
+        RemoveFromRoot();
     }
-    else
+}
+
+void UAmbitExporterDelegateWatcher::WriteSpawnerConfigurations(
+    const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const
+{
+    for (const TPair<FString, TArray<TScriptInterface<IConfigJsonSerializer>>>& Pair : AllSpawnerConfiguration)
     {
-        const TSharedPtr<FJsonObject> OldSpawnerObjects = AllSpawnerConfiguration[ConfigName];
-        TArray<TSharedPtr<FJsonValue>> OldSpawnerObjectsJsonArray;
-        if (OldSpawnerObjects->HasField(JsonConstants::KAmbitSpawnerObjectsKey))
+        const TArray<TScriptInterface<IConfigJsonSerializer>>& Configs = Pair.Value;
+
+        TArray<const USpawnedObjectConfig*> SpawnedObjectConfigs;
+        for (const TScriptInterface<IConfigJsonSerializer>& Config : Configs)
         {
-            OldSpawnerObjectsJsonArray = OldSpawnerObjects->GetArrayField(JsonConstants::KAmbitSpawnerObjectsKey);
+            const USpawnedObjectConfig* SpawnedObjectConfig = Cast<USpawnedObjectConfig>(Config.GetObject());
+            if (SpawnedObjectConfig == nullptr)
+            {
+                break;
+            }
+            SpawnedObjectConfigs.Add(SpawnedObjectConfig);
         }
 
-        TArray<TSharedPtr<FJsonValue>> NewSpawnerObjectsJsonArray;
-        if (SerializedJsonObject->HasField(JsonConstants::KAmbitSpawnerObjectsKey))
+        if (SpawnedObjectConfigs.Num() != Configs.Num())
+        {
+            FJsonHelpers::WriteObject(Writer, Pair.Key, MergeSpawnerConfigurations(Configs));
+            continue;
+        }
+
+        // A lone configuration without objects serializes to an empty object, while merged
+        // configurations always carry the spawned objects array.
+        Writer->WriteObjectStart(Pair.Key);
+        if (SpawnedObjectConfigs.Num() > 1 || SpawnedObjectConfigs[0]->SpawnedObjects.Num() > 0)
         {
-            NewSpawnerObjectsJsonArray = SerializedJsonObject->GetArrayField(JsonConstants::KAmbitSpawnerObjectsKey);
+            Writer->WriteArrayStart(JsonConstants::KAmbitSpawnerObjectsKey);
+            for (const USpawnedObjectConfig* SpawnedObjectConfig : SpawnedObjectConfigs)
+            {
+                SpawnedObjectConfig->WriteSpawnedObjectsToJson(Writer);
+            }
+            Writer->WriteArrayEnd();
         }
-        OldSpawnerObjectsJsonArray.Append(NewSpawnerObjectsJsonArray);
-        OldSpawnerObjects->SetArrayField(JsonConstants::KAmbitSpawnerObjectsKey, OldSpawnerObjectsJsonArray);
-        AllSpawnerConfiguration[ConfigName] = OldSpawnerObjects;
+        Writer->WriteObjectEnd();
     }
+}
 
-    CurrentCompleted++;
+TSharedPtr<FJsonObject> UAmbitExporterDelegateWatcher::MergeSpawnerConfigurations(
+    const TArray<TScriptInterface<IConfigJsonSerializer>>& Configs)
+{
+    const TSharedPtr<FJsonObject> MergedSpawnerObjects = Configs[0]->SerializeToJson();
+    if (Configs.Num() == 1)
+    {
+        return MergedSpawnerObjects;
+    }
 
-    if (SpawnerCount == CurrentCompleted)
+    TArray<TSharedPtr<FJsonValue>> MergedSpawnerObjectsJsonArray;
+    for (int32 i = 0; i < Configs.Num(); i++)
     {
-        Parent->ProcessSdfForExport(AllSpawnerConfiguration, bSendToS3);
-        AllSpawnerConfiguration.Empty();
+        const TSharedPtr<FJsonObject> SerializedJsonObject = i == 0
+                                                                 ? MergedSpawnerObjects
+                                                                 : Configs[i]->SerializeToJson();
+        if (SerializedJsonObject->HasField(JsonConstants::KAmbitSpawnerObjectsKey))
+        {
+            MergedSpawnerObjectsJsonArray.Append(
+                SerializedJsonObject->GetArrayField(JsonConstants::KAmbitSpawnerObjectsKey));
+        }
     }
+    MergedSpawnerObjects->SetArrayField(JsonConstants::KAmbitSpawnerObjectsKey, MergedSpawnerObjectsJsonArray);
+
+    return MergedSpawnerObjects;
 }
 
 void UConfigImportExport::SetDependencies(IGltfExportInterface* Exporter)
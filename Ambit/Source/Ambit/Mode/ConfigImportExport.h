@@ -53,6 +53,20 @@ public:
     /** @inheritDoc */
     bool ProcessSdfForExport(const TMap<FString, TSharedPtr<FJsonObject>>& AmbitSpawnerArray, bool bToS3);
 
+    /**
+     * Streaming form of ProcessSdfForExport(). The SDF is written field by field instead of through
+     * an FJsonObject, which keeps large spawned object lists from being copied into a DOM first.
+     *
+     * @param WriteSpawnerConfigurations Writes one named field per output configuration into the root SDF
+     * object, after the scenario fields.
+     * @param bToS3 Specifies whether the file should be uploaded to Amazon S3 or saved to disk.
+     *
+     * @return True if the SDF was successfully written. False otherwise.
+     */
+    bool StreamSdfForExport(
+        TFunctionRef<void(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>&)> WriteSpawnerConfigurations,
+        bool bToS3);
+
     /** @inheritDoc */
     FReply OnImportBsc();
 
@@ -183,6 +197,18 @@ private:
      */
     void PrepareAllSpawnersObjectConfigs(bool bToS3);
 
+    /**
+     * Starts caching surface height fields for the export that is about to run,
+     * using the cell size from the Ambit UI settings.
+     */
+    void BeginSurfaceCache();
+
+    /**
+     * Takes the snapshot of the world that the export about to run reads, so that the spawners
+     * and their surfaces are found once instead of for every spawner and permutation.
+     */
+    void BeginWorldSnapshot();
+
     /**
      * Given a JSON object describing a Bulk Scenario Configuration, this method recreates
      * the Ambit Spawners described by that JSON.
@@ -232,6 +258,14 @@ private:
     bool WriteJsonFile(const TSharedPtr<FJsonObject>& OutputContents, const FString& FileName,
                        const FString& FileExtension, bool bToS3);
 
+    /**
+     * Writes already serialized Json with the FileName and FileExtension to either Amazon S3 or to disk.
+     *
+     * @see WriteJsonFile()
+     */
+    bool WriteJsonString(const FString& OutputString, const FString& FileName, const FString& FileExtension,
+                         bool bToS3);
+
     // AWS Helpers
     /**
      * Retrieves the user defined AWS Bucket and Region. Will attempt to create a bucket if
@@ -325,13 +359,32 @@ public:
                                               bool bSuccess);
 
 private:
+    /**
+     * Writes each output configuration as a named field of the object that is open on Writer.
+     * Configurations that share an output configuration name have their spawned objects merged into one array.
+     */
+    void WriteSpawnerConfigurations(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const;
+
+    /**
+     * Builds the merged JSON object for configurations that cannot be streamed.
+     */
+    static TSharedPtr<FJsonObject> MergeSpawnerConfigurations(
+        const TArray<TScriptInterface<IConfigJsonSerializer>>& Configs);
+
     /**
      * The current number of spawners that have completed their response.
      */
     int CurrentCompleted;
 
     /**
-     * An internal mapping of the output configuration name for the JSON object, and a list of the output JSON results.
+     * An internal mapping of the output configuration name for the JSON object, and the configurations
+     * that are written under it, in the order they completed.
+     */
+    TMap<FString, TArray<TScriptInterface<IConfigJsonSerializer>>> AllSpawnerConfiguration;
+
+    /**
+     * Keeps the configurations in AllSpawnerConfiguration alive until they are written.
      */
-    TMap<FString, TSharedPtr<FJsonObject>> AllSpawnerConfiguration;
+    UPROPERTY()
+    TArray<UObject*> CompletedConfigs;
 };
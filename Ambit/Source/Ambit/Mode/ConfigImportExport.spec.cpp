@@ -749,7 +749,7 @@ void ConfigImportExportSpec::Define()
                     TArray<FTransform> TransformArray;
                     const FTransform CurrentTransform = Spawner->GetTransform();
                     TransformArray.Add(CurrentTransform);
-                    Config->SpawnedObjects.Add("Test", TransformArray);
+                    Config->SpawnedObjects.Append("Test", TransformArray);
 
                     auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
 
@@ -892,7 +892,7 @@ void ConfigImportExportSpec::Define()
                         TArray<FTransform> TransformArray;
                         const FTransform CurrentTransform = Spawner->GetTransform();
                         TransformArray.Add(CurrentTransform);
-                        Config->SpawnedObjects.Add("Test", TransformArray);
+                        Config->SpawnedObjects.Append("Test", TransformArray);
 
                         auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
 
@@ -939,7 +939,7 @@ void ConfigImportExportSpec::Define()
                         TArray<FTransform> TransformArray;
                         const FTransform CurrentTransform = Spawner->GetTransform();
                         TransformArray.Add(CurrentTransform);
-                        Config->SpawnedObjects.Add("Test", TransformArray);
+                        Config->SpawnedObjects.Append("Test", TransformArray);
 
                         auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
 
@@ -956,7 +956,7 @@ void ConfigImportExportSpec::Define()
                         TArray<FTransform> TransformArray;
                         const FTransform CurrentTransform = Spawner2->GetTransform();
                         TransformArray.Add(CurrentTransform);
-                        Config->SpawnedObjects.Add("Test2", TransformArray);
+                        Config->SpawnedObjects.Append("Test2", TransformArray);
 
                         auto FinalConfig = TScriptInterface<IConfigJsonSerializer>(Config);
 
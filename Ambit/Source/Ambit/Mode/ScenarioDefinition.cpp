@@ -40,6 +40,19 @@ TSharedPtr<FJsonObject> FScenarioDefinition::SerializeToJson() const
     return JsonObject;
 }
 
+void FScenarioDefinition::WriteFieldsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const
+{
+    // Numbers are widened to double to print as the FJsonValueNumber fields of SerializeToJson do.
+    Writer->WriteValue(JsonConstants::KVersionKey, KCurrentVersion);
+    Writer->WriteValue(JsonConstants::KScenarioNameKey, this->ScenarioName);
+    Writer->WriteValue(JsonConstants::KTimeOfDayKey, static_cast<double>(this->TimeOfDay));
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KWeatherParametersKey,
+                              FJsonObjectConverter::UStructToJsonObject(this->AmbitWeatherParameters));
+    Writer->WriteValue(JsonConstants::KPedestrianDensityKey, static_cast<double>(this->PedestrianDensity));
+    Writer->WriteValue(JsonConstants::KTrafficDensityKey, static_cast<double>(this->VehicleDensity));
+    FJsonHelpers::WriteObject(Writer, JsonConstants::KAllSpawnersConfigsKey, this->AllSpawnersConfigs);
+}
+
 void FScenarioDefinition::DeserializeFromJson(TSharedPtr<FJsonObject> JsonObject)
 {
     FString Warnings;
@@ -17,6 +17,7 @@
 #include "AmbitWeatherParameters.h"
 
 #include <AmbitUtils/ConfigJsonSerializer.h>
+#include <AmbitUtils/JsonHelpers.h>
 
 class FJsonObject;
 
@@ -40,5 +41,10 @@ struct FScenarioDefinition : public FConfigJsonSerializer
 
     TSharedPtr<FJsonObject> SerializeToJson() const override;
 
+    /**
+     * Writes the fields of SerializeToJson, in the same order, into the object that is open on Writer.
+     */
+    void WriteFieldsToJson(const TSharedRef<FJsonHelpers::FPrettyJsonWriter>& Writer) const;
+
     void DeserializeFromJson(TSharedPtr<FJsonObject> JsonObject) override;
 };
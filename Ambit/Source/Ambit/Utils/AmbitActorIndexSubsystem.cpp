@@ -0,0 +1,393 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitActorIndexSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "Ambit/Utils/AmbitActorPoolSubsystem.h"
+#include "Ambit/Utils/AmbitWorldHelpers.h"
+
+void UAmbitActorIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UWorld* World = GetWorld();
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &UAmbitActorIndexSubsystem::OnActorSpawned));
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UAmbitActorIndexSubsystem::OnLevelsChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(
+        this, &UAmbitActorIndexSubsystem::OnLevelsChanged);
+
+#if WITH_EDITOR
+    if (GEngine != nullptr)
+    {
+        // Actors pasted or duplicated in the editor are not always spawned.
+        ActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UAmbitActorIndexSubsystem::OnActorSpawned);
+        ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this,
+                                                                       &UAmbitActorIndexSubsystem::OnActorDeleted);
+    }
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddUObject(
+        this, &UAmbitActorIndexSubsystem::NotifyActorChanged);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+        this, &UAmbitActorIndexSubsystem::OnObjectPropertyChanged);
+#endif
+}
+
+void UAmbitActorIndexSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+#if WITH_EDITOR
+    if (GEngine != nullptr)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+    }
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+#endif
+
+    Entries.Empty();
+    EntryByActor.Empty();
+    EntriesByTag.Empty();
+    PendingActors.Empty();
+
+    Super::Deinitialize();
+}
+
+TArray<AActor*> UAmbitActorIndexSubsystem::FindActors(const EMatchBy& MatchBy, const FString& NamePattern,
+                                                      const TArray<FName>& TagsList, bool bMatchExactName)
+{
+    Update();
+
+    const bool bNamePatternIsEmpty = NamePattern.IsEmpty();
+    const bool bTagsListIsEmpty = TagsList.Num() == 0;
+
+    TArray<int32> Slots;
+    switch (MatchBy)
+    {
+        case EMatchBy::NameAndTags:
+        {
+            const TArray<int32>* Candidates = FindTagCandidates(TagsList);
+            if (bNamePatternIsEmpty || Candidates == nullptr)
+            {
+                break;
+            }
+            for (const int32 Slot : *Candidates)
+            {
+                AActor* Actor = GetQueryableActor(Slot);
+                if (Actor != nullptr && HasAllTags(Slot, TagsList)
+                    && AmbitWorldHelpers::MatchesNamePattern(Entries[Slot].NameString, NamePattern, bMatchExactName))
+                {
+                    Slots.Add(Slot);
+                }
+            }
+            break;
+        }
+
+        case EMatchBy::NameOrTags:
+        {
+            TBitArray<> Matched(false, Entries.Num());
+            if (!bTagsListIsEmpty)
+            {
+                if (const TArray<int32>* Candidates = FindTagCandidates(TagsList))
+                {
+                    for (const int32 Slot : *Candidates)
+                    {
+                        if (GetQueryableActor(Slot) != nullptr && HasAllTags(Slot, TagsList))
+                        {
+                            Matched[Slot] = true;
+                        }
+                    }
+                }
+            }
+
+            // Names can match anywhere, but scanning the cached names is much
+            // cheaper than building the name of every actor in the world.
+            if (!bNamePatternIsEmpty)
+            {
+                for (int32 Slot = 0; Slot < Entries.Num(); Slot++)
+                {
+                    if (!Matched[Slot] && GetQueryableActor(Slot) != nullptr
+                        && AmbitWorldHelpers::MatchesNamePattern(Entries[Slot].NameString, NamePattern,
+                                                                 bMatchExactName))
+                    {
+                        Matched[Slot] = true;
+                    }
+                }
+            }
+
+            for (TConstSetBitIterator<> It(Matched); It; ++It)
+            {
+                Slots.Add(It.GetIndex());
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    // Candidates from the tag lists are not in index order.
+    Slots.Sort();
+
+    TArray<AActor*> Actors;
+    Actors.Reserve(Slots.Num());
+    for (const int32 Slot : Slots)
+    {
+        Actors.Add(Entries[Slot].Actor.Get());
+    }
+    return Actors;
+}
+
+void UAmbitActorIndexSubsystem::NotifyActorChanged(AActor* Actor)
+{
+    if (Actor != nullptr && Actor->GetWorld() == GetWorld())
+    {
+        PendingActors.Add(Actor);
+        Revision++;
+    }
+}
+
+int32 UAmbitActorIndexSubsystem::Num()
+{
+    Update();
+    return EntryByActor.Num();
+}
+
+void UAmbitActorIndexSubsystem::Update()
+{
+    if (bNeedsRebuild)
+    {
+        Rebuild();
+        return;
+    }
+
+    for (const TWeakObjectPtr<AActor>& Pending : PendingActors)
+    {
+        if (AActor* Actor = Pending.Get())
+        {
+            IndexActor(Actor);
+        }
+    }
+    PendingActors.Reset();
+
+    if (RemovedCount > Entries.Num() / 2)
+    {
+        Compact();
+    }
+}
+
+void UAmbitActorIndexSubsystem::Rebuild()
+{
+    Entries.Reset();
+    EntryByActor.Reset();
+    EntriesByTag.Reset();
+    PendingActors.Reset();
+    RemovedCount = 0;
+    bNeedsRebuild = false;
+
+    // Index hidden levels and pending kill actors too, and filter them at query time,
+    // so that the order matches the order in which a full world scan visits actors.
+    for (TActorIterator<AActor> It(GetWorld(), AActor::StaticClass(), EActorIteratorFlags::AllActors); It; ++It)
+    {
+        IndexActor(*It);
+    }
+}
+
+void UAmbitActorIndexSubsystem::Compact()
+{
+    TArray<FIndexedActor> Remaining;
+    Remaining.Reserve(Entries.Num() - RemovedCount);
+    for (FIndexedActor& Entry : Entries)
+    {
+        if (Entry.Actor.IsValid())
+        {
+            Remaining.Add(MoveTemp(Entry));
+        }
+    }
+    Entries = MoveTemp(Remaining);
+    RemovedCount = 0;
+
+    EntryByActor.Reset();
+    EntriesByTag.Reset();
+    for (int32 Slot = 0; Slot < Entries.Num(); Slot++)
+    {
+        EntryByActor.Add(Entries[Slot].Actor, Slot);
+        for (const FName& Tag : Entries[Slot].Tags)
+        {
+            EntriesByTag.FindOrAdd(Tag).AddUnique(Slot);
+        }
+    }
+}
+
+void UAmbitActorIndexSubsystem::IndexActor(AActor* Actor)
+{
+    int32 Slot;
+    if (const int32* Existing = EntryByActor.Find(Actor))
+    {
+        Slot = *Existing;
+        for (const FName& Tag : Entries[Slot].Tags)
+        {
+            if (TArray<int32>* TagSlots = EntriesByTag.Find(Tag))
+            {
+                TagSlots->RemoveSingleSwap(Slot, false);
+            }
+        }
+    }
+    else
+    {
+        Slot = Entries.AddDefaulted();
+        Entries[Slot].Actor = Actor;
+        EntryByActor.Add(Actor, Slot);
+    }
+
+    FIndexedActor& Entry = Entries[Slot];
+    Entry.Name = Actor->GetFName();
+    Entry.NameString = Actor->GetName();
+    Entry.Tags = Actor->Tags;
+    for (const FName& Tag : Entry.Tags)
+    {
+        EntriesByTag.FindOrAdd(Tag).AddUnique(Slot);
+    }
+}
+
+void UAmbitActorIndexSubsystem::RemoveActor(AActor* Actor)
+{
+    int32 Slot;
+    if (!EntryByActor.RemoveAndCopyValue(Actor, Slot))
+    {
+        return;
+    }
+
+    for (const FName& Tag : Entries[Slot].Tags)
+    {
+        if (TArray<int32>* TagSlots = EntriesByTag.Find(Tag))
+        {
+            TagSlots->RemoveSingleSwap(Slot, false);
+        }
+    }
+    Entries[Slot] = FIndexedActor();
+    RemovedCount++;
+}
+
+AActor* UAmbitActorIndexSubsystem::GetQueryableActor(int32 Slot)
+{
+    FIndexedActor& Entry = Entries[Slot];
+    AActor* Actor = Entry.Actor.Get();
+    if (!IsValid(Actor))
+    {
+        return nullptr;
+    }
+
+    // Same filter as the default actor iterator: only actors in visible levels of this world.
+    const ULevel* Level = Actor->GetLevel();
+    if (Level == nullptr || !Level->bIsVisible || Level->OwningWorld != GetWorld())
+    {
+        return nullptr;
+    }
+
+    // Actors waiting in the actor pool are not part of the level.
+    const UAmbitActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<UAmbitActorPoolSubsystem>();
+    if (ActorPool != nullptr && ActorPool->IsPooled(Actor))
+    {
+        return nullptr;
+    }
+
+    // Objects can be renamed without notice, but not without changing their FName.
+    if (Actor->GetFName() != Entry.Name)
+    {
+        Entry.Name = Actor->GetFName();
+        Entry.NameString = Actor->GetName();
+    }
+    return Actor;
+}
+
+bool UAmbitActorIndexSubsystem::HasAllTags(int32 Slot, const TArray<FName>& TagsList) const
+{
+    for (const FName& Tag : TagsList)
+    {
+        if (!Entries[Slot].Tags.Contains(Tag))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const TArray<int32>* UAmbitActorIndexSubsystem::FindTagCandidates(const TArray<FName>& TagsList) const
+{
+    const TArray<int32>* Smallest = nullptr;
+    for (const FName& Tag : TagsList)
+    {
+        const TArray<int32>* TagSlots = EntriesByTag.Find(Tag);
+        if (TagSlots == nullptr)
+        {
+            // No actor has this tag, so no actor has all of them.
+            return nullptr;
+        }
+        if (Smallest == nullptr || TagSlots->Num() < Smallest->Num())
+        {
+            Smallest = TagSlots;
+        }
+    }
+    return Smallest;
+}
+
+void UAmbitActorIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+    // Tags are usually set after spawning, so the actor is indexed on the next query.
+    NotifyActorChanged(Actor);
+}
+
+void UAmbitActorIndexSubsystem::OnActorDeleted(AActor* Actor)
+{
+    if (Actor != nullptr && Actor->GetWorld() == GetWorld())
+    {
+        RemoveActor(Actor);
+        Revision++;
+    }
+}
+
+void UAmbitActorIndexSubsystem::OnLevelsChanged(ULevel* Level, UWorld* World)
+{
+    if (World == GetWorld())
+    {
+        bNeedsRebuild = true;
+        Revision++;
+    }
+}
+
+#if WITH_EDITOR
+void UAmbitActorIndexSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Tags and names are edited on the actor itself.
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        NotifyActorChanged(Actor);
+    }
+}
+#endif
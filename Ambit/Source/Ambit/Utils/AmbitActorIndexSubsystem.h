@@ -0,0 +1,149 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "MatchBy.h"
+
+#include "AmbitActorIndexSubsystem.generated.h"
+
+/**
+ * Keeps an index of the actors in a world by tag and by name, so that spawners
+ * can find their surfaces without testing every actor in the level.
+ *
+ * The index follows actors as they are spawned, added, deleted, renamed or edited.
+ * Newly spawned actors are indexed on the next query, so tags set right after
+ * spawning are picked up. Code that changes the tags of an actor that has
+ * already been queried should call NotifyActorChanged().
+ */
+UCLASS()
+class AMBIT_API UAmbitActorIndexSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    void Deinitialize() override;
+
+    /**
+     * Returns the actors that match by Name and/or a list of tags, in the same way as
+     * AmbitWorldHelpers::GetActorsByMatchBy() does.
+     *
+     * @param MatchBy
+     *  The rule to match by AND/OR
+     * @param NamePattern
+     *  The name pattern to match on, if any (empty string)
+     * @param TagsList
+     *  The list of tags to match on, if any (empty list)
+     * @param bMatchExactName
+     *  Indicates if the NamePattern has to match exactly to the found actor.
+     * @return
+     *  The matching actors, in the order they were indexed.
+     */
+    TArray<AActor*> FindActors(const EMatchBy& MatchBy, const FString& NamePattern, const TArray<FName>& TagsList,
+                               bool bMatchExactName);
+
+    /**
+     * Re-reads the name and tags of Actor the next time the index is queried.
+     */
+    void NotifyActorChanged(AActor* Actor);
+
+    /**
+     * Returns the number of live actors in the index.
+     */
+    int32 Num();
+
+    /**
+     * Returns a number that changes whenever an actor is spawned, added, deleted, renamed or edited,
+     * or a level is added or removed, so that results kept from earlier queries can be checked.
+     */
+    uint32 GetRevision() const
+    {
+        return Revision;
+    }
+
+private:
+    struct FIndexedActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FName Name;
+        FString NameString;
+        TArray<FName> Tags;
+    };
+
+    // Indexed actors in the order they were added. Removed actors leave an empty slot
+    // until the next compaction, so that the order of the others does not change.
+    TArray<FIndexedActor> Entries;
+
+    TMap<TWeakObjectPtr<AActor>, int32> EntryByActor;
+
+    TMap<FName, TArray<int32>> EntriesByTag;
+
+    // Actors spawned or changed since the last query.
+    TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+    int32 RemovedCount = 0;
+
+    bool bNeedsRebuild = true;
+
+    uint32 Revision = 0;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+#if WITH_EDITOR
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle PropertyChangedHandle;
+#endif
+
+    // Brings the index up to date before a query.
+    void Update();
+
+    // Indexes every actor of the world again, in iteration order.
+    void Rebuild();
+
+    // Removes the empty slots left by removed actors, keeping the order of the others.
+    void Compact();
+
+    // Adds Actor to the index or refreshes its name and tags.
+    void IndexActor(AActor* Actor);
+
+    void RemoveActor(AActor* Actor);
+
+    // Returns the indexed actor in Slot if it can be returned by a query.
+    AActor* GetQueryableActor(int32 Slot);
+
+    // Returns true if the indexed actor in Slot has every tag in TagsList.
+    bool HasAllTags(int32 Slot, const TArray<FName>& TagsList) const;
+
+    // Returns the smallest list of slots that can contain every tag in TagsList.
+    const TArray<int32>* FindTagCandidates(const TArray<FName>& TagsList) const;
+
+    void OnActorSpawned(AActor* Actor);
+
+    void OnActorDeleted(AActor* Actor);
+
+    void OnLevelsChanged(ULevel* Level, UWorld* World);
+
+#if WITH_EDITOR
+    void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+#endif
+};
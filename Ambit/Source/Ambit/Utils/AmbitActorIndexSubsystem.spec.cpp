@@ -0,0 +1,185 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitActorIndexSubsystem.h"
+
+#include "AmbitWorldHelpers.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#include "Ambit/AmbitModule.h"
+
+BEGIN_DEFINE_SPEC(AmbitActorIndexSubsystemSpec, "Ambit.Unit.AmbitActorIndexSubsystem",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UAmbitActorIndexSubsystem* ActorIndex;
+
+    AActor* SpawnNamedActor(const FString& Name, const TArray<FName>& Tags) const
+    {
+        FActorSpawnParameters Params;
+        Params.Name = FName(*Name);
+        AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+        Actor->Tags = Tags;
+        return Actor;
+    }
+
+    // Checks that the index returns the same actors as a scan of the whole world.
+    void TestMatchesScan(const FString& What, const EMatchBy& MatchBy, const FString& NamePattern,
+                         const TArray<FName>& TagsList)
+    {
+        const TArray<AActor*> Scanned = AmbitWorldHelpers::ScanActorsByMatchBy(MatchBy, NamePattern, TagsList);
+        const TArray<AActor*> Indexed = AmbitWorldHelpers::GetActorsByMatchBy(MatchBy, NamePattern, TagsList);
+        TestEqual(What + ": same number of actors", Indexed.Num(), Scanned.Num());
+        TestTrue(What + ": same actors", TSet<AActor*>(Indexed).Difference(TSet<AActor*>(Scanned)).Num() == 0);
+    }
+END_DEFINE_SPEC(AmbitActorIndexSubsystemSpec)
+
+void AmbitActorIndexSubsystemSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        ActorIndex = World->GetSubsystem<UAmbitActorIndexSubsystem>();
+        TestNotNull("Check if the actor index exists", ActorIndex);
+
+        SpawnNamedActor("Road_01", {"Road", "Asphalt"});
+        SpawnNamedActor("Road_02", {"Road"});
+        SpawnNamedActor("Sidewalk_01", {"Sidewalk", "Asphalt"});
+        SpawnNamedActor("Grass_01", {});
+    });
+
+    Describe("FindActors()", [this]()
+    {
+        It("returns the same actors as a world scan", [this]()
+        {
+            for (const EMatchBy MatchBy : {EMatchBy::NameAndTags, EMatchBy::NameOrTags})
+            {
+                const FString Rule = MatchBy == EMatchBy::NameAndTags ? TEXT("AND") : TEXT("OR");
+                TestMatchesScan(Rule + " name only", MatchBy, "Road", {});
+                TestMatchesScan(Rule + " tag only", MatchBy, "", {"Asphalt"});
+                TestMatchesScan(Rule + " name and tag", MatchBy, "road", {"Asphalt"});
+                TestMatchesScan(Rule + " several tags", MatchBy, "Sidewalk", {"Asphalt", "Road"});
+                TestMatchesScan(Rule + " unknown tag", MatchBy, "Grass", {"Water"});
+                TestMatchesScan(Rule + " nothing", MatchBy, "", {});
+            }
+        });
+
+        It("includes tags set right after spawning", [this]()
+        {
+            TestEqual("The road is found.", ActorIndex->FindActors(EMatchBy::NameOrTags, "", {"Road"}, false).Num(),
+                      2);
+
+            AActor* NewRoad = SpawnNamedActor("Road_03", {});
+            NewRoad->Tags.Add("Road");
+            TestEqual("The new road is found.",
+                      ActorIndex->FindActors(EMatchBy::NameOrTags, "", {"Road"}, false).Num(), 3);
+        });
+
+        It("follows tag changes it is notified of", [this]()
+        {
+            AActor* Grass = AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "Grass", {})[0];
+            Grass->Tags.Add("Road");
+            ActorIndex->NotifyActorChanged(Grass);
+            TestMatchesScan("Retagged", EMatchBy::NameOrTags, "", {"Road"});
+        });
+
+        It("forgets destroyed actors", [this]()
+        {
+            AActor* Road = AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "Road_01", {})[0];
+            World->DestroyActor(Road);
+            TestMatchesScan("Destroyed", EMatchBy::NameOrTags, "Road", {"Road"});
+        });
+
+        It("follows renamed actors", [this]()
+        {
+            AActor* Grass = AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "Grass", {})[0];
+            Grass->Rename(TEXT("Meadow_01"));
+            TestMatchesScan("Old name", EMatchBy::NameOrTags, "Grass", {});
+            TestMatchesScan("New name", EMatchBy::NameOrTags, "Meadow", {});
+        });
+    });
+
+    Describe("GetRevision()", [this]()
+    {
+        It("changes when actors are spawned or changed", [this]()
+        {
+            const uint32 Initial = ActorIndex->GetRevision();
+            AActor* Spawned = World->SpawnActor<AActor>();
+            const uint32 AfterSpawn = ActorIndex->GetRevision();
+            TestNotEqual("Spawned", AfterSpawn, Initial);
+
+            ActorIndex->NotifyActorChanged(Spawned);
+            TestNotEqual("Changed", ActorIndex->GetRevision(), AfterSpawn);
+        });
+
+        It("does not change when actors are only queried", [this]()
+        {
+            const uint32 Initial = ActorIndex->GetRevision();
+            AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "Grass", {});
+            TestEqual("Queried", ActorIndex->GetRevision(), Initial);
+        });
+    });
+
+    Describe("Benchmark", [this]()
+    {
+        It("reports the query time on a level with 100k actors", [this]()
+        {
+            const int32 ActorCount = 100000;
+            for (int32 i = 0; i < ActorCount; i++)
+            {
+                // One actor in a thousand is a surface.
+                SpawnNamedActor(FString::Printf(TEXT("Prop_%i"), i),
+                                i % 1000 == 0 ? TArray<FName>{"Surface"} : TArray<FName>{});
+            }
+
+            double StartTime = FPlatformTime::Seconds();
+            const TArray<AActor*> Scanned = AmbitWorldHelpers::ScanActorsByMatchBy(
+                EMatchBy::NameOrTags, "", {"Surface"});
+            const double ScanSeconds = FPlatformTime::Seconds() - StartTime;
+
+            // The first query indexes every actor spawned so far.
+            StartTime = FPlatformTime::Seconds();
+            TestTrue("The index covers every actor.", ActorIndex->Num() >= ActorCount);
+            const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            const TArray<AActor*> Indexed = AmbitWorldHelpers::GetActorsByMatchBy(
+                EMatchBy::NameOrTags, "", {"Surface"});
+            const double TagSeconds = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameAndTags, "Prop_5", {"Surface"});
+            const double NameAndTagSeconds = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "Prop_5", {"Surface"});
+            const double NameOrTagSeconds = FPlatformTime::Seconds() - StartTime;
+
+            TestEqual("The same surfaces are found.", Indexed.Num(), Scanned.Num());
+            TestEqual("Every surface is found.", Indexed.Num(), ActorCount / 1000);
+
+            UE_LOG(LogAmbit, Display,
+                   TEXT("%i actors: scan %.2f ms, index build %.2f ms, tag query %.3f ms, "
+                       "name AND tag query %.3f ms, name OR tag query %.2f ms."),
+                   ActorCount, ScanSeconds * 1000, BuildSeconds * 1000, TagSeconds * 1000,
+                   NameAndTagSeconds * 1000, NameOrTagSeconds * 1000);
+        });
+    });
+}
@@ -0,0 +1,205 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitActorPoolSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include "Ambit/Utils/AmbitSpawnerCollisionHelpers.h"
+
+void UAmbitActorPoolSubsystem::Deinitialize()
+{
+    // The world destroys its actors itself.
+    PooledActors.Empty();
+    PooledSet.Empty();
+
+    Super::Deinitialize();
+}
+
+AActor* UAmbitActorPoolSubsystem::Acquire(UClass* Class, const FVector& Location, const FRotator& Rotation,
+                                         const FSpawnedObstacleCollision* Collision)
+{
+    AActor* Actor = TakePooledActor(Class);
+    if (Actor != nullptr)
+    {
+        Unpark(Actor, Location, Rotation, Collision);
+        ReusedCount++;
+
+        // Newly spawned actors find their overlaps when they are registered.
+        Actor->UpdateOverlaps();
+        return Actor;
+    }
+
+    // Spawning must not fail on collision here, so that the actor can be pooled if it collides.
+    const FTransform Transform(Rotation, Location);
+    if (Collision != nullptr)
+    {
+        Actor = AmbitSpawnerCollisionHelpers::SpawnObstacle(GetWorld(), Class, Transform, *Collision);
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Actor = GetWorld()->SpawnActor<AActor>(Class, Transform, SpawnParams);
+    }
+    if (Actor == nullptr)
+    {
+        return nullptr;
+    }
+    SpawnedCount++;
+    return Actor;
+}
+
+void UAmbitActorPoolSubsystem::Release(AActor* Actor)
+{
+    if (!IsValid(Actor) || IsPooled(Actor))
+    {
+        return;
+    }
+
+    // Physics may have moved components away from the actor, so it cannot be placed like a new one.
+    TArray<UPrimitiveComponent*> PrimitiveComponents;
+    Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
+    const bool bSimulatesPhysics = PrimitiveComponents.ContainsByPredicate([](const UPrimitiveComponent* Component)
+    {
+        return Component->IsSimulatingPhysics();
+    });
+
+    TArray<TWeakObjectPtr<AActor>>& Pool = PooledActors.FindOrAdd(Actor->GetClass());
+    if (bSimulatesPhysics || Pool.Num() >= MaxActorsPerClass)
+    {
+        Actor->Destroy();
+        return;
+    }
+
+    Park(Actor);
+    Pool.Add(Actor);
+    PooledSet.Add(Actor);
+}
+
+void UAmbitActorPoolSubsystem::Trim(int32 MaxActorsPerClassToKeep)
+{
+    for (auto It = PooledActors.CreateIterator(); It; ++It)
+    {
+        TArray<TWeakObjectPtr<AActor>>& Pool = It.Value();
+        while (Pool.Num() > MaxActorsPerClassToKeep)
+        {
+            const TWeakObjectPtr<AActor> Actor = Pool.Pop(false);
+            PooledSet.Remove(Actor);
+            if (Actor.IsValid())
+            {
+                Actor->Destroy();
+            }
+        }
+        if (Pool.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool UAmbitActorPoolSubsystem::IsPooled(const AActor* Actor) const
+{
+    return PooledSet.Contains(Actor);
+}
+
+int32 UAmbitActorPoolSubsystem::Num() const
+{
+    return PooledSet.Num();
+}
+
+int32 UAmbitActorPoolSubsystem::GetSpawnedCount() const
+{
+    return SpawnedCount;
+}
+
+int32 UAmbitActorPoolSubsystem::GetReusedCount() const
+{
+    return ReusedCount;
+}
+
+AActor* UAmbitActorPoolSubsystem::TakePooledActor(UClass* Class)
+{
+    TArray<TWeakObjectPtr<AActor>>* Pool = PooledActors.Find(Class);
+    if (Pool == nullptr)
+    {
+        return nullptr;
+    }
+
+    while (Pool->Num() > 0)
+    {
+        const TWeakObjectPtr<AActor> Actor = Pool->Pop(false);
+        PooledSet.Remove(Actor);
+        // Pooled actors can still be deleted by the user or by the level.
+        if (IsValid(Actor.Get()))
+        {
+            return Actor.Get();
+        }
+    }
+    return nullptr;
+}
+
+void UAmbitActorPoolSubsystem::Unpark(AActor* Actor, const FVector& Location, const FRotator& Rotation,
+                                     const FSpawnedObstacleCollision* Collision)
+{
+    const AActor* Defaults = Actor->GetClass()->GetDefaultObject<AActor>();
+    Actor->ClearFlags(RF_Transient);
+    Actor->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+
+    if (Collision != nullptr)
+    {
+        AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(Actor, *Collision);
+    }
+    else
+    {
+        // Components take their collision from the class defaults when they are spawned,
+        // and the defaults may have been changed since this actor was spawned.
+        TArray<UStaticMeshComponent*> DefaultComponents;
+        AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(Actor->GetClass(), DefaultComponents);
+        TArray<UStaticMeshComponent*> StaticMeshComponents;
+        Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+        for (int32 i = 0; i < StaticMeshComponents.Num() && i < DefaultComponents.Num(); i++)
+        {
+            UStaticMeshComponent* Component = StaticMeshComponents[i];
+            const UStaticMeshComponent* Default = DefaultComponents[i];
+            Component->SetCollisionObjectType(Default->GetCollisionObjectType());
+            Component->SetCollisionResponseToChannels(Default->GetCollisionResponseToChannels());
+            Component->SetCollisionEnabled(Default->GetCollisionEnabled());
+            Component->SetGenerateOverlapEvents(Default->GetGenerateOverlapEvents());
+        }
+    }
+
+    Actor->SetActorEnableCollision(Defaults->GetActorEnableCollision());
+    Actor->SetActorHiddenInGame(Defaults->IsHidden());
+    Actor->SetActorTickEnabled(Defaults->PrimaryActorTick.bStartWithTickEnabled);
+#if WITH_EDITOR
+    Actor->SetIsTemporarilyHiddenInEditor(false);
+#endif
+}
+
+void UAmbitActorPoolSubsystem::Park(AActor* Actor)
+{
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+#if WITH_EDITOR
+    Actor->SetIsTemporarilyHiddenInEditor(true);
+#endif
+    // Pooled actors are not part of the level.
+    Actor->SetFlags(RF_Transient);
+}
@@ -0,0 +1,102 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "AmbitActorPoolSubsystem.generated.h"
+
+struct FSpawnedObstacleCollision;
+
+/**
+ * Keeps the actors that spawners remove, per class, so that later placements can reuse
+ * them instead of constructing, registering and creating physics for new actors.
+ *
+ * New actors are spawned deferred and finished once; reused actors are only moved and
+ * enabled again. Pooled actors are hidden, have collision disabled, are not saved with
+ * the level and are not found by AmbitWorldHelpers::GetActorsByMatchBy().
+ */
+UCLASS()
+class AMBIT_API UAmbitActorPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void Deinitialize() override;
+
+    /**
+     * Returns an actor of Class at Location and Rotation, reusing a pooled actor if there is one.
+     * The actor is placed even if it collides; callers test the placement and release the actor
+     * if it cannot stay. Returns nullptr only if the actor cannot be spawned at all.
+     *
+     * If Collision is provided, the static mesh components of the actor get that collision,
+     * before they are registered where possible; otherwise they get the collision of the class defaults.
+     */
+    AActor* Acquire(UClass* Class, const FVector& Location, const FRotator& Rotation,
+                    const FSpawnedObstacleCollision* Collision = nullptr);
+
+    /**
+     * Hides Actor and keeps it for a later Acquire() of its class. Actors that simulate physics,
+     * or that would exceed MaxActorsPerClass, are destroyed instead.
+     */
+    void Release(AActor* Actor);
+
+    /**
+     * Destroys pooled actors until no class has more than MaxActorsPerClassToKeep of them.
+     */
+    void Trim(int32 MaxActorsPerClassToKeep = 0);
+
+    /**
+     * Returns true if Actor is waiting in the pool.
+     */
+    bool IsPooled(const AActor* Actor) const;
+
+    /**
+     * Returns the number of actors waiting in the pool.
+     */
+    int32 Num() const;
+
+    /**
+     * Returns the number of actors the pool had to spawn, and the number of times it reused one.
+     */
+    int32 GetSpawnedCount() const;
+    int32 GetReusedCount() const;
+
+    /**
+     * The most actors of one class that the pool keeps.
+     */
+    int32 MaxActorsPerClass = 4096;
+
+private:
+    TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<AActor>>> PooledActors;
+
+    TSet<TWeakObjectPtr<const AActor>> PooledSet;
+
+    int32 SpawnedCount = 0;
+    int32 ReusedCount = 0;
+
+    // Returns a valid pooled actor of Class, removed from the pool, if there is one.
+    AActor* TakePooledActor(UClass* Class);
+
+    // Shows Actor again with the collision settings a newly spawned actor of its class would have,
+    // or with Collision if it is provided.
+    static void Unpark(AActor* Actor, const FVector& Location, const FRotator& Rotation,
+                       const FSpawnedObstacleCollision* Collision);
+
+    // Hides Actor and disables its collision.
+    static void Park(AActor* Actor);
+};
@@ -0,0 +1,280 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitActorPoolSubsystem.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#include "Ambit/AmbitModule.h"
+#include "Ambit/Actors/SpawnedObjectConfigs/SpawnedObjectConfig.h"
+#include "Ambit/Actors/Spawners/SpawnOnSurface.h"
+#include "Ambit/Utils/AmbitSpawnerCollisionHelpers.h"
+#include "Ambit/Utils/AmbitWorldHelpers.h"
+
+BEGIN_DEFINE_SPEC(AmbitActorPoolSubsystemSpec, "Ambit.Unit.AmbitActorPoolSubsystem",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UAmbitActorPoolSubsystem* ActorPool;
+    UClass* PropClass;
+END_DEFINE_SPEC(AmbitActorPoolSubsystemSpec)
+
+void AmbitActorPoolSubsystemSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        ActorPool = World->GetSubsystem<UAmbitActorPoolSubsystem>();
+        TestNotNull("Check if the actor pool exists", ActorPool);
+
+        PropClass = FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C").TryLoadClass<AActor>();
+        TestNotNull("Check if the prop class is loaded", PropClass);
+    });
+
+    Describe("Acquire()", [this]()
+    {
+        It("spawns an actor when none is pooled", [this]()
+        {
+            AActor* Actor = ActorPool->Acquire(PropClass, FVector(100, 0, 0), FRotator::ZeroRotator);
+
+            TestNotNull("Actor", Actor);
+            TestEqual("Location", Actor->GetActorLocation(), FVector(100, 0, 0));
+            TestEqual("Spawned count", ActorPool->GetSpawnedCount(), 1);
+            TestEqual("Reused count", ActorPool->GetReusedCount(), 0);
+        });
+
+        It("reuses a released actor at the new placement", [this]()
+        {
+            AActor* Actor = ActorPool->Acquire(PropClass, FVector(100, 0, 0), FRotator::ZeroRotator);
+            ActorPool->Release(Actor);
+
+            AActor* Reused = ActorPool->Acquire(PropClass, FVector(500, 0, 0), FRotator(0, 90, 0));
+
+            TestEqual("Same actor", Reused, Actor);
+            TestEqual("Location", Reused->GetActorLocation(), FVector(500, 0, 0));
+            TestTrue("Rotation", Reused->GetActorRotation().Equals(FRotator(0, 90, 0), KINDA_SMALL_NUMBER));
+            TestFalse("Hidden", Reused->IsHidden());
+            TestTrue("Collision", Reused->GetActorEnableCollision());
+            TestFalse("Transient", Reused->HasAnyFlags(RF_Transient));
+            TestFalse("Pooled", ActorPool->IsPooled(Reused));
+            TestEqual("Spawned count", ActorPool->GetSpawnedCount(), 1);
+            TestEqual("Reused count", ActorPool->GetReusedCount(), 1);
+        });
+
+        It("does not reuse an actor of another class", [this]()
+        {
+            AStaticMeshActor* Other = World->SpawnActor<AStaticMeshActor>();
+            ActorPool->Release(Other);
+
+            AActor* Actor = ActorPool->Acquire(PropClass, FVector::ZeroVector, FRotator::ZeroRotator);
+
+            TestNotEqual("Different actor", Actor, static_cast<AActor*>(Other));
+            TestEqual("Reused count", ActorPool->GetReusedCount(), 0);
+        });
+
+        It("gives the actor the provided collision without changing the class defaults", [this]()
+        {
+            FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(PropClass);
+            TArray<UStaticMeshComponent*> Defaults;
+            AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(PropClass, Defaults);
+            const ECollisionChannel DefaultObjectType = Defaults[0]->GetCollisionObjectType();
+
+            AActor* Actor = ActorPool->Acquire(PropClass, FVector::ZeroVector, FRotator::ZeroRotator, &Collision);
+            ActorPool->Release(Actor);
+            AActor* Reused = ActorPool->Acquire(PropClass, FVector::ZeroVector, FRotator::ZeroRotator, &Collision);
+
+            TestEqual("Spawned object type",
+                      Actor->FindComponentByClass<UStaticMeshComponent>()->GetCollisionObjectType(),
+                      ECC_GameTraceChannel1);
+            TestEqual("Reused object type",
+                      Reused->FindComponentByClass<UStaticMeshComponent>()->GetCollisionObjectType(),
+                      ECC_GameTraceChannel1);
+            TestEqual("Default object type", Defaults[0]->GetCollisionObjectType(), DefaultObjectType);
+        });
+    });
+
+    Describe("Release()", [this]()
+    {
+        It("hides the actor and keeps it out of the level", [this]()
+        {
+            FActorSpawnParameters Params;
+            Params.Name = FName("PooledProp");
+            AActor* Actor = World->SpawnActor<AActor>(PropClass, FTransform::Identity, Params);
+
+            ActorPool->Release(Actor);
+
+            TestTrue("Valid", IsValid(Actor));
+            TestTrue("Pooled", ActorPool->IsPooled(Actor));
+            TestTrue("Hidden", Actor->IsHidden());
+            TestFalse("Collision", Actor->GetActorEnableCollision());
+            TestTrue("Transient", Actor->HasAnyFlags(RF_Transient));
+            TestEqual("Not matched as a surface",
+                      AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "PooledProp", {}).Num(), 0);
+            TestEqual("Not scanned as a surface",
+                      AmbitWorldHelpers::ScanActorsByMatchBy(EMatchBy::NameOrTags, "PooledProp", {}).Num(), 0);
+        });
+
+        It("destroys actors beyond MaxActorsPerClass", [this]()
+        {
+            ActorPool->MaxActorsPerClass = 1;
+            AActor* First = ActorPool->Acquire(PropClass, FVector(0, 0, 0), FRotator::ZeroRotator);
+            AActor* Second = ActorPool->Acquire(PropClass, FVector(1000, 0, 0), FRotator::ZeroRotator);
+
+            ActorPool->Release(First);
+            ActorPool->Release(Second);
+
+            TestEqual("Pooled actors", ActorPool->Num(), 1);
+            TestTrue("First is pooled", ActorPool->IsPooled(First));
+            TestFalse("Second is destroyed", IsValid(Second));
+        });
+    });
+
+    Describe("Trim()", [this]()
+    {
+        It("destroys pooled actors beyond the given count", [this]()
+        {
+            TArray<AActor*> Actors;
+            for (int32 i = 0; i < 3; i++)
+            {
+                Actors.Add(ActorPool->Acquire(PropClass, FVector(i * 1000.f, 0, 0), FRotator::ZeroRotator));
+            }
+            for (AActor* Actor : Actors)
+            {
+                ActorPool->Release(Actor);
+            }
+
+            ActorPool->Trim(1);
+            TestEqual("Pooled actors after trimming to one", ActorPool->Num(), 1);
+
+            ActorPool->Trim();
+            TestEqual("Pooled actors after emptying", ActorPool->Num(), 0);
+            for (AActor* Actor : Actors)
+            {
+                TestFalse("Destroyed", IsValid(Actor));
+            }
+        });
+    });
+
+    AfterEach([this]()
+    {
+        ActorPool->Trim();
+    });
+}
+
+BEGIN_DEFINE_SPEC(AmbitActorPoolSubsystemBenchmarkSpec, "Ambit.Perf.AmbitActorPoolSubsystem",
+                  EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UAmbitActorPoolSubsystem* ActorPool;
+    UClass* PropClass;
+
+    // Runs the export of Spawner for each seed, as a bulk export does, and returns the spawned objects.
+    TArray<FPlacementBuffer> ExportPermutations(ASpawnOnSurface* Spawner, int32 Permutations)
+    {
+        TArray<FPlacementBuffer> Exported;
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().BindLambda(
+            [&Exported](TScriptInterface<IConfigJsonSerializer>& Config, bool bSuccess)
+            {
+                Exported.Add(Cast<USpawnedObjectConfig>(Config.GetObject())->SpawnedObjects);
+            });
+        for (int32 Seed = 0; Seed < Permutations; Seed++)
+        {
+            Spawner->GenerateSpawnedObjectConfiguration(Seed);
+        }
+        Spawner->GetOnSpawnedObjectConfigCompletedDelegate().Unbind();
+        return Exported;
+    }
+END_DEFINE_SPEC(AmbitActorPoolSubsystemBenchmarkSpec)
+
+void AmbitActorPoolSubsystemBenchmarkSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        ActorPool = World->GetSubsystem<UAmbitActorPoolSubsystem>();
+        TestNotNull("Check if the actor pool exists", ActorPool);
+
+        PropClass = FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C").TryLoadClass<AActor>();
+        TestNotNull("Check if the prop class is loaded", PropClass);
+    });
+
+    It("reports the time of a 50 permutation export with and without the pool", [this]()
+    {
+        const int32 Permutations = 50;
+
+        UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'"));
+        FActorSpawnParameters SurfaceParams;
+        SurfaceParams.Name = FName("BenchmarkSurface");
+        AStaticMeshActor* Surface = World->SpawnActor<AStaticMeshActor>(
+            AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, FVector::ZeroVector,
+                                                        FVector(20, 20, 1)), SurfaceParams);
+        Surface->GetStaticMeshComponent()->SetStaticMesh(Plane);
+
+        ASpawnOnSurface* Spawner = World->SpawnActor<ASpawnOnSurface>();
+        Spawner->SurfaceNamePattern = "BenchmarkSurface";
+        Spawner->ActorsToSpawn.Add(PropClass);
+        Spawner->DensityMin = 0.5f;
+        Spawner->DensityMax = 0.5f;
+        Spawner->SpawnBudgetMilliseconds = 0.f;
+        // Exports only spawn, and so use the pool, if they are asked to.
+        Spawner->bExportWithoutSpawning = false;
+
+        Spawner->bPoolActors = false;
+        double StartTime = FPlatformTime::Seconds();
+        const TArray<FPlacementBuffer> Unpooled = ExportPermutations(Spawner, Permutations);
+        const double UnpooledSeconds = FPlatformTime::Seconds() - StartTime;
+
+        Spawner->bPoolActors = true;
+        StartTime = FPlatformTime::Seconds();
+        const TArray<FPlacementBuffer> Pooled = ExportPermutations(Spawner, Permutations);
+        const double PooledSeconds = FPlatformTime::Seconds() - StartTime;
+
+        TestEqual("Every permutation is exported without the pool.", Unpooled.Num(), Permutations);
+        TestEqual("Every permutation is exported with the pool.", Pooled.Num(), Permutations);
+        int32 SpawnedObjects = 0;
+        for (int32 i = 0; i < Pooled.Num() && i < Unpooled.Num(); i++)
+        {
+            const int32 PooledCount = Pooled[i].Num();
+            const int32 UnpooledCount = Unpooled[i].Num();
+            TestEqual(FString::Printf(TEXT("Permutation %i places the same objects."), i), PooledCount,
+                      UnpooledCount);
+            SpawnedObjects += PooledCount;
+        }
+        TestTrue("The pool reuses actors.", ActorPool->GetReusedCount() > ActorPool->GetSpawnedCount());
+
+        UE_LOG(LogAmbit, Display,
+               TEXT("%i permutations, %i objects: without pool %.1f ms, with pool %.1f ms "
+                   "(%i actors spawned, %i reused)."),
+               Permutations, SpawnedObjects, UnpooledSeconds * 1000, PooledSeconds * 1000,
+               ActorPool->GetSpawnedCount(), ActorPool->GetReusedCount());
+
+        Spawner->Destroy();
+        Surface->Destroy();
+    });
+
+    AfterEach([this]()
+    {
+        ActorPool->Trim();
+    });
+}
@@ -0,0 +1,100 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitCollisionTemplateSubsystem.h"
+
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+
+void UAmbitCollisionTemplateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+#if WITH_EDITOR
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+        this, &UAmbitCollisionTemplateSubsystem::OnObjectPropertyChanged);
+    ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(
+        this, &UAmbitCollisionTemplateSubsystem::OnObjectsReplaced);
+#endif
+}
+
+void UAmbitCollisionTemplateSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+
+    Empty();
+
+    Super::Deinitialize();
+}
+
+FSpawnedObstacleCollisionRef UAmbitCollisionTemplateSubsystem::FindOrAdd(UClass* Class, bool bRemoveOverlaps)
+{
+    check(IsInGameThread());
+
+    const FTemplateKey Key(Class, bRemoveOverlaps);
+    {
+        FScopeLock Lock(&TemplatesLock);
+        if (const FSpawnedObstacleCollisionRef* Found = Templates.Find(Key))
+        {
+            return *Found;
+        }
+    }
+
+    // Reading the class defaults does not need the lock; only the game thread adds templates.
+    const FSpawnedObstacleCollisionRef Template = MakeShared<const FSpawnedObstacleCollision, ESPMode::ThreadSafe>(
+        AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(Class, bRemoveOverlaps));
+    FScopeLock Lock(&TemplatesLock);
+    Templates.Add(Key, Template);
+    return Template;
+}
+
+FSpawnedObstacleCollisionPtr UAmbitCollisionTemplateSubsystem::Find(const UClass* Class, bool bRemoveOverlaps) const
+{
+    FScopeLock Lock(&TemplatesLock);
+    const FSpawnedObstacleCollisionRef* Found = Templates.Find(FTemplateKey(Class, bRemoveOverlaps));
+    return Found != nullptr ? FSpawnedObstacleCollisionPtr(*Found) : nullptr;
+}
+
+void UAmbitCollisionTemplateSubsystem::Empty()
+{
+    FScopeLock Lock(&TemplatesLock);
+    Templates.Empty();
+}
+
+int32 UAmbitCollisionTemplateSubsystem::Num() const
+{
+    FScopeLock Lock(&TemplatesLock);
+    return Templates.Num();
+}
+
+#if WITH_EDITOR
+void UAmbitCollisionTemplateSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Class defaults and the component templates of Blueprints are the only objects templates are built from.
+    if (Object != nullptr && Object->IsTemplate())
+    {
+        Empty();
+    }
+}
+
+void UAmbitCollisionTemplateSubsystem::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+    // Compiling a Blueprint replaces its class defaults and component templates.
+    Empty();
+}
+#endif
@@ -0,0 +1,89 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+
+#include "AmbitSpawnerCollisionHelpers.h"
+
+#include "AmbitCollisionTemplateSubsystem.generated.h"
+
+using FSpawnedObstacleCollisionRef = TSharedRef<const FSpawnedObstacleCollision, ESPMode::ThreadSafe>;
+using FSpawnedObstacleCollisionPtr = TSharedPtr<const FSpawnedObstacleCollision, ESPMode::ThreadSafe>;
+
+/**
+ * Keeps the collision of the obstacles that spawners place for each actor class,
+ * so that it is worked out once per class instead of changing the class defaults
+ * before every spawn and restoring them afterwards.
+ *
+ * Templates are built on the game thread. Once built, they do not change and can be
+ * read from any thread. The cache is emptied when class defaults or component templates
+ * are edited, or when Blueprints are compiled.
+ */
+UCLASS()
+class AMBIT_API UAmbitCollisionTemplateSubsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    void Deinitialize() override;
+
+    /**
+     * Returns the collision of obstacles of Class, building it if it is not cached yet.
+     * Must be called on the game thread.
+     *
+     * @param Class
+     *  the class of the spawned obstacles
+     * @param bRemoveOverlaps
+     *  whether the obstacles block other spawned obstacles, as ASpawnerBase::bRemoveOverlaps
+     */
+    FSpawnedObstacleCollisionRef FindOrAdd(UClass* Class, bool bRemoveOverlaps);
+
+    /**
+     * Returns the cached collision of obstacles of Class, or nullptr if it has not been built.
+     * Can be called from any thread.
+     */
+    FSpawnedObstacleCollisionPtr Find(const UClass* Class, bool bRemoveOverlaps) const;
+
+    /**
+     * Forgets every template, so that they are built again from the current class defaults.
+     */
+    void Empty();
+
+    /**
+     * Returns the number of cached templates.
+     */
+    int32 Num() const;
+
+private:
+    using FTemplateKey = TPair<TWeakObjectPtr<const UClass>, bool>;
+
+    mutable FCriticalSection TemplatesLock;
+
+    TMap<FTemplateKey, FSpawnedObstacleCollisionRef> Templates;
+
+#if WITH_EDITOR
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle ObjectsReplacedHandle;
+
+    void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+
+    void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+#endif
+};
@@ -0,0 +1,94 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitCollisionTemplateSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(AmbitCollisionTemplateSubsystemSpec, "Ambit.Unit.AmbitCollisionTemplateSubsystem",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UAmbitCollisionTemplateSubsystem* CollisionTemplates;
+    UClass* PropClass;
+END_DEFINE_SPEC(AmbitCollisionTemplateSubsystemSpec)
+
+void AmbitCollisionTemplateSubsystemSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        CollisionTemplates = GEngine->GetEngineSubsystem<UAmbitCollisionTemplateSubsystem>();
+        TestNotNull("Check if the collision templates exist", CollisionTemplates);
+        CollisionTemplates->Empty();
+
+        PropClass = FSoftClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C").TryLoadClass<AActor>();
+        TestNotNull("Check if the prop class is loaded", PropClass);
+    });
+
+    AfterEach([this]()
+    {
+        CollisionTemplates->Empty();
+    });
+
+    Describe("FindOrAdd()", [this]()
+    {
+        It("builds the template of a class once", [this]()
+        {
+            const FSpawnedObstacleCollisionRef First = CollisionTemplates->FindOrAdd(PropClass, true);
+            const FSpawnedObstacleCollisionRef Second = CollisionTemplates->FindOrAdd(PropClass, true);
+
+            TestEqual("the same template is returned", &First.Get(), &Second.Get());
+            TestEqual("one template is cached", CollisionTemplates->Num(), 1);
+        });
+
+        It("keeps separate templates for overlapping and non-overlapping obstacles", [this]()
+        {
+            const FSpawnedObstacleCollisionRef Blocking = CollisionTemplates->FindOrAdd(PropClass, true);
+            const FSpawnedObstacleCollisionRef Overlapping = CollisionTemplates->FindOrAdd(PropClass, false);
+
+            TestEqual("blocking object type", Blocking->ObjectType, ECC_GameTraceChannel1);
+            TestEqual("overlapping object type", Overlapping->ObjectType, ECC_GameTraceChannel2);
+            TestEqual("two templates are cached", CollisionTemplates->Num(), 2);
+        });
+    });
+
+    Describe("Find()", [this]()
+    {
+        It("returns nullptr for a class without a template", [this]()
+        {
+            TestFalse("no template", CollisionTemplates->Find(PropClass, true).IsValid());
+        });
+
+        It("returns the template built by FindOrAdd", [this]()
+        {
+            const FSpawnedObstacleCollisionRef Added = CollisionTemplates->FindOrAdd(PropClass, true);
+            const FSpawnedObstacleCollisionPtr Found = CollisionTemplates->Find(PropClass, true);
+
+            TestTrue("template is found", Found.IsValid() && Found.Get() == &Added.Get());
+        });
+    });
+
+    Describe("Empty()", [this]()
+    {
+        It("forgets every template", [this]()
+        {
+            CollisionTemplates->FindOrAdd(PropClass, true);
+            CollisionTemplates->Empty();
+
+            TestEqual("no templates are cached", CollisionTemplates->Num(), 0);
+            TestFalse("template is gone", CollisionTemplates->Find(PropClass, true).IsValid());
+        });
+    });
+}
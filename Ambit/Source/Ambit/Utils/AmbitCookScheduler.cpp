@@ -0,0 +1,92 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitCookScheduler.h"
+
+#include "Templates/UnrealTemplate.h"
+
+FAmbitCookScheduler::FAmbitCookScheduler(int32 InMaxConcurrentCooks)
+    : MaxConcurrentCooks(FMath::Max(1, InMaxConcurrentCooks))
+{
+}
+
+void FAmbitCookScheduler::SetMaxConcurrentCooks(int32 InMaxConcurrentCooks)
+{
+    MaxConcurrentCooks = FMath::Max(1, InMaxConcurrentCooks);
+    StartQueuedCooks();
+}
+
+void FAmbitCookScheduler::Enqueue(TFunction<void()> StartCook)
+{
+    if (Scheduled == 0)
+    {
+        StartTime = FPlatformTime::Seconds();
+    }
+
+    Scheduled++;
+    Queue.Add(MoveTemp(StartCook));
+    StartQueuedCooks();
+}
+
+void FAmbitCookScheduler::FinishCook()
+{
+    // The cook was started before the last Reset().
+    if (InFlight == 0)
+    {
+        return;
+    }
+
+    InFlight--;
+    Finished++;
+    StartQueuedCooks();
+}
+
+void FAmbitCookScheduler::Reset()
+{
+    Queue.Empty();
+    NextQueued = 0;
+    InFlight = 0;
+    Finished = 0;
+    Scheduled = 0;
+    StartTime = 0.0;
+}
+
+double FAmbitCookScheduler::GetCooksPerSecond() const
+{
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    return Scheduled > 0 && Elapsed > 0.0 ? Finished / Elapsed : 0.0;
+}
+
+void FAmbitCookScheduler::StartQueuedCooks()
+{
+    // A cook that finishes while it is being started leaves its slot to the loop below.
+    if (bStartingCooks)
+    {
+        return;
+    }
+
+    TGuardValue<bool> StartingCooks(bStartingCooks, true);
+    while (NextQueued < Queue.Num() && InFlight < MaxConcurrentCooks)
+    {
+        InFlight++;
+        const TFunction<void()> StartCook = MoveTemp(Queue[NextQueued++]);
+        StartCook();
+    }
+
+    if (NextQueued == Queue.Num())
+    {
+        Queue.Reset();
+        NextQueued = 0;
+    }
+}
@@ -0,0 +1,102 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Starts cooks in the order they are queued while keeping at most MaxConcurrentCooks of them in flight.
+ * The owner reports each finished cook through FinishCook(), which starts the next queued one.
+ *
+ * Also keeps count of the cooks so that their progress and throughput can be reported.
+ */
+class FAmbitCookScheduler
+{
+public:
+    explicit FAmbitCookScheduler(int32 InMaxConcurrentCooks = 4);
+
+    /**
+     * Changes the number of cooks that may be in flight. Cooks already in flight are not interrupted.
+     */
+    void SetMaxConcurrentCooks(int32 InMaxConcurrentCooks);
+
+    /**
+     * Queues a cook. StartCook is called right away if there is room for one more cook in flight,
+     * otherwise once an earlier cook finishes.
+     */
+    void Enqueue(TFunction<void()> StartCook);
+
+    /**
+     * Reports that one of the cooks in flight has finished, and starts the next queued one.
+     */
+    void FinishCook();
+
+    /**
+     * Drops the queued cooks and clears the counts.
+     */
+    void Reset();
+
+    /**
+     * Returns the number of cooks waiting to start.
+     */
+    int32 NumQueued() const
+    {
+        return Queue.Num() - NextQueued;
+    }
+
+    /**
+     * Returns the number of cooks started but not finished.
+     */
+    int32 NumInFlight() const
+    {
+        return InFlight;
+    }
+
+    /**
+     * Returns the number of cooks finished since the last Reset().
+     */
+    int32 NumFinished() const
+    {
+        return Finished;
+    }
+
+    /**
+     * Returns the number of cooks queued since the last Reset().
+     */
+    int32 NumScheduled() const
+    {
+        return Scheduled;
+    }
+
+    /**
+     * Returns the number of cooks finished per second since the first cook was queued.
+     */
+    double GetCooksPerSecond() const;
+
+private:
+    /**
+     * Starts queued cooks until MaxConcurrentCooks are in flight or none are queued.
+     */
+    void StartQueuedCooks();
+
+    TArray<TFunction<void()>> Queue;
+    int32 NextQueued = 0;
+    int32 MaxConcurrentCooks;
+    int32 InFlight = 0;
+    int32 Finished = 0;
+    int32 Scheduled = 0;
+    double StartTime = 0.0;
+    bool bStartingCooks = false;
+};
@@ -0,0 +1,138 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitCookScheduler.h"
+
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(AmbitCookSchedulerSpec, "Ambit.Unit.AmbitCookScheduler",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    TArray<int32> Started;
+
+    TFunction<void()> Cook(int32 Index)
+    {
+        return [this, Index]()
+        {
+            Started.Add(Index);
+        };
+    }
+END_DEFINE_SPEC(AmbitCookSchedulerSpec)
+
+void AmbitCookSchedulerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Started.Empty();
+    });
+
+    Describe("Enqueue()", [this]()
+    {
+        It("Should start no more than MaxConcurrentCooks cooks at once", [this]()
+        {
+            FAmbitCookScheduler Scheduler(2);
+            for (int32 i = 0; i < 5; i++)
+            {
+                Scheduler.Enqueue(Cook(i));
+            }
+
+            TestTrue("Started", Started == TArray<int32>{0, 1});
+            TestEqual("In flight", Scheduler.NumInFlight(), 2);
+            TestEqual("Queued", Scheduler.NumQueued(), 3);
+            TestEqual("Scheduled", Scheduler.NumScheduled(), 5);
+        });
+
+        It("Should start the next queued cook when one finishes", [this]()
+        {
+            FAmbitCookScheduler Scheduler(2);
+            for (int32 i = 0; i < 5; i++)
+            {
+                Scheduler.Enqueue(Cook(i));
+            }
+
+            Scheduler.FinishCook();
+            TestTrue("Started", Started == TArray<int32>{0, 1, 2});
+
+            Scheduler.FinishCook();
+            Scheduler.FinishCook();
+            Scheduler.FinishCook();
+            Scheduler.FinishCook();
+            TestTrue("Started", Started == TArray<int32>{0, 1, 2, 3, 4});
+            TestEqual("In flight", Scheduler.NumInFlight(), 0);
+            TestEqual("Queued", Scheduler.NumQueued(), 0);
+            TestEqual("Finished", Scheduler.NumFinished(), 5);
+        });
+
+        It("Should keep the limit when a cook finishes while it is started", [this]()
+        {
+            FAmbitCookScheduler Scheduler(1);
+            int32 MaxInFlight = 0;
+            for (int32 i = 0; i < 3; i++)
+            {
+                Scheduler.Enqueue([this, i, &Scheduler, &MaxInFlight]()
+                {
+                    Started.Add(i);
+                    MaxInFlight = FMath::Max(MaxInFlight, Scheduler.NumInFlight());
+                    Scheduler.FinishCook();
+                });
+            }
+
+            TestTrue("Started", Started == TArray<int32>{0, 1, 2});
+            TestEqual("Max in flight", MaxInFlight, 1);
+            TestEqual("Finished", Scheduler.NumFinished(), 3);
+        });
+    });
+
+    Describe("SetMaxConcurrentCooks()", [this]()
+    {
+        It("Should start queued cooks when the limit is raised", [this]()
+        {
+            FAmbitCookScheduler Scheduler(1);
+            for (int32 i = 0; i < 3; i++)
+            {
+                Scheduler.Enqueue(Cook(i));
+            }
+
+            Scheduler.SetMaxConcurrentCooks(3);
+            TestTrue("Started", Started == TArray<int32>{0, 1, 2});
+        });
+    });
+
+    Describe("Reset()", [this]()
+    {
+        It("Should drop the queued cooks and the counts", [this]()
+        {
+            FAmbitCookScheduler Scheduler(1);
+            Scheduler.Enqueue(Cook(0));
+            Scheduler.Enqueue(Cook(1));
+            Scheduler.Reset();
+            Scheduler.Enqueue(Cook(2));
+
+            TestTrue("Started", Started == TArray<int32>{0, 2});
+            TestEqual("Scheduled", Scheduler.NumScheduled(), 1);
+            TestEqual("Queued", Scheduler.NumQueued(), 0);
+        });
+    });
+
+    Describe("GetCooksPerSecond()", [this]()
+    {
+        It("Should be 0 before any cook finishes", [this]()
+        {
+            FAmbitCookScheduler Scheduler(1);
+            TestEqual("Before queueing", Scheduler.GetCooksPerSecond(), 0.0);
+            Scheduler.Enqueue(Cook(0));
+            TestEqual("Before finishing", Scheduler.GetCooksPerSecond(), 0.0);
+        });
+    });
+}
@@ -0,0 +1,48 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitCounterRandom.h"
+
+#include "Misc/Crc.h"
+
+FAmbitCounterRandom::FAmbitCounterRandom(int32 Seed, uint32 SpawnerId)
+    : Key(Mix(Mix(static_cast<uint32>(Seed)) ^ SpawnerId))
+{
+}
+
+FAmbitCounterRandom FAmbitCounterRandom::ForSurface(int32 SurfaceIndex) const
+{
+    return FAmbitCounterRandom(Mix(Key ^ static_cast<uint32>(SurfaceIndex)));
+}
+
+int32 FAmbitCounterRandom::RandRange(int32 SampleIndex, EAmbitRandomChannel Channel, int32 Min, int32 Max) const
+{
+    const int64 Range = static_cast<int64>(Max) - Min + 1;
+    if (Range <= 1)
+    {
+        return Min;
+    }
+    // Scale the 32 random bits to the range instead of taking a modulo, which would favor small values.
+    return Min + static_cast<int32>((GetUInt(SampleIndex, Channel) * static_cast<uint64>(Range)) >> 32);
+}
+
+FRandomStream FAmbitCounterRandom::MakeStream(int32 SampleIndex, EAmbitRandomChannel Channel) const
+{
+    return FRandomStream(static_cast<int32>(GetUInt(SampleIndex, Channel)));
+}
+
+uint32 FAmbitCounterRandom::GetSpawnerId(const UObject* Spawner)
+{
+    return Spawner != nullptr ? FCrc::StrCrc32(*Spawner->GetClass()->GetName()) : 0;
+}
@@ -0,0 +1,124 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The independent random values drawn for each sample.
+ */
+enum class EAmbitRandomChannel : uint32
+{
+    // How many samples to draw, once per surface.
+    Density,
+    LocationX,
+    LocationY,
+    Yaw,
+    // Distance along a spline.
+    Distance,
+    // Selects the component and the triangle of a mesh surface.
+    Area,
+    TriangleU,
+    TriangleV,
+    // Selects which of several actor classes to spawn.
+    ActorClass,
+    // Seeds an FRandomStream for algorithms that are inherently sequential.
+    Stream
+};
+
+/**
+ * A counter-based random number generator in the style of SplitMix64.
+ *
+ * Every value is a pure function of a key (seed, spawner, surface) and a counter
+ * (sample index, channel), so samples can be drawn in any order and on any thread
+ * and the results are still reproducible from the seed alone.
+ */
+class AMBIT_API FAmbitCounterRandom
+{
+public:
+    /**
+     * @param Seed
+     *  the user-facing random seed
+     * @param SpawnerId
+     *  tells apart spawners that share a seed. See GetSpawnerId().
+     */
+    explicit FAmbitCounterRandom(int32 Seed, uint32 SpawnerId = 0);
+
+    /**
+     * Returns a generator for the samples of one surface.
+     */
+    FAmbitCounterRandom ForSurface(int32 SurfaceIndex) const;
+
+    /**
+     * Returns 32 random bits for a sample.
+     */
+    uint32 GetUInt(int32 SampleIndex, EAmbitRandomChannel Channel) const
+    {
+        const uint64 Counter = (static_cast<uint64>(static_cast<uint32>(SampleIndex)) << 32)
+                               | static_cast<uint32>(Channel);
+        return static_cast<uint32>(Mix(Key ^ Mix(Counter)) >> 32);
+    }
+
+    /**
+     * Returns a random fraction in [0, 1) for a sample.
+     */
+    float GetFraction(int32 SampleIndex, EAmbitRandomChannel Channel) const
+    {
+        // 24 bits fill the mantissa of a float exactly.
+        return (GetUInt(SampleIndex, Channel) >> 8) * (1.f / 16777216.f);
+    }
+
+    /**
+     * Returns a random float in [Min, Max) for a sample, like FRandomStream::FRandRange().
+     */
+    float FRandRange(int32 SampleIndex, EAmbitRandomChannel Channel, float Min, float Max) const
+    {
+        return Min + (Max - Min) * GetFraction(SampleIndex, Channel);
+    }
+
+    /**
+     * Returns a random integer in [Min, Max] for a sample, like FRandomStream::RandRange().
+     */
+    int32 RandRange(int32 SampleIndex, EAmbitRandomChannel Channel, int32 Min, int32 Max) const;
+
+    /**
+     * Returns a sequential random stream for algorithms that cannot be expressed per sample.
+     */
+    FRandomStream MakeStream(int32 SampleIndex, EAmbitRandomChannel Channel = EAmbitRandomChannel::Stream) const;
+
+    /**
+     * Returns the ID that tells the samples of Spawner apart from other spawners with the same seed.
+     * It is derived from the spawner's class rather than its name, because Bulk Scenario
+     * Configurations do not store actor names and must reproduce the same placements.
+     */
+    static uint32 GetSpawnerId(const UObject* Spawner);
+
+private:
+    uint64 Key;
+
+    explicit FAmbitCounterRandom(uint64 InKey) : Key(InKey)
+    {
+    }
+
+    // The SplitMix64 output function: a bijective mix of all 64 bits.
+    static uint64 Mix(uint64 Value)
+    {
+        Value += 0x9E3779B97F4A7C15ull;
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+};
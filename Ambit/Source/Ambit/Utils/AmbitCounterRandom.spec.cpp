@@ -0,0 +1,129 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitCounterRandom.h"
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(AmbitCounterRandomSpec, "Ambit.Unit.AmbitCounterRandom",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    static constexpr int32 KSampleCount = 10000;
+
+    // Draws a location and a yaw for every sample, splitting the samples between ThreadCount tasks.
+    static TArray<FVector> DrawSamples(const FAmbitCounterRandom& Random, int32 ThreadCount)
+    {
+        TArray<FVector> Samples;
+        Samples.SetNumZeroed(KSampleCount);
+        const int32 ChunkSize = FMath::DivideAndRoundUp(KSampleCount, ThreadCount);
+        ParallelFor(ThreadCount, [&](int32 Chunk)
+        {
+            const int32 End = FMath::Min((Chunk + 1) * ChunkSize, KSampleCount);
+            // Walk each chunk backwards too, so that nothing depends on the order of the draws.
+            for (int32 Sample = End - 1; Sample >= Chunk * ChunkSize; Sample--)
+            {
+                Samples[Sample] = FVector(Random.FRandRange(Sample, EAmbitRandomChannel::LocationX, -500.f, 500.f),
+                                          Random.FRandRange(Sample, EAmbitRandomChannel::LocationY, -500.f, 500.f),
+                                          Random.FRandRange(Sample, EAmbitRandomChannel::Yaw, 0.f, 360.f));
+            }
+        }, ThreadCount == 1);
+        return Samples;
+    }
+END_DEFINE_SPEC(AmbitCounterRandomSpec)
+
+void AmbitCounterRandomSpec::Define()
+{
+    Describe("Values", [this]()
+    {
+        It("only depend on the key and the counter", [this]()
+        {
+            const FAmbitCounterRandom First(42, 7);
+            const FAmbitCounterRandom Second(42, 7);
+            TestEqual("The same sample has the same value.", First.GetUInt(3, EAmbitRandomChannel::Yaw),
+                      Second.GetUInt(3, EAmbitRandomChannel::Yaw));
+            TestEqual("The same surface has the same value.",
+                      First.ForSurface(2).GetUInt(3, EAmbitRandomChannel::Yaw),
+                      Second.ForSurface(2).GetUInt(3, EAmbitRandomChannel::Yaw));
+        });
+
+        It("differ for every part of the key and the counter", [this]()
+        {
+            const FAmbitCounterRandom Random(42, 7);
+            const uint32 Value = Random.GetUInt(3, EAmbitRandomChannel::Yaw);
+            TestNotEqual("The seed changes the value.", FAmbitCounterRandom(43, 7).GetUInt(3, EAmbitRandomChannel::Yaw),
+                         Value);
+            TestNotEqual("The spawner changes the value.",
+                         FAmbitCounterRandom(42, 8).GetUInt(3, EAmbitRandomChannel::Yaw), Value);
+            TestNotEqual("The surface changes the value.", Random.ForSurface(1).GetUInt(3, EAmbitRandomChannel::Yaw),
+                         Value);
+            TestNotEqual("The sample changes the value.", Random.GetUInt(4, EAmbitRandomChannel::Yaw), Value);
+            TestNotEqual("The channel changes the value.", Random.GetUInt(3, EAmbitRandomChannel::LocationX), Value);
+        });
+
+        It("stay within their ranges and cover them", [this]()
+        {
+            const FAmbitCounterRandom Random(0);
+            float MinFraction = 1.f;
+            float MaxFraction = 0.f;
+            TArray<int32> Counts;
+            Counts.SetNumZeroed(4);
+            for (int32 Sample = 0; Sample < KSampleCount; Sample++)
+            {
+                const float Fraction = Random.GetFraction(Sample, EAmbitRandomChannel::Area);
+                MinFraction = FMath::Min(MinFraction, Fraction);
+                MaxFraction = FMath::Max(MaxFraction, Fraction);
+
+                const int32 Index = Random.RandRange(Sample, EAmbitRandomChannel::ActorClass, 0, 3);
+                if (TestTrue("The index is within the range.", Index >= 0 && Index <= 3))
+                {
+                    Counts[Index]++;
+                }
+            }
+            TestTrue("Fractions are at least 0.", MinFraction >= 0.f);
+            TestTrue("Fractions are less than 1.", MaxFraction < 1.f);
+            TestTrue("Fractions cover the range.", MinFraction < 0.01f && MaxFraction > 0.99f);
+            for (const int32 Count : Counts)
+            {
+                // Each of the 4 values is expected 2500 times.
+                TestTrue("Every index is drawn about equally often.", Count > 2200 && Count < 2800);
+            }
+            TestEqual("A single value range returns that value.", Random.RandRange(0, EAmbitRandomChannel::ActorClass,
+                                                                                   5, 5), 5);
+        });
+    });
+
+    Describe("Sampling", [this]()
+    {
+        It("gives the same samples whatever the number of threads", [this]()
+        {
+            const FAmbitCounterRandom Random = FAmbitCounterRandom(1234, 56).ForSurface(3);
+            const TArray<FVector> Reference = DrawSamples(Random, 1);
+
+            const int32 WorkerCount = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 2);
+            for (const int32 ThreadCount : {2, 3, 7, WorkerCount, 64})
+            {
+                const TArray<FVector> Samples = DrawSamples(Random, ThreadCount);
+                bool bIdentical = true;
+                for (int32 Sample = 0; Sample < KSampleCount; Sample++)
+                {
+                    bIdentical &= Samples[Sample] == Reference[Sample];
+                }
+                TestTrue(FString::Printf(TEXT("%i threads give the same samples as 1 thread."), ThreadCount),
+                         bIdentical);
+            }
+        });
+    });
+}
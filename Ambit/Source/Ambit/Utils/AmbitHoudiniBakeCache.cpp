@@ -0,0 +1,259 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitHoudiniBakeCache.h"
+
+#include "HoudiniAsset.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Dom/JsonObject.h"
+
+#include <AmbitUtils/JsonHelpers.h>
+
+namespace
+{
+    // Changing what is cached, or how, must change this so that older entries are missed.
+    const FString KCacheFormatVersion = TEXT("1");
+    const FString KManifestFileName = TEXT("Manifest.json");
+    const FString KFilesKey = TEXT("Files");
+    const FString KFileNameKey = TEXT("FileName");
+    const FString KPlacementsKey = TEXT("Placements");
+    const FString KLocationKey = TEXT("Location");
+    const FString KRotationKey = TEXT("Rotation");
+    const FString KScaleKey = TEXT("Scale");
+
+    template <typename ElementType>
+    void UpdateWithArray(FSHA1& Sha, const TArray<ElementType>& Values)
+    {
+        const int32 Count = Values.Num();
+        Sha.Update(reinterpret_cast<const uint8*>(&Count), sizeof(Count));
+        Sha.Update(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(ElementType));
+    }
+
+    void UpdateWithString(FSHA1& Sha, const FString& Value)
+    {
+        // Include the terminator so that consecutive strings cannot run into each other.
+        Sha.UpdateWithString(*Value, Value.Len() + 1);
+    }
+
+    FString GetHoudiniEngineVersion()
+    {
+        const TSharedPtr<IPlugin> HoudiniPlugin = IPluginManager::Get().FindPlugin(TEXT("HoudiniEngine"));
+        return HoudiniPlugin.IsValid() ? HoudiniPlugin->GetDescriptor().VersionName : FString();
+    }
+}
+
+FAmbitHoudiniBakeCache::FAmbitHoudiniBakeCache(const FString& InDirectory, int32 InMaxEntries)
+    : Directory(InDirectory), MaxEntries(InMaxEntries)
+{
+}
+
+FAmbitHoudiniBakeCache& FAmbitHoudiniBakeCache::Get()
+{
+    static FAmbitHoudiniBakeCache Cache(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Ambit/HoudiniBakeCache")),
+                                        256);
+    return Cache;
+}
+
+FString FAmbitHoudiniBakeCache::MakeKey(const UHoudiniAsset* HDA,
+                                        const TMap<FName, FHoudiniParameterTuple>& Parameters,
+                                        const TArray<FTransform>& InputPoints)
+{
+    FSHA1 Sha;
+    UpdateWithString(Sha, KCacheFormatVersion);
+    UpdateWithString(Sha, GetHoudiniEngineVersion());
+    if (HDA != nullptr && HDA->GetAssetBytes() != nullptr)
+    {
+        Sha.Update(HDA->GetAssetBytes(), HDA->GetAssetBytesCount());
+    }
+
+    TArray<FName> ParameterNames;
+    Parameters.GetKeys(ParameterNames);
+    ParameterNames.Sort(FNameLexicalLess());
+    for (const FName& ParameterName : ParameterNames)
+    {
+        const FHoudiniParameterTuple& Tuple = Parameters[ParameterName];
+        UpdateWithString(Sha, ParameterName.ToString());
+        UpdateWithArray(Sha, Tuple.BoolValues);
+        UpdateWithArray(Sha, Tuple.Int32Values);
+        UpdateWithArray(Sha, Tuple.FloatValues);
+        for (const FString& StringValue : Tuple.StringValues)
+        {
+            UpdateWithString(Sha, StringValue);
+        }
+        for (const FHoudiniPublicAPIFloatRampPoint& Point : Tuple.FloatRampPoints)
+        {
+            const uint8 Interpolation = static_cast<uint8>(Point.Interpolation);
+            Sha.Update(reinterpret_cast<const uint8*>(&Point.Position), sizeof(Point.Position));
+            Sha.Update(reinterpret_cast<const uint8*>(&Point.Value), sizeof(Point.Value));
+            Sha.Update(&Interpolation, sizeof(Interpolation));
+        }
+        for (const FHoudiniPublicAPIColorRampPoint& Point : Tuple.ColorRampPoints)
+        {
+            const uint8 Interpolation = static_cast<uint8>(Point.Interpolation);
+            Sha.Update(reinterpret_cast<const uint8*>(&Point.Position), sizeof(Point.Position));
+            Sha.Update(reinterpret_cast<const uint8*>(&Point.Value), sizeof(Point.Value));
+            Sha.Update(&Interpolation, sizeof(Interpolation));
+        }
+    }
+
+    for (const FTransform& Point : InputPoints)
+    {
+        UpdateWithString(Sha, Point.ToString());
+    }
+
+    Sha.Final();
+    FSHAHash Hash;
+    Sha.GetHash(Hash.Hash);
+    return Hash.ToString();
+}
+
+bool FAmbitHoudiniBakeCache::Restore(const FString& Key, const FString& TargetDirectory,
+                                     TArray<FBakedFile>& OutFiles)
+{
+    OutFiles.Empty();
+    IFileManager& FileManager = IFileManager::Get();
+    const FString EntryDirectory = GetEntryDirectory(Key);
+    const FString ManifestPath = FPaths::Combine(EntryDirectory, KManifestFileName);
+
+    FString ManifestString;
+    const TSharedPtr<FJsonObject> Manifest = FFileHelper::LoadFileToString(ManifestString, *ManifestPath)
+                                                 ? FJsonHelpers::DeserializeJson(ManifestString)
+                                                 : nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* FilesJson = nullptr;
+    if (!Manifest.IsValid() || !Manifest->TryGetArrayField(KFilesKey, FilesJson))
+    {
+        MissCount++;
+        return false;
+    }
+
+    FileManager.MakeDirectory(*TargetDirectory, true);
+    for (const TSharedPtr<FJsonValue>& FileValue : *FilesJson)
+    {
+        const TSharedPtr<FJsonObject> FileJson = FileValue->AsObject();
+        FBakedFile& File = OutFiles.AddDefaulted_GetRef();
+        File.FileName = FileJson->GetStringField(KFileNameKey);
+        for (const TSharedPtr<FJsonValue>& PlacementValue : FileJson->GetArrayField(KPlacementsKey))
+        {
+            const TSharedPtr<FJsonObject> Placement = PlacementValue->AsObject();
+            File.RelativeTransforms.Emplace(
+                FJsonHelpers::DeserializeToRotation(Placement->GetArrayField(KRotationKey)),
+                FJsonHelpers::DeserializeToVector3(Placement->GetArrayField(KLocationKey)),
+                FJsonHelpers::DeserializeToVector3(Placement->GetArrayField(KScaleKey)));
+        }
+
+        const FString CachedPath = FPaths::Combine(EntryDirectory, File.FileName);
+        const FString TargetPath = FPaths::Combine(TargetDirectory, File.FileName);
+        if (FileManager.Copy(*TargetPath, *CachedPath) != COPY_OK)
+        {
+            // A partly removed entry is as good as none; bake again and let Store() replace it.
+            for (const FBakedFile& Restored : OutFiles)
+            {
+                FileManager.Delete(*FPaths::Combine(TargetDirectory, Restored.FileName));
+            }
+            OutFiles.Empty();
+            MissCount++;
+            return false;
+        }
+    }
+
+    // The manifest's time stamp is when the entry was last used.
+    FileManager.SetTimeStamp(*ManifestPath, FDateTime::UtcNow());
+    HitCount++;
+    return true;
+}
+
+void FAmbitHoudiniBakeCache::Store(const FString& Key, const FString& SourceDirectory,
+                                   const TArray<FBakedFile>& Files)
+{
+    IFileManager& FileManager = IFileManager::Get();
+    const FString EntryDirectory = GetEntryDirectory(Key);
+    FileManager.DeleteDirectory(*EntryDirectory, false, true);
+    FileManager.MakeDirectory(*EntryDirectory, true);
+
+    TArray<TSharedPtr<FJsonValue>> FilesJson;
+    FilesJson.Reserve(Files.Num());
+    for (const FBakedFile& File : Files)
+    {
+        const FString SourcePath = FPaths::Combine(SourceDirectory, File.FileName);
+        if (FileManager.Copy(*FPaths::Combine(EntryDirectory, File.FileName), *SourcePath) != COPY_OK)
+        {
+            FileManager.DeleteDirectory(*EntryDirectory, false, true);
+            return;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> PlacementsJson;
+        PlacementsJson.Reserve(File.RelativeTransforms.Num());
+        for (const FTransform& Transform : File.RelativeTransforms)
+        {
+            const TSharedPtr<FJsonObject> Placement = MakeShareable(new FJsonObject);
+            Placement->SetArrayField(KLocationKey, FJsonHelpers::SerializeVector3(Transform.GetLocation()));
+            Placement->SetArrayField(KRotationKey, FJsonHelpers::SerializeRotation(Transform.Rotator()));
+            Placement->SetArrayField(KScaleKey, FJsonHelpers::SerializeVector3(Transform.GetScale3D()));
+            PlacementsJson.Add(MakeShareable(new FJsonValueObject(Placement)));
+        }
+
+        const TSharedPtr<FJsonObject> FileJson = MakeShareable(new FJsonObject);
+        FileJson->SetStringField(KFileNameKey, File.FileName);
+        FileJson->SetArrayField(KPlacementsKey, PlacementsJson);
+        FilesJson.Add(MakeShareable(new FJsonValueObject(FileJson)));
+    }
+
+    const TSharedPtr<FJsonObject> Manifest = MakeShareable(new FJsonObject);
+    Manifest->SetArrayField(KFilesKey, FilesJson);
+    // The manifest is written last, so an entry without one is incomplete and missed.
+    FFileHelper::SaveStringToFile(FJsonHelpers::SerializeJsonCondense(Manifest),
+                                  *FPaths::Combine(EntryDirectory, KManifestFileName));
+
+    Evict();
+}
+
+int32 FAmbitHoudiniBakeCache::NumEntries() const
+{
+    TArray<FString> Entries;
+    IFileManager::Get().FindFiles(Entries, *FPaths::Combine(Directory, TEXT("*")), false, true);
+    return Entries.Num();
+}
+
+void FAmbitHoudiniBakeCache::Evict() const
+{
+    IFileManager& FileManager = IFileManager::Get();
+    TArray<FString> Entries;
+    FileManager.FindFiles(Entries, *FPaths::Combine(Directory, TEXT("*")), false, true);
+    if (Entries.Num() <= MaxEntries)
+    {
+        return;
+    }
+
+    // An entry without a manifest has the minimum time stamp, so it goes first.
+    TArray<TPair<FDateTime, FString>> EntriesByUse;
+    EntriesByUse.Reserve(Entries.Num());
+    for (const FString& Entry : Entries)
+    {
+        const FString EntryDirectory = GetEntryDirectory(Entry);
+        EntriesByUse.Emplace(FileManager.GetTimeStamp(*FPaths::Combine(EntryDirectory, KManifestFileName)),
+                             EntryDirectory);
+    }
+    EntriesByUse.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B)
+    {
+        return A.Key < B.Key;
+    });
+
+    for (int32 i = 0; i < EntriesByUse.Num() - MaxEntries; i++)
+    {
+        FileManager.DeleteDirectory(*EntriesByUse[i].Value, false, true);
+    }
+}
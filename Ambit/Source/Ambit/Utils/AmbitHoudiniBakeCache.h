@@ -0,0 +1,110 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HoudiniEngineEditor/Public/HoudiniPublicAPIAssetWrapper.h"
+
+class UHoudiniAsset;
+
+/**
+ * A persistent cache of Houdini bakes, addressed by what decides their result: the contents of
+ * the HDA, its resolved parameters, its input points and the version of Houdini Engine.
+ * An asset instance whose key is cached does not need to be cooked or baked again;
+ * its baked packages are copied back from the cache instead.
+ *
+ * Each entry is a directory named after its key that holds the baked package files and a manifest
+ * of where their objects were placed. Once there are more than MaxEntries entries,
+ * the least recently used ones are removed.
+ */
+class FAmbitHoudiniBakeCache
+{
+public:
+    /**
+     * A package baked by one asset instance.
+     */
+    struct FBakedFile
+    {
+        // The name of the package file in the bake directory, such as "sample_cube_1.uasset".
+        FString FileName;
+
+        // Where the objects of the package were placed, relative to the transform of the asset instance.
+        TArray<FTransform> RelativeTransforms;
+    };
+
+    /**
+     * @param InDirectory
+     *  the directory to keep the entries in
+     * @param InMaxEntries
+     *  the number of entries to keep before evicting the least recently used ones
+     */
+    FAmbitHoudiniBakeCache(const FString& InDirectory, int32 InMaxEntries);
+
+    /**
+     * Returns the cache shared by every spawner, kept in the project's Saved directory.
+     */
+    static FAmbitHoudiniBakeCache& Get();
+
+    /**
+     * Returns the key of the bake of HDA with Parameters and InputPoints.
+     * The order of Parameters does not matter.
+     */
+    static FString MakeKey(const UHoudiniAsset* HDA, const TMap<FName, FHoudiniParameterTuple>& Parameters,
+                           const TArray<FTransform>& InputPoints);
+
+    /**
+     * Copies the packages cached for Key into TargetDirectory and marks the entry as used.
+     *
+     * @return true on a hit; false, leaving OutFiles empty, on a miss.
+     */
+    bool Restore(const FString& Key, const FString& TargetDirectory, TArray<FBakedFile>& OutFiles);
+
+    /**
+     * Copies Files from SourceDirectory into the entry for Key, replacing any earlier entry,
+     * then evicts the least recently used entries beyond MaxEntries.
+     */
+    void Store(const FString& Key, const FString& SourceDirectory, const TArray<FBakedFile>& Files);
+
+    /**
+     * Returns the number of entries in the cache directory.
+     */
+    int32 NumEntries() const;
+
+    int32 GetHitCount() const
+    {
+        return HitCount;
+    }
+
+    int32 GetMissCount() const
+    {
+        return MissCount;
+    }
+
+private:
+    /**
+     * Removes the least recently used entries until at most MaxEntries remain.
+     */
+    void Evict() const;
+
+    FString GetEntryDirectory(const FString& Key) const
+    {
+        return FPaths::Combine(Directory, Key);
+    }
+
+    FString Directory;
+    int32 MaxEntries;
+    int32 HitCount = 0;
+    int32 MissCount = 0;
+};
@@ -0,0 +1,156 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitHoudiniBakeCache.h"
+
+#include "HoudiniAsset.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+
+BEGIN_DEFINE_SPEC(AmbitHoudiniBakeCacheSpec, "Ambit.Unit.AmbitHoudiniBakeCache",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    const FString CacheDirectory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AmbitBakeCache"));
+    const FString BakeDirectory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AmbitBake"));
+    const FString RestoreDirectory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AmbitBakeRestore"));
+    UHoudiniAsset* SampleCubeHDA;
+    TMap<FName, FHoudiniParameterTuple> Parameters;
+
+    TArray<FAmbitHoudiniBakeCache::FBakedFile> Bake(const FString& FileName) const
+    {
+        FFileHelper::SaveStringToFile(FileName, *FPaths::Combine(BakeDirectory, FileName));
+        FAmbitHoudiniBakeCache::FBakedFile File;
+        File.FileName = FileName;
+        File.RelativeTransforms.Emplace(FRotator(0, 90, 0), FVector(100, 0, 0), FVector(2));
+        return {File};
+    }
+
+    void SetLastUse(const FString& Key, const FTimespan& Age) const
+    {
+        IFileManager::Get().SetTimeStamp(*FPaths::Combine(CacheDirectory, Key, TEXT("Manifest.json")),
+                                         FDateTime::UtcNow() - Age);
+    }
+END_DEFINE_SPEC(AmbitHoudiniBakeCacheSpec)
+
+void AmbitHoudiniBakeCacheSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        SampleCubeHDA = Cast<UHoudiniAsset>(StaticLoadObject(
+            UHoudiniAsset::StaticClass(), nullptr,
+            TEXT("HoudiniAsset'/Ambit/Test/Props/sample_cube.sample_cube'")));
+
+        Parameters.Empty();
+        FHoudiniParameterTuple Seed;
+        Seed.FloatValues.Add(78.2120209f);
+        Parameters.Add("random_seed", Seed);
+        FHoudiniParameterTuple Count;
+        Count.Int32Values.Add(3);
+        Parameters.Add("count", Count);
+    });
+
+    Describe("MakeKey()", [this]()
+    {
+        It("Should return the same key for the same bake", [this]()
+        {
+            TestEqual("Key", FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Parameters, {}),
+                      FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Parameters, {}));
+        });
+
+        It("Should not depend on the order of the parameters", [this]()
+        {
+            TMap<FName, FHoudiniParameterTuple> Reordered;
+            Reordered.Add("count", Parameters["count"]);
+            Reordered.Add("random_seed", Parameters["random_seed"]);
+
+            TestEqual("Key", FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Reordered, {}),
+                      FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Parameters, {}));
+        });
+
+        It("Should change with the HDA, a parameter value or the input points", [this]()
+        {
+            const FString Key = FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Parameters, {});
+
+            TMap<FName, FHoudiniParameterTuple> Reseeded = Parameters;
+            Reseeded["random_seed"].FloatValues[0] = 38.0790367f;
+
+            TestNotEqual("Other HDA", FAmbitHoudiniBakeCache::MakeKey(nullptr, Parameters, {}), Key);
+            TestNotEqual("Other parameter value", FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Reseeded, {}), Key);
+            TestNotEqual("Input points",
+                         FAmbitHoudiniBakeCache::MakeKey(SampleCubeHDA, Parameters, {FTransform(FVector(0, 0, 1))}),
+                         Key);
+        });
+    });
+
+    Describe("Restore() and Store()", [this]()
+    {
+        It("Should miss a key that was never stored", [this]()
+        {
+            FAmbitHoudiniBakeCache Cache(CacheDirectory, 4);
+            TArray<FAmbitHoudiniBakeCache::FBakedFile> Files;
+
+            TestFalse("Hit", Cache.Restore("Missing", RestoreDirectory, Files));
+            TestEqual("Files", Files.Num(), 0);
+            TestEqual("Hits", Cache.GetHitCount(), 0);
+            TestEqual("Misses", Cache.GetMissCount(), 1);
+        });
+
+        It("Should restore a stored bake and its placements", [this]()
+        {
+            FAmbitHoudiniBakeCache Cache(CacheDirectory, 4);
+            const TArray<FAmbitHoudiniBakeCache::FBakedFile> Baked = Bake("Cube.uasset");
+            Cache.Store("A", BakeDirectory, Baked);
+
+            TArray<FAmbitHoudiniBakeCache::FBakedFile> Files;
+            TestTrue("Hit", Cache.Restore("A", RestoreDirectory, Files));
+            TestEqual("Hits", Cache.GetHitCount(), 1);
+            TestEqual("Misses", Cache.GetMissCount(), 0);
+            TestTrue("Restored file",
+                     IFileManager::Get().FileExists(*FPaths::Combine(RestoreDirectory, TEXT("Cube.uasset"))));
+            if (TestEqual("Files", Files.Num(), 1) && TestEqual("Placements", Files[0].RelativeTransforms.Num(), 1))
+            {
+                TestEqual("File name", Files[0].FileName, Baked[0].FileName);
+                TestTrue("Placement", Files[0].RelativeTransforms[0].Equals(Baked[0].RelativeTransforms[0], 0.01f));
+            }
+        });
+
+        It("Should evict the least recently used entries", [this]()
+        {
+            FAmbitHoudiniBakeCache Cache(CacheDirectory, 2);
+            Cache.Store("A", BakeDirectory, Bake("A.uasset"));
+            Cache.Store("B", BakeDirectory, Bake("B.uasset"));
+            SetLastUse("A", FTimespan::FromHours(2));
+            SetLastUse("B", FTimespan::FromHours(1));
+
+            TArray<FAmbitHoudiniBakeCache::FBakedFile> Files;
+            Cache.Restore("A", RestoreDirectory, Files);
+            Cache.Store("C", BakeDirectory, Bake("C.uasset"));
+
+            TestEqual("Entries", Cache.NumEntries(), 2);
+            TestTrue("A was used last", Cache.Restore("A", RestoreDirectory, Files));
+            TestFalse("B was evicted", Cache.Restore("B", RestoreDirectory, Files));
+            TestTrue("C was stored last", Cache.Restore("C", RestoreDirectory, Files));
+            TestEqual("Hits", Cache.GetHitCount(), 3);
+            TestEqual("Misses", Cache.GetMissCount(), 1);
+        });
+    });
+
+    AfterEach([this]()
+    {
+        IFileManager::Get().DeleteDirectory(*CacheDirectory, false, true);
+        IFileManager::Get().DeleteDirectory(*BakeDirectory, false, true);
+        IFileManager::Get().DeleteDirectory(*RestoreDirectory, false, true);
+    });
+}
@@ -0,0 +1,222 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitMeshSampler.h"
+
+#include "StaticMeshResources.h"
+#include "Algo/BinarySearch.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ObjectKey.h"
+
+#include "Ambit/AmbitModule.h"
+
+namespace
+{
+    // Triangles whose normal has a smaller Z component are treated as walls or ceilings.
+    constexpr float KMinUpwardNormalZ = KINDA_SMALL_NUMBER;
+
+    // Guards TriangleTableCache, which spawners also read while regenerating on worker threads.
+    FCriticalSection TriangleTableCacheLock;
+    TMap<TPair<FObjectKey, int32>, AmbitMeshSampler::FMeshTriangleTablePtr> TriangleTableCache;
+
+    AmbitMeshSampler::FMeshTriangleTablePtr BuildTriangleTable(const FStaticMeshRenderData* RenderData,
+                                                                             int32 LODIndex)
+    {
+        const FStaticMeshLODResources& LOD = RenderData->LODResources[LODIndex];
+        const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+        const FStaticMeshVertexBuffer& Vertices = LOD.VertexBuffers.StaticMeshVertexBuffer;
+        const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+        if (Positions.GetNumVertices() == 0 || Indices.Num() == 0)
+        {
+            return nullptr;
+        }
+
+        TSharedPtr<AmbitMeshSampler::FMeshTriangleTable, ESPMode::ThreadSafe> Table =
+            MakeShared<AmbitMeshSampler::FMeshTriangleTable, ESPMode::ThreadSafe>();
+        Table->SourceRenderData = RenderData;
+
+        float RunningArea = 0.f;
+        for (const FStaticMeshSection& Section : LOD.Sections)
+        {
+            for (uint32 Triangle = 0; Triangle < Section.NumTriangles; Triangle++)
+            {
+                const uint32 FirstIndex = Section.FirstIndex + Triangle * 3;
+                const uint32 I0 = Indices[FirstIndex];
+                const uint32 I1 = Indices[FirstIndex + 1];
+                const uint32 I2 = Indices[FirstIndex + 2];
+                const FVector A = Positions.VertexPosition(I0);
+                const FVector B = Positions.VertexPosition(I1);
+                const FVector C = Positions.VertexPosition(I2);
+
+                const FVector Cross = FVector::CrossProduct(B - C, A - C);
+                const float TriangleArea = Cross.Size() * 0.5f;
+                if (TriangleArea <= SMALL_NUMBER)
+                {
+                    // Degenerate triangles cannot be sampled.
+                    continue;
+                }
+
+                // The winding order depends on the importer,
+                // so orient the face normal to agree with the authored vertex normals.
+                FVector Normal = Cross / (TriangleArea * 2.f);
+                const FVector VertexNormal = FVector(Vertices.VertexTangentZ(I0)) + FVector(Vertices.VertexTangentZ(I1))
+                    + FVector(Vertices.VertexTangentZ(I2));
+                if (FVector::DotProduct(Normal, VertexNormal) < 0.f)
+                {
+                    Normal = -Normal;
+                }
+
+                const int32 Index = Table->Normals.Add(Normal);
+                Table->Corners.Add(A);
+                Table->Corners.Add(B);
+                Table->Corners.Add(C);
+
+                if (Normal.Z > KMinUpwardNormalZ)
+                {
+                    RunningArea += TriangleArea;
+                    Table->UpwardTriangles.Add(Index);
+                    Table->UpwardCdf.Add(RunningArea);
+                }
+            }
+        }
+        return Table;
+    }
+}
+
+AmbitMeshSampler::FMeshTriangleTablePtr AmbitMeshSampler::GetTriangleTable(
+    const UStaticMesh* Mesh, int32 LODIndex)
+{
+    if (!IsValid(Mesh))
+    {
+        return nullptr;
+    }
+
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (RenderData == nullptr || !RenderData->LODResources.IsValidIndex(LODIndex))
+    {
+        return nullptr;
+    }
+
+    const TPair<FObjectKey, int32> Key(FObjectKey(Mesh), LODIndex);
+    FScopeLock Lock(&TriangleTableCacheLock);
+    const FMeshTriangleTablePtr* Cached = TriangleTableCache.Find(Key);
+    if (Cached != nullptr && Cached->IsValid() && (*Cached)->SourceRenderData == RenderData)
+    {
+        return *Cached;
+    }
+
+    FMeshTriangleTablePtr Table = BuildTriangleTable(RenderData, LODIndex);
+    if (Table.IsValid())
+    {
+        TriangleTableCache.Add(Key, Table);
+    }
+    else
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("%s has no triangles that can be read on the CPU."), *Mesh->GetName());
+        TriangleTableCache.Remove(Key);
+    }
+    return Table;
+}
+
+void AmbitMeshSampler::ClearTriangleTableCache()
+{
+    FScopeLock Lock(&TriangleTableCacheLock);
+    TriangleTableCache.Empty();
+}
+
+bool AmbitMeshSampler::FComponentSampler::Initialize(const UStaticMeshComponent* Component, int32 LODIndex)
+{
+    Area = 0.f;
+    WorldTriangles.Empty();
+    WorldCdf.Empty();
+
+    // Instances each have their own transform and are not supported.
+    if (!IsValid(Component) || Component->IsA<UInstancedStaticMeshComponent>())
+    {
+        return false;
+    }
+
+    Table = GetTriangleTable(Component->GetStaticMesh(), LODIndex);
+    if (!Table.IsValid())
+    {
+        return false;
+    }
+
+    ComponentTransform = Component->GetComponentTransform();
+    const FVector Scale = ComponentTransform.GetScale3D();
+    const bool bUniformScale = Scale.X > 0.f && Scale.IsUniform();
+    const bool bYawOnly = FMath::IsNearlyEqual(ComponentTransform.GetRotation().GetUpVector().Z, 1.f);
+
+    if (bUniformScale && bYawOnly)
+    {
+        // Uniform scaling and yaw rotation keep every normal's Z component and scale
+        // every area by the same factor, so the cached distribution can be used as is.
+        bUsesTableCdf = true;
+        AreaScale = Scale.X * Scale.X;
+        Area = Table->UpwardArea() * AreaScale;
+        return Area > 0.f;
+    }
+
+    // Any other transform changes which triangles face upward and their relative areas.
+    bUsesTableCdf = false;
+    AreaScale = 1.f;
+    float RunningArea = 0.f;
+    for (int32 Triangle = 0; Triangle < Table->NumTriangles(); Triangle++)
+    {
+        if (GetWorldNormal(Triangle).Z <= KMinUpwardNormalZ)
+        {
+            continue;
+        }
+
+        const FVector A = ComponentTransform.TransformPosition(Table->Corners[Triangle * 3]);
+        const FVector B = ComponentTransform.TransformPosition(Table->Corners[Triangle * 3 + 1]);
+        const FVector C = ComponentTransform.TransformPosition(Table->Corners[Triangle * 3 + 2]);
+        RunningArea += FVector::CrossProduct(B - A, C - A).Size() * 0.5f;
+        WorldTriangles.Add(Triangle);
+        WorldCdf.Add(RunningArea);
+    }
+    Area = RunningArea;
+    return Area > 0.f;
+}
+
+void AmbitMeshSampler::FComponentSampler::Sample(float AreaValue, float U, float V, FVector& OutLocation,
+                                                 FVector& OutNormal) const
+{
+    const TArray<float>& Cdf = bUsesTableCdf ? Table->UpwardCdf : WorldCdf;
+    const TArray<int32>& Triangles = bUsesTableCdf ? Table->UpwardTriangles : WorldTriangles;
+
+    const int32 CdfIndex = FMath::Min(Algo::UpperBound(Cdf, AreaValue / AreaScale), Cdf.Num() - 1);
+    const int32 Triangle = Triangles[CdfIndex];
+
+    // Uniform barycentric coordinates; the square root keeps points from clustering at the first corner.
+    const float SqrtU = FMath::Sqrt(U);
+    const FVector& A = Table->Corners[Triangle * 3];
+    const FVector& B = Table->Corners[Triangle * 3 + 1];
+    const FVector& C = Table->Corners[Triangle * 3 + 2];
+    const FVector LocalLocation = A * (1.f - SqrtU) + B * (SqrtU * (1.f - V)) + C * (SqrtU * V);
+
+    OutLocation = ComponentTransform.TransformPosition(LocalLocation);
+    OutNormal = GetWorldNormal(Triangle);
+}
+
+FVector AmbitMeshSampler::FComponentSampler::GetWorldNormal(int32 Triangle) const
+{
+    // Normals transform by the inverse transpose, which for a TRS transform
+    // is the rotation applied to the normal divided by the scale.
+    const FVector LocalNormal = Table->Normals[Triangle] * ComponentTransform.GetScale3D().Reciprocal();
+    return ComponentTransform.GetRotation().RotateVector(LocalNormal).GetSafeNormal();
+}
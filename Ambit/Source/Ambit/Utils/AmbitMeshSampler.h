@@ -0,0 +1,145 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+class FStaticMeshRenderData;
+
+/**
+ * Helpers that sample points directly from the triangles of static meshes,
+ * weighted by triangle area, so that no scene queries are needed.
+ */
+namespace AmbitMeshSampler
+{
+    /**
+     * The triangles of one LOD of a static mesh, in the mesh's local space.
+     * Tables are built once per mesh and LOD and shared by every component
+     * using that mesh.
+     */
+    struct FMeshTriangleTable
+    {
+        // Three corners per triangle.
+        TArray<FVector> Corners;
+
+        // The face normal of each triangle, oriented to agree with the vertex normals.
+        TArray<FVector> Normals;
+
+        // The indices of the triangles whose normal points upward.
+        TArray<int32> UpwardTriangles;
+
+        // Running total of the area of UpwardTriangles, in cm^2.
+        TArray<float> UpwardCdf;
+
+        // The render data the table was built from. Used to detect reimports.
+        const FStaticMeshRenderData* SourceRenderData = nullptr;
+
+        int32 NumTriangles() const
+        {
+            return Normals.Num();
+        }
+
+        float UpwardArea() const
+        {
+            return UpwardCdf.Num() > 0 ? UpwardCdf.Last() : 0.f;
+        }
+    };
+
+    // Tables are shared with worker threads, so their reference count is thread-safe.
+    using FMeshTriangleTablePtr = TSharedPtr<const FMeshTriangleTable, ESPMode::ThreadSafe>;
+
+    /**
+     * Returns the triangle table for the given mesh and LOD, building and caching it
+     * on first use. Returns nullptr if the mesh has no CPU-accessible render data.
+     * Safe to call from any thread.
+     *
+     * @param Mesh
+     *  the static mesh to read triangles from
+     * @param LODIndex
+     *  the LOD to read triangles from
+     */
+    FMeshTriangleTablePtr GetTriangleTable(const UStaticMesh* Mesh, int32 LODIndex = 0);
+
+    /**
+     * Drops every cached triangle table.
+     */
+    void ClearTriangleTableCache();
+
+    /**
+     * Samples the upward-facing surface of one static mesh component in world space.
+     */
+    struct FComponentSampler
+    {
+        /**
+         * Prepares this sampler for the given component.
+         *
+         * @param Component
+         *  the component to sample
+         * @param LODIndex
+         *  the LOD to read triangles from
+         * @return
+         *  true if the component has upward-facing triangles to sample
+         */
+        bool Initialize(const UStaticMeshComponent* Component, int32 LODIndex = 0);
+
+        /**
+         * Returns the upward-facing world area of the component, in cm^2.
+         */
+        float GetArea() const
+        {
+            return Area;
+        }
+
+        /**
+         * Maps three uniform random values onto a uniformly distributed
+         * point of the component's upward-facing surface.
+         *
+         * @param AreaValue
+         *  a value in [0, GetArea()) that selects the triangle
+         * @param U
+         *  a value in [0, 1]
+         * @param V
+         *  a value in [0, 1]
+         * @param OutLocation
+         *  the world location of the sample
+         * @param OutNormal
+         *  the world normal of the triangle the sample is on
+         */
+        void Sample(float AreaValue, float U, float V, FVector& OutLocation, FVector& OutNormal) const;
+
+    private:
+        FMeshTriangleTablePtr Table;
+
+        FTransform ComponentTransform;
+
+        float Area = 0.f;
+
+        // When the component has a uniform scale and only yaw rotation, the cached
+        // local-space distribution is reused and scaled by AreaScale.
+        bool bUsesTableCdf = false;
+
+        float AreaScale = 1.f;
+
+        // Otherwise, the distribution is rebuilt in world space.
+        TArray<int32> WorldTriangles;
+
+        TArray<float> WorldCdf;
+
+        FVector GetWorldNormal(int32 Triangle) const;
+    };
+}
@@ -0,0 +1,167 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitMeshSampler.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "Ambit/AmbitModule.h"
+
+BEGIN_DEFINE_SPEC(AmbitMeshSamplerSpec, "Ambit.Unit.AmbitMeshSampler",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UStaticMesh* PlaneMesh;
+    UStaticMesh* CubeMesh;
+    AStaticMeshActor* TestSurfaceActor;
+
+    // Draws a few samples spread over the whole surface of Sampler.
+    TArray<TPair<FVector, FVector>> DrawSamples(const AmbitMeshSampler::FComponentSampler& Sampler) const
+    {
+        TArray<TPair<FVector, FVector>> Samples;
+        const int32 Steps = 8;
+        for (int32 i = 0; i < Steps; i++)
+        {
+            FVector Location;
+            FVector Normal;
+            const float Fraction = (i + 0.5f) / Steps;
+            Sampler.Sample(Sampler.GetArea() * Fraction, Fraction, 1.f - Fraction, Location, Normal);
+            Samples.Emplace(Location, Normal);
+        }
+        return Samples;
+    }
+END_DEFINE_SPEC(AmbitMeshSamplerSpec)
+
+void AmbitMeshSamplerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'"));
+        CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        TestNotNull("Check if the plane mesh is properly loaded", PlaneMesh);
+        TestNotNull("Check if the cube mesh is properly loaded", CubeMesh);
+
+        TestSurfaceActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform::Identity);
+        TestNotNull("Check if surface actor is properly created", TestSurfaceActor);
+        TestSurfaceActor->SetMobility(EComponentMobility::Movable);
+    });
+
+    Describe("GetTriangleTable()", [this]()
+    {
+        It("returns nullptr for an invalid mesh", [this]()
+        {
+            TestFalse("The table is not valid.", AmbitMeshSampler::GetTriangleTable(nullptr).IsValid());
+        });
+
+        It("covers the whole area of the plane", [this]()
+        {
+            const auto& Table = AmbitMeshSampler::GetTriangleTable(PlaneMesh);
+            TestTrue("The table is valid.", Table.IsValid());
+            TestEqual("The upward area is 100 cm by 100 cm.", Table->UpwardArea(), 10000.f, 1.f);
+        });
+
+        It("only counts the top face of the cube as upward", [this]()
+        {
+            const auto& Table = AmbitMeshSampler::GetTriangleTable(CubeMesh);
+            TestTrue("The table is valid.", Table.IsValid());
+            TestEqual("The cube has 12 triangles.", Table->NumTriangles(), 12);
+            TestEqual("The upward area is one face.", Table->UpwardArea(), 10000.f, 1.f);
+        });
+
+        It("returns the cached table on the second call", [this]()
+        {
+            const auto& First = AmbitMeshSampler::GetTriangleTable(CubeMesh);
+            const auto& Second = AmbitMeshSampler::GetTriangleTable(CubeMesh);
+            TestTrue("Both calls return the same table.", First == Second);
+
+            AmbitMeshSampler::ClearTriangleTableCache();
+            const auto& Rebuilt = AmbitMeshSampler::GetTriangleTable(CubeMesh);
+            TestTrue("Clearing the cache rebuilds the table.", First != Rebuilt);
+        });
+    });
+
+    Describe("FComponentSampler", [this]()
+    {
+        It("cannot be initialized without a component", [this]()
+        {
+            AmbitMeshSampler::FComponentSampler Sampler;
+            TestFalse("Initialization fails.", Sampler.Initialize(nullptr));
+        });
+
+        It("scales the area of a uniformly scaled, yawed plane", [this]()
+        {
+            TestSurfaceActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+            TestSurfaceActor->SetActorTransform(FTransform(FRotator(0, 30, 0), FVector(0, 0, 20), FVector(3)));
+
+            AmbitMeshSampler::FComponentSampler Sampler;
+            TestTrue("Initialization succeeds.", Sampler.Initialize(TestSurfaceActor->GetStaticMeshComponent()));
+            TestEqual("The area is 300 cm by 300 cm.", Sampler.GetArea(), 90000.f, 10.f);
+
+            const FBox Bounds = TestSurfaceActor->GetComponentsBoundingBox().ExpandBy(1.f);
+            for (const TPair<FVector, FVector>& Sample : DrawSamples(Sampler))
+            {
+                TestTrue("The sample is inside the plane's bounds.", Bounds.IsInside(Sample.Key));
+                TestEqual("The sample is on the plane.", Sample.Key.Z, 20.f, 0.01f);
+                TestEqual("The normal points up.", Sample.Value.Z, 1.f, 0.001f);
+            }
+        });
+
+        It("handles non-uniform scale", [this]()
+        {
+            TestSurfaceActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+            TestSurfaceActor->SetActorScale3D(FVector(2, 3, 1));
+
+            AmbitMeshSampler::FComponentSampler Sampler;
+            TestTrue("Initialization succeeds.", Sampler.Initialize(TestSurfaceActor->GetStaticMeshComponent()));
+            TestEqual("The area is 200 cm by 300 cm.", Sampler.GetArea(), 60000.f, 10.f);
+        });
+
+        It("samples the face that points up after the mesh is turned over", [this]()
+        {
+            TestSurfaceActor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+            TestSurfaceActor->SetActorTransform(FTransform(FRotator(0, 0, 180), FVector(0, 0, 0)));
+
+            AmbitMeshSampler::FComponentSampler Sampler;
+            TestTrue("Initialization succeeds.", Sampler.Initialize(TestSurfaceActor->GetStaticMeshComponent()));
+            TestEqual("The upward area is one face.", Sampler.GetArea(), 10000.f, 1.f);
+
+            const float Top = TestSurfaceActor->GetComponentsBoundingBox().Max.Z;
+            for (const TPair<FVector, FVector>& Sample : DrawSamples(Sampler))
+            {
+                TestEqual("The sample is on the top face.", Sample.Key.Z, Top, 0.01f);
+                TestEqual("The normal points up.", Sample.Value.Z, 1.f, 0.001f);
+            }
+        });
+
+        It("has no upward area when a plane is turned upside down", [this]()
+        {
+            TestSurfaceActor->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+            TestSurfaceActor->SetActorRotation(FRotator(0, 0, 180));
+
+            AmbitMeshSampler::FComponentSampler Sampler;
+            TestFalse("Initialization fails.", Sampler.Initialize(TestSurfaceActor->GetStaticMeshComponent()));
+        });
+    });
+}
@@ -0,0 +1,161 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPlacementBroadphase.h"
+
+namespace
+{
+    // Footprints that penetrate each other by less than this many cm are treated as touching.
+    constexpr float KPenetrationTolerance = 0.1f;
+}
+
+FAmbitPlacementBroadphase::FAmbitPlacementBroadphase(float CellSize)
+    : CellSize(FMath::Max(CellSize, 1.f))
+{
+}
+
+FAmbitPlacementBroadphase::FFootprint::FFootprint(const FBox& LocalBounds, const FTransform& Transform)
+{
+    const FQuat Rotation = Transform.GetRotation();
+    Center = Transform.TransformPosition(LocalBounds.GetCenter());
+    Axes[0] = Rotation.GetAxisX();
+    Axes[1] = Rotation.GetAxisY();
+    Axes[2] = Rotation.GetAxisZ();
+    Extent = LocalBounds.GetExtent() * Transform.GetScale3D().GetAbs();
+    WorldBounds = LocalBounds.TransformBy(Transform);
+}
+
+bool FAmbitPlacementBroadphase::FFootprint::Intersects(const FFootprint& Other) const
+{
+    if (!WorldBounds.Intersect(Other.WorldBounds))
+    {
+        return false;
+    }
+
+    // Separating axis test between two oriented boxes (Gottschalk et al.):
+    // the face normals of both boxes and the nine cross products of their edges.
+    float R[3][3];
+    float AbsR[3][3];
+    for (int32 i = 0; i < 3; i++)
+    {
+        for (int32 j = 0; j < 3; j++)
+        {
+            R[i][j] = FVector::DotProduct(Axes[i], Other.Axes[j]);
+            // The epsilon keeps near-parallel edges from producing a false separating axis.
+            AbsR[i][j] = FMath::Abs(R[i][j]) + KINDA_SMALL_NUMBER;
+        }
+    }
+
+    const FVector Offset = Other.Center - Center;
+    const float T[3] = {
+        FVector::DotProduct(Offset, Axes[0]),
+        FVector::DotProduct(Offset, Axes[1]),
+        FVector::DotProduct(Offset, Axes[2])
+    };
+    const float A[3] = {Extent.X, Extent.Y, Extent.Z};
+    const float B[3] = {Other.Extent.X, Other.Extent.Y, Other.Extent.Z};
+
+    auto IsSeparated = [](float Distance, float RadiusA, float RadiusB)
+    {
+        return FMath::Abs(Distance) > RadiusA + RadiusB - KPenetrationTolerance;
+    };
+
+    for (int32 i = 0; i < 3; i++)
+    {
+        if (IsSeparated(T[i], A[i], B[0] * AbsR[i][0] + B[1] * AbsR[i][1] + B[2] * AbsR[i][2]))
+        {
+            return false;
+        }
+    }
+
+    for (int32 j = 0; j < 3; j++)
+    {
+        const float Distance = T[0] * R[0][j] + T[1] * R[1][j] + T[2] * R[2][j];
+        if (IsSeparated(Distance, A[0] * AbsR[0][j] + A[1] * AbsR[1][j] + A[2] * AbsR[2][j], B[j]))
+        {
+            return false;
+        }
+    }
+
+    for (int32 i = 0; i < 3; i++)
+    {
+        const int32 I1 = (i + 1) % 3;
+        const int32 I2 = (i + 2) % 3;
+        for (int32 j = 0; j < 3; j++)
+        {
+            const int32 J1 = (j + 1) % 3;
+            const int32 J2 = (j + 2) % 3;
+            const float Distance = T[I2] * R[I1][j] - T[I1] * R[I2][j];
+            const float RadiusA = A[I1] * AbsR[I2][j] + A[I2] * AbsR[I1][j];
+            const float RadiusB = B[J1] * AbsR[i][J2] + B[J2] * AbsR[i][J1];
+            if (IsSeparated(Distance, RadiusA, RadiusB))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FAmbitPlacementBroadphase::Overlaps(const FBox& LocalBounds, const FTransform& Transform) const
+{
+    const FFootprint Candidate(LocalBounds, Transform);
+    const FIntPoint Min = ToCell(Candidate.WorldBounds.Min);
+    const FIntPoint Max = ToCell(Candidate.WorldBounds.Max);
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+            if (Cell == nullptr)
+            {
+                continue;
+            }
+            for (const int32 Index : *Cell)
+            {
+                if (Candidate.Intersects(Footprints[Index]))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void FAmbitPlacementBroadphase::Add(const FBox& LocalBounds, const FTransform& Transform)
+{
+    const int32 Index = Footprints.Emplace(LocalBounds, Transform);
+    const FIntPoint Min = ToCell(Footprints[Index].WorldBounds.Min);
+    const FIntPoint Max = ToCell(Footprints[Index].WorldBounds.Max);
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+        }
+    }
+}
+
+void FAmbitPlacementBroadphase::Reset()
+{
+    Footprints.Empty();
+    Cells.Empty();
+}
+
+FIntPoint FAmbitPlacementBroadphase::ToCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -0,0 +1,89 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A uniform grid over the XY plane holding the oriented footprints of placed obstacles.
+ * Used to reject placements that would overlap an existing obstacle
+ * before paying for a full actor spawn.
+ */
+class FAmbitPlacementBroadphase
+{
+public:
+    /**
+     * @param CellSize
+     *  the size of a grid cell in cm. Works best when close to the size of the largest footprint.
+     */
+    explicit FAmbitPlacementBroadphase(float CellSize = 100.f);
+
+    /**
+     * Checks whether a footprint would penetrate any footprint already added.
+     * Footprints that only touch are not considered overlapping.
+     *
+     * @param LocalBounds
+     *  the bounds of the obstacle in its own space
+     * @param Transform
+     *  where the obstacle would be placed
+     */
+    bool Overlaps(const FBox& LocalBounds, const FTransform& Transform) const;
+
+    /**
+     * Adds the footprint of a placed obstacle.
+     *
+     * @param LocalBounds
+     *  the bounds of the obstacle in its own space
+     * @param Transform
+     *  where the obstacle was placed
+     */
+    void Add(const FBox& LocalBounds, const FTransform& Transform);
+
+    /**
+     * Returns the number of footprints added.
+     */
+    int32 Num() const
+    {
+        return Footprints.Num();
+    }
+
+    /**
+     * Removes every footprint.
+     */
+    void Reset();
+
+private:
+    // An oriented box in world space.
+    struct FFootprint
+    {
+        FVector Center;
+        FVector Axes[3];
+        FVector Extent;
+        FBox WorldBounds;
+
+        FFootprint(const FBox& LocalBounds, const FTransform& Transform);
+
+        bool Intersects(const FFootprint& Other) const;
+    };
+
+    float CellSize;
+
+    TArray<FFootprint> Footprints;
+
+    TMap<FIntPoint, TArray<int32>> Cells;
+
+    FIntPoint ToCell(const FVector& Location) const;
+};
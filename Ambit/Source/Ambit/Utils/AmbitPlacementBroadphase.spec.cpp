@@ -0,0 +1,148 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPlacementBroadphase.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "AmbitSpawnerCollisionHelpers.h"
+#include "AmbitWorldHelpers.h"
+#include "Ambit/AmbitModule.h"
+
+BEGIN_DEFINE_SPEC(AmbitPlacementBroadphaseSpec, "Ambit.Unit.AmbitPlacementBroadphase",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    // A 1m cube resting on the ground, like most obstacle meshes.
+    const FBox CubeBounds = FBox(FVector(-50, -50, 0), FVector(50, 50, 100));
+END_DEFINE_SPEC(AmbitPlacementBroadphaseSpec)
+
+void AmbitPlacementBroadphaseSpec::Define()
+{
+    Describe("Overlaps()", [this]()
+    {
+        It("returns false when there are no footprints", [this]()
+        {
+            const FAmbitPlacementBroadphase Broadphase;
+            TestFalse("No overlap", Broadphase.Overlaps(CubeBounds, FTransform::Identity));
+        });
+
+        It("returns true when the footprints penetrate", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase;
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+            TestTrue("Overlap", Broadphase.Overlaps(CubeBounds, FTransform(FVector(60, 30, 0))));
+        });
+
+        It("returns false when the footprints only touch", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase;
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+            TestFalse("No overlap", Broadphase.Overlaps(CubeBounds, FTransform(FVector(100, 0, 0))));
+        });
+
+        It("uses the orientation of the footprints", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase;
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+
+            // The axis-aligned bounds of these cubes overlap, but the cubes themselves do not.
+            const FTransform Rotated(FRotator(0, 45, 0), FVector(90, 90, 0));
+            TestFalse("No overlap", Broadphase.Overlaps(CubeBounds, Rotated));
+
+            const FTransform Closer(FRotator(0, 45, 0), FVector(80, 80, 0));
+            TestTrue("Overlap", Broadphase.Overlaps(CubeBounds, Closer));
+        });
+
+        It("finds footprints that span several grid cells", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase(10.f);
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+            TestTrue("Overlap", Broadphase.Overlaps(FBox(FVector(-1), FVector(1)), FTransform(FVector(45, -45, 50))));
+        });
+
+        It("returns false for footprints at different heights", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase;
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+            TestFalse("No overlap", Broadphase.Overlaps(CubeBounds, FTransform(FVector(0, 0, 150))));
+        });
+
+        It("returns false after Reset()", [this]()
+        {
+            FAmbitPlacementBroadphase Broadphase;
+            Broadphase.Add(CubeBounds, FTransform::Identity);
+            Broadphase.Reset();
+            TestEqual("No footprints", Broadphase.Num(), 0);
+            TestFalse("No overlap", Broadphase.Overlaps(CubeBounds, FTransform::Identity));
+        });
+    });
+
+    Describe("Benchmark", [this]()
+    {
+        It("reports how many spawns are avoided at high density", [this]()
+        {
+            UWorld* World = FAutomationEditorCommonUtils::CreateNewMap();
+            TestNotNull("Check if World is properly created", World);
+
+            UStaticMesh* PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'"));
+            AStaticMeshActor* Surface = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(),
+                                                                            FTransform::Identity);
+            Surface->SetMobility(EComponentMobility::Movable);
+            Surface->GetStaticMeshComponent()->SetStaticMesh(PlaneMesh);
+            Surface->SetActorScale3D(FVector(50, 50, 1));
+
+            const FSoftClassPath ClassPath("/Ambit/Test/Props/BP_Box01.BP_Box01_C");
+            UClass* ActorToSpawn = ClassPath.TryLoadClass<AActor>();
+            const FBox Footprint = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(ActorToSpawn);
+            TestTrue("The footprint is valid", static_cast<bool>(Footprint.IsValid));
+
+            TArray<AActor*> Surfaces;
+            Surfaces.Add(Surface);
+            // The highest density that does not trigger the spawner's performance warning.
+            const float DensityMax = 3.f;
+            const TArray<FTransform> Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                Surfaces, 0, DensityMax, DensityMax);
+
+            const double StartTime = FPlatformTime::Seconds();
+            FAmbitPlacementBroadphase Broadphase(FMath::Max(Footprint.GetSize().X, Footprint.GetSize().Y));
+            int32 Rejected = 0;
+            for (const FTransform& Transform : Transforms)
+            {
+                if (Broadphase.Overlaps(Footprint, Transform))
+                {
+                    Rejected++;
+                }
+                else
+                {
+                    Broadphase.Add(Footprint, Transform);
+                }
+            }
+            const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+            UE_LOG(LogAmbit, Display,
+                   TEXT("Broadphase: %d placements, %d spawns avoided (%.1f%%), %d survivors, %f s"),
+                   Transforms.Num(), Rejected, 100.f * Rejected / FMath::Max(Transforms.Num(), 1),
+                   Broadphase.Num(), Seconds);
+
+            TestTrue("Placements were generated", Transforms.Num() > 0);
+            TestEqual("Every placement is either rejected or kept", Rejected + Broadphase.Num(), Transforms.Num());
+            TestTrue("Spawns are avoided at high density", Rejected > 0);
+        });
+    });
+}
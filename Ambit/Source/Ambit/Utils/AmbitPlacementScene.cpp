@@ -0,0 +1,186 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPlacementScene.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+#include "AmbitSpawnerCollisionHelpers.h"
+
+namespace
+{
+    // Components are spread over at most this many cells along each side of the scene,
+    // so that large ones, such as the ground, are not added to a cell for every obstacle.
+    constexpr float KMaxCellsPerSide = 64.f;
+
+    // Returns the box that Shape fills at ShapeTransform.
+    FBox GetShapeBounds(const FCollisionShape& Shape, const FTransform& ShapeTransform)
+    {
+        const FVector Extent = Shape.GetExtent();
+        return FBox(-Extent, Extent).TransformBy(ShapeTransform);
+    }
+}
+
+FAmbitPlacementScene::FAmbitPlacementScene(const UWorld* World, const TArray<AActor*>& SurfaceActors,
+                                           const FBox& Bounds, const TArray<const AActor*>& IgnoredActors,
+                                           float ProxyCellSize)
+    : Surface(AmbitWorldHelpers::GetSurfaceComponents(SurfaceActors))
+    , CellSize(FMath::Max(ProxyCellSize, 1.f))
+    , Proxies(ProxyCellSize)
+{
+    if (World == nullptr || !Bounds.IsValid)
+    {
+        return;
+    }
+    const FVector BoundsSize = Bounds.GetSize();
+    CellSize = FMath::Max(CellSize, FMath::Max(BoundsSize.X, BoundsSize.Y) / KMaxCellsPerSide);
+
+    // The only query of the scene that pays for the broadphase of the whole world.
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitPlacementScene));
+    Params.AddIgnoredActors(IgnoredActors);
+    TArray<FOverlapResult> Overlaps;
+    World->OverlapMultiByObjectType(Overlaps, Bounds.GetCenter(), FQuat::Identity,
+                                    FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects),
+                                    FCollisionShape::MakeBox(Bounds.GetExtent()), Params);
+    Components.Reserve(Overlaps.Num());
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        UPrimitiveComponent* Component = Overlap.GetComponent();
+        if (Component == nullptr)
+        {
+            continue;
+        }
+        // Instances have a body each, found by their item index.
+        const FBodyInstance* Body = Component->GetBodyInstance(NAME_None, true, Overlap.ItemIndex);
+        if (Body == nullptr || !Body->IsValidBodyInstance())
+        {
+            continue;
+        }
+        // Only the part of the component within the scene is queried, so only that part is added to cells.
+        const FBox BodyBounds = Body->GetBodyBounds();
+        if (!BodyBounds.Intersect(Bounds))
+        {
+            continue;
+        }
+        const FBox SceneBounds = BodyBounds.Overlap(Bounds);
+        const FIntPoint Min = ToCell(SceneBounds.Min);
+        const FIntPoint Max = ToCell(SceneBounds.Max);
+        const int32 Index = Components.Add({Component, Overlap.ItemIndex, BodyBounds, Min});
+        for (int32 X = Min.X; X <= Max.X; X++)
+        {
+            for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+            {
+                Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+            }
+        }
+    }
+}
+
+FHitResult FAmbitPlacementScene::LineTraceBelow(const FVector& Location) const
+{
+    return AmbitWorldHelpers::LineTraceBelowOnSurface(Location, Surface);
+}
+
+void FAmbitPlacementScene::OverlapMulti(TArray<FOverlapResult>& OutOverlaps, const FCollisionShape& Shape,
+                                        const FTransform& ShapeTransform, ECollisionChannel ObjectType,
+                                        const FCollisionResponseContainer& Responses) const
+{
+    const FBox ShapeBounds = GetShapeBounds(Shape, ShapeTransform);
+    const FIntPoint Min = ToCell(ShapeBounds.Min);
+    const FIntPoint Max = ToCell(ShapeBounds.Max);
+    for (int32 X = Min.X; X <= Max.X; X++)
+    {
+        for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+            if (Cell == nullptr)
+            {
+                continue;
+            }
+            for (const int32 Index : *Cell)
+            {
+                const FSceneComponent& SceneComponent = Components[Index];
+                // A component in several of the cells is only tested in the first one it shares with the shape.
+                if (X != FMath::Max(Min.X, SceneComponent.MinCell.X) || Y != FMath::Max(Min.Y, SceneComponent.MinCell.Y)
+                    || !SceneComponent.Bounds.Intersect(ShapeBounds))
+                {
+                    continue;
+                }
+
+                UPrimitiveComponent* Component = SceneComponent.Component.Get();
+                const FBodyInstance* Body = Component != nullptr
+                                                ? Component->GetBodyInstance(NAME_None, true, SceneComponent.ItemIndex)
+                                                : nullptr;
+                if (Body == nullptr || !Body->IsValidBodyInstance())
+                {
+                    continue;
+                }
+
+                // As in the world, both sides must respond for an overlap, and both must block for a blocking one.
+                const ECollisionResponse ShapeResponse = Responses.GetResponse(Component->GetCollisionObjectType());
+                const ECollisionResponse ComponentResponse = Component->GetCollisionResponseToChannel(ObjectType);
+                if (ShapeResponse == ECR_Ignore || ComponentResponse == ECR_Ignore
+                    || !Body->OverlapTest(ShapeTransform.GetLocation(), ShapeTransform.GetRotation(), Shape))
+                {
+                    continue;
+                }
+
+                FOverlapResult& Overlap = OutOverlaps.AddDefaulted_GetRef();
+                Overlap.Actor = Component->GetOwner();
+                Overlap.Component = Component;
+                Overlap.ItemIndex = SceneComponent.ItemIndex;
+                Overlap.bBlockingHit = ShapeResponse == ECR_Block && ComponentResponse == ECR_Block;
+            }
+        }
+    }
+}
+
+bool FAmbitPlacementScene::OverlapsObstacle(const FSpawnedObstacleCollision& Collision,
+                                            const FTransform& Placement) const
+{
+    if (Proxies.Num() == 0)
+    {
+        return false;
+    }
+
+    const FTransform PlacementWithoutScale(Placement.GetRotation(), Placement.GetLocation());
+    for (const FSpawnedObstacleShape& Shape : Collision.Shapes)
+    {
+        const FVector Extent = Shape.Shape.GetExtent();
+        if (Proxies.Overlaps(FBox(-Extent, Extent), Shape.ActorSpaceTransform * PlacementWithoutScale))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FAmbitPlacementScene::AddObstacle(const FSpawnedObstacleCollision& Collision, const FTransform& Placement)
+{
+    // Each shape is represented by the box around it.
+    const FTransform PlacementWithoutScale(Placement.GetRotation(), Placement.GetLocation());
+    for (const FSpawnedObstacleShape& Shape : Collision.Shapes)
+    {
+        const FVector Extent = Shape.Shape.GetExtent();
+        Proxies.Add(FBox(-Extent, Extent), Shape.ActorSpaceTransform * PlacementWithoutScale);
+    }
+}
+
+FIntPoint FAmbitPlacementScene::ToCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
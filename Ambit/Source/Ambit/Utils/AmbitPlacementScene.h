@@ -0,0 +1,146 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+#include "AmbitPlacementBroadphase.h"
+#include "AmbitWorldHelpers.h"
+
+struct FSpawnedObstacleCollision;
+
+/**
+ * A private collision scene that placements are queried against for the length of a spawn or an export,
+ * instead of the whole world. It holds the surfaces that placements are traced onto, the components
+ * that could block obstacles within the bounds of the placements, and proxies for the obstacles
+ * accepted so far.
+ *
+ * The components are gathered with a single query when the scene is built, so later queries
+ * do not pay for the broadphase over unrelated geometry of the world, such as far away buildings,
+ * foliage and skyboxes. The world must not change while the scene is used, except for
+ * the obstacles that are added to it.
+ *
+ * Components destroyed while the scene is kept, such as between the ticks of a spawn job, are skipped.
+ *
+ * Queries are read-only and can run on several threads at once. Adding obstacles cannot.
+ */
+class FAmbitPlacementScene
+{
+public:
+    /**
+     * @param World
+     *  the world to gather the components from
+     * @param SurfaceActors
+     *  the actors that placements are traced onto
+     * @param Bounds
+     *  the box that every obstacle placed in the scene fits into. Components outside it are left out.
+     * @param IgnoredActors
+     *  actors whose components are left out, such as the obstacles that the placements replace
+     * @param ProxyCellSize
+     *  the size of a cell of the grid that holds the proxies, in cm.
+     *  Works best when close to the size of the largest obstacle.
+     */
+    FAmbitPlacementScene(const UWorld* World, const TArray<AActor*>& SurfaceActors, const FBox& Bounds,
+                         const TArray<const AActor*>& IgnoredActors = TArray<const AActor*>(),
+                         float ProxyCellSize = 100.f);
+
+    /**
+     * Same as AmbitWorldHelpers::LineTraceBelowOnSurface() against the surfaces of the scene.
+     */
+    FHitResult LineTraceBelow(const FVector& Location) const;
+
+    /**
+     * Finds the components of the scene that Shape overlaps, as UWorld::OverlapMultiByChannel() would.
+     * The proxies of obstacles are not included; see OverlapsObstacle().
+     *
+     * @param OutOverlaps
+     *  receives an overlap for each component, or each instance, that Shape overlaps
+     * @param Shape
+     *  the shape to test
+     * @param ShapeTransform
+     *  the location and rotation of Shape
+     * @param ObjectType
+     *  the object type that Shape is tested as
+     * @param Responses
+     *  the responses of Shape to the object types of the components
+     */
+    void OverlapMulti(TArray<FOverlapResult>& OutOverlaps, const FCollisionShape& Shape,
+                      const FTransform& ShapeTransform, ECollisionChannel ObjectType,
+                      const FCollisionResponseContainer& Responses) const;
+
+    /**
+     * Checks whether an obstacle with Collision at Placement would penetrate
+     * an obstacle added with AddObstacle().
+     */
+    bool OverlapsObstacle(const FSpawnedObstacleCollision& Collision, const FTransform& Placement) const;
+
+    /**
+     * Adds a proxy for each shape of an obstacle accepted at Placement. Proxies block every placement
+     * they overlap, so only obstacles that block other spawned obstacles are to be added.
+     */
+    void AddObstacle(const FSpawnedObstacleCollision& Collision, const FTransform& Placement);
+
+    /**
+     * Returns the surfaces of the scene.
+     */
+    const AmbitWorldHelpers::FSurfaceComponents& GetSurface() const
+    {
+        return Surface;
+    }
+
+    /**
+     * Returns the number of components, or instances, gathered from the world.
+     */
+    int32 NumComponents() const
+    {
+        return Components.Num();
+    }
+
+    /**
+     * Returns the number of proxies added for obstacles.
+     */
+    int32 NumProxies() const
+    {
+        return Proxies.Num();
+    }
+
+private:
+    // A component, or an instance of one, gathered from the world.
+    // Its body is looked up again by each query, as it is gone if the component is destroyed.
+    struct FSceneComponent
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        int32 ItemIndex;
+        FBox Bounds;
+
+        // The cell of the grid that holds the lower corner of Bounds within the scene.
+        FIntPoint MinCell;
+    };
+
+    AmbitWorldHelpers::FSurfaceComponents Surface;
+
+    TArray<FSceneComponent> Components;
+
+    // A uniform grid over the XY plane holding the indices of the components in each cell.
+    float CellSize;
+
+    TMap<FIntPoint, TArray<int32>> Cells;
+
+    FAmbitPlacementBroadphase Proxies;
+
+    FIntPoint ToCell(const FVector& Location) const;
+};
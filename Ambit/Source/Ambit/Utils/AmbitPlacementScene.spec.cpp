@@ -0,0 +1,159 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPlacementScene.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "AmbitSpawnerCollisionHelpers.h"
+
+BEGIN_DEFINE_SPEC(AmbitPlacementSceneSpec, "Ambit.Unit.AmbitPlacementScene",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    AStaticMeshActor* Surface;
+    AStaticMeshActor* FarAway;
+    FSpawnedObstacleCollision Collision;
+
+    // A 1m cube whose bottom is at Location.
+    AStaticMeshActor* SpawnCube(const FVector& Location)
+    {
+        UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        AStaticMeshActor* Cube = World->SpawnActor<AStaticMeshActor>(Location + FVector(0, 0, 50),
+                                                                     FRotator::ZeroRotator);
+        Cube->SetMobility(EComponentMobility::Movable);
+        Cube->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+        return Cube;
+    }
+END_DEFINE_SPEC(AmbitPlacementSceneSpec)
+
+void AmbitPlacementSceneSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        // A 10m cube whose top is at the origin, and a cube far from it.
+        Surface = SpawnCube(FVector(0, 0, -550));
+        Surface->SetActorScale3D(FVector(10, 10, 10));
+        FarAway = SpawnCube(FVector(100000, 0, 0));
+
+        const FSoftClassPath ClassPath(TEXT("/Ambit/Test/Props/BP_Box01.BP_Box01_C"));
+        Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(ClassPath.TryLoadClass<AActor>());
+    });
+
+    Describe("FAmbitPlacementScene()", [this]()
+    {
+        It("gathers the components within the bounds only", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            TestEqual("Components", Scene.NumComponents(), 1);
+        });
+
+        It("leaves out the ignored actors", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)), {Surface});
+            TestEqual("Components", Scene.NumComponents(), 0);
+        });
+    });
+
+    Describe("LineTraceBelow()", [this]()
+    {
+        It("hits the surfaces of the scene", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            const FHitResult Hit = Scene.LineTraceBelow(FVector(0, 0, 1000));
+            TestTrue("Hit", Hit.bBlockingHit);
+            TestEqual("Height", Hit.ImpactPoint.Z, 0.f, 0.1f);
+        });
+
+        It("does not hit actors that are not surfaces", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            TestFalse("Hit", Scene.LineTraceBelow(FVector(100000, 0, 1000)).bBlockingHit);
+        });
+    });
+
+    Describe("OverlapMulti()", [this]()
+    {
+        It("finds the components that a shape overlaps", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            TArray<FOverlapResult> Overlaps;
+            Scene.OverlapMulti(Overlaps, FCollisionShape::MakeBox(FVector(10)), FTransform(FVector(0, 0, -5)),
+                               Collision.ObjectType, Collision.PlacementResponses);
+            TestEqual("Overlaps", Overlaps.Num(), 1);
+            TestTrue("Surface", Overlaps.Num() == 1 && Overlaps[0].GetActor() == Surface);
+        });
+
+        It("finds nothing above the components", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            TArray<FOverlapResult> Overlaps;
+            Scene.OverlapMulti(Overlaps, FCollisionShape::MakeBox(FVector(10)), FTransform(FVector(0, 0, 50)),
+                               Collision.ObjectType, Collision.PlacementResponses);
+            TestEqual("Overlaps", Overlaps.Num(), 0);
+        });
+
+        It("finds each component once when the shape spans several cells", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-1000), FVector(1000)), {}, 50.f);
+            TArray<FOverlapResult> Overlaps;
+            Scene.OverlapMulti(Overlaps, FCollisionShape::MakeBox(FVector(300, 300, 10)),
+                               FTransform(FVector(0, 0, -5)), Collision.ObjectType, Collision.PlacementResponses);
+            TestEqual("Overlaps", Overlaps.Num(), 1);
+        });
+
+        It("skips the components destroyed after the scene was built", [this]()
+        {
+            const FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-100), FVector(100)));
+            Surface->Destroy();
+            TArray<FOverlapResult> Overlaps;
+            Scene.OverlapMulti(Overlaps, FCollisionShape::MakeBox(FVector(10)), FTransform(FVector(0, 0, -5)),
+                               Collision.ObjectType, Collision.PlacementResponses);
+            TestEqual("Overlaps", Overlaps.Num(), 0);
+        });
+    });
+
+    Describe("AddObstacle()", [this]()
+    {
+        It("blocks placements that overlap the obstacle", [this]()
+        {
+            FAmbitPlacementScene Scene(World, {Surface}, FBox(FVector(-1000), FVector(1000)));
+            TestTrue("Has shapes", Collision.Shapes.Num() > 0);
+            TestFalse("Overlaps before", Scene.OverlapsObstacle(Collision, FTransform::Identity));
+
+            Scene.AddObstacle(Collision, FTransform::Identity);
+            TestEqual("Proxies", Scene.NumProxies(), Collision.Shapes.Num());
+            TestTrue("Overlaps", Scene.OverlapsObstacle(Collision, FTransform(FVector(1, 1, 0))));
+            TestTrue("Blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(Scene, Collision,
+                                                                               FTransform(FVector(1, 1, 0))));
+            TestFalse("Far away", Scene.OverlapsObstacle(Collision, FTransform(FVector(900, 900, 0))));
+        });
+    });
+
+    AfterEach([this]()
+    {
+        Surface->Destroy();
+        Surface = nullptr;
+        FarAway->Destroy();
+        FarAway = nullptr;
+    });
+}
@@ -0,0 +1,223 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPoissonDisk.h"
+
+#include "Ambit/AmbitModule.h"
+
+namespace
+{
+    // The number of candidates tried around an active point before it is retired.
+    constexpr int32 KMaxAttempts = 30;
+
+    // Beyond this many grid cells the acceleration grid would take hundreds of megabytes.
+    constexpr int64 KMaxGridCells = 1 << 24;
+
+    // How many times Count a maximal set should roughly hold before it is truncated to Count.
+    constexpr float KOversampling = 3.f;
+
+    // Shuffles Items and keeps the first Count of them, so that any prefix is a uniform random subset.
+    template <typename T>
+    void ShuffleAndTruncate(TArray<T>& Items, int32 Count, FRandomStream& Random)
+    {
+        for (int32 i = Items.Num() - 1; i > 0; i--)
+        {
+            Items.Swap(i, Random.RandRange(0, i));
+        }
+        if (Items.Num() > Count)
+        {
+            Items.SetNum(FMath::Max(Count, 0));
+        }
+    }
+
+    // With cells of Spacing / sqrt(2), a cell holds at most one point
+    // and a neighbour closer than Spacing is always within two cells.
+    int64 GetCellCount(float Extent, float Spacing)
+    {
+        return FMath::Max(static_cast<int64>(FMath::CeilToDouble(Extent / (Spacing / UE_SQRT_2))), 1ll);
+    }
+
+    // Fills Points with a maximal Poisson-disk set at Spacing, using Bridson's algorithm.
+    // Returns false, leaving Points empty, if the acceleration grid would be too large.
+    bool GenerateMaximalSet(const FBox2D& Bounds, float Spacing, FRandomStream& Random, TArray<FVector2D>& Points)
+    {
+        const float CellSize = Spacing / UE_SQRT_2;
+        const FVector2D Size = Bounds.GetSize();
+        const int64 ColumnCount = GetCellCount(Size.X, Spacing);
+        const int64 RowCount = GetCellCount(Size.Y, Spacing);
+        if (ColumnCount * RowCount > KMaxGridCells)
+        {
+            return false;
+        }
+
+        const int32 Columns = static_cast<int32>(ColumnCount);
+        const int32 Rows = static_cast<int32>(RowCount);
+        TArray<int32> Grid;
+        Grid.Init(INDEX_NONE, Columns * Rows);
+
+        auto ToCell = [&](const FVector2D& Point)
+        {
+            const int32 X = FMath::Clamp(FMath::FloorToInt((Point.X - Bounds.Min.X) / CellSize), 0, Columns - 1);
+            const int32 Y = FMath::Clamp(FMath::FloorToInt((Point.Y - Bounds.Min.Y) / CellSize), 0, Rows - 1);
+            return FIntPoint(X, Y);
+        };
+
+        auto IsFarEnough = [&](const FVector2D& Point)
+        {
+            const FIntPoint Cell = ToCell(Point);
+            for (int32 Y = FMath::Max(Cell.Y - 2, 0); Y <= FMath::Min(Cell.Y + 2, Rows - 1); Y++)
+            {
+                for (int32 X = FMath::Max(Cell.X - 2, 0); X <= FMath::Min(Cell.X + 2, Columns - 1); X++)
+                {
+                    const int32 Neighbour = Grid[Y * Columns + X];
+                    if (Neighbour != INDEX_NONE && FVector2D::DistSquared(Points[Neighbour], Point) < Spacing * Spacing)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        auto AddPoint = [&](const FVector2D& Point)
+        {
+            const int32 Index = Points.Add(Point);
+            const FIntPoint Cell = ToCell(Point);
+            Grid[Cell.Y * Columns + Cell.X] = Index;
+            return Index;
+        };
+
+        TArray<int32> Active;
+        Active.Add(AddPoint(FVector2D(Random.FRandRange(Bounds.Min.X, Bounds.Max.X),
+                                      Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y))));
+        while (Active.Num() > 0)
+        {
+            const int32 ActiveIndex = Random.RandRange(0, Active.Num() - 1);
+            const FVector2D Origin = Points[Active[ActiveIndex]];
+
+            bool bFound = false;
+            for (int32 Attempt = 0; Attempt < KMaxAttempts; Attempt++)
+            {
+                // Candidates are drawn from the annulus between one and two spacings away.
+                const float Angle = Random.FRandRange(0.f, 2.f * PI);
+                const float Radius = Random.FRandRange(Spacing, 2.f * Spacing);
+                const FVector2D Candidate = Origin + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius;
+                if (Bounds.IsInside(Candidate) && IsFarEnough(Candidate))
+                {
+                    Active.Add(AddPoint(Candidate));
+                    bFound = true;
+                    break;
+                }
+            }
+
+            if (!bFound)
+            {
+                Active.RemoveAtSwap(ActiveIndex);
+            }
+        }
+
+        return true;
+    }
+}
+
+TArray<FVector2D> AmbitPoissonDisk::GeneratePoints(const FBox2D& Bounds, float MinSpacing, int32 Count,
+                                                   FRandomStream& Random)
+{
+    TArray<FVector2D> Points;
+    if (Count <= 0 || MinSpacing <= 0.f || !Bounds.bIsValid)
+    {
+        return Points;
+    }
+
+    // A maximal set holds about 0.7 points per square spacing of area, so spreading the points out
+    // to fit a few times Count keeps the cost proportional to Count rather than to the area.
+    // The spacing is tightened again if the bounds are too narrow for that estimate to hold.
+    const FVector2D Size = Bounds.GetSize();
+    float Spacing = FMath::Max(MinSpacing, FMath::Sqrt(Size.X * Size.Y / (KOversampling * Count)));
+    while (true)
+    {
+        Points.Reset();
+        if (!GenerateMaximalSet(Bounds, Spacing, Random, Points))
+        {
+            const int64 CellCount = GetCellCount(Size.X, Spacing) * GetCellCount(Size.Y, Spacing);
+            UE_LOG(LogAmbit, Warning,
+                   TEXT("A spacing of %.1f cm needs %lld grid cells, more than the limit of %lld. "
+                        "Using uniform random locations instead of a minimum spacing of %.1f cm."),
+                   Spacing, CellCount, KMaxGridCells, MinSpacing);
+            for (int32 i = 0; i < Count; i++)
+            {
+                const float X = Random.FRandRange(Bounds.Min.X, Bounds.Max.X);
+                const float Y = Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y);
+                Points.Emplace(X, Y);
+            }
+            return Points;
+        }
+
+        if (Points.Num() >= Count || Spacing <= MinSpacing)
+        {
+            break;
+        }
+        Spacing = FMath::Max(MinSpacing, Spacing / UE_SQRT_2);
+    }
+
+    if (Points.Num() < Count)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("Only %i of %i locations fit at a minimum spacing of %.1f cm."), Points.Num(),
+               Count, MinSpacing);
+    }
+
+    ShuffleAndTruncate(Points, Count, Random);
+    return Points;
+}
+
+TArray<float> AmbitPoissonDisk::GenerateDistances(float Length, float MinSpacing, int32 Count, FRandomStream& Random)
+{
+    TArray<float> Distances;
+    if (Count <= 0 || MinSpacing <= 0.f || Length < 0.f)
+    {
+        return Distances;
+    }
+
+    // In one dimension a maximal set is a walk whose steps are between one and two
+    // spacings long: every gap is too small to fit another distance. Steps average
+    // 1.5 spacings, so as in GeneratePoints the walk starts at a spacing that holds
+    // a few times Count distances, and the spacing is tightened if it falls short.
+    float Spacing = FMath::Max(MinSpacing, Length / (1.5f * KOversampling * Count));
+    while (true)
+    {
+        Distances.Reset();
+        float Distance = Random.FRandRange(0.f, FMath::Min(Spacing, Length));
+        while (Distance <= Length)
+        {
+            Distances.Add(Distance);
+            Distance += Random.FRandRange(Spacing, 2.f * Spacing);
+        }
+
+        if (Distances.Num() >= Count || Spacing <= MinSpacing)
+        {
+            break;
+        }
+        Spacing = FMath::Max(MinSpacing, Spacing / 2.f);
+    }
+
+    if (Distances.Num() < Count)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("Only %i of %i locations fit along %.1f cm at a minimum spacing of %.1f cm."),
+               Distances.Num(), Count, Length, MinSpacing);
+    }
+
+    ShuffleAndTruncate(Distances, Count, Random);
+    return Distances;
+}
@@ -0,0 +1,61 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Blue-noise samplers that keep every pair of points at least a minimum distance apart.
+ */
+namespace AmbitPoissonDisk
+{
+    /**
+     * Returns up to Count points inside Bounds, no two of which are closer than MinSpacing.
+     * A maximal Poisson-disk set is built with Bridson's grid-accelerated algorithm
+     * and a random subset of it is returned, so the points cover all of Bounds
+     * evenly whatever Count is. The set is built at the widest spacing, never below MinSpacing,
+     * that still holds a few times Count points, so the cost follows Count rather than the area.
+     *
+     * @param Bounds
+     *  the rectangle to place points in
+     * @param MinSpacing
+     *  the minimum distance between two points. Must be greater than 0.
+     * @param Count
+     *  the number of points wanted
+     * @param Random
+     *  the random stream to draw from
+     * @return
+     *  Count points, or fewer if no more fit at MinSpacing
+     */
+    TArray<FVector2D> GeneratePoints(const FBox2D& Bounds, float MinSpacing, int32 Count, FRandomStream& Random);
+
+    /**
+     * Returns up to Count distances in [0, Length], no two of which are closer than MinSpacing,
+     * in random order. The one-dimensional counterpart of GeneratePoints.
+     *
+     * @param Length
+     *  the length of the segment to place distances on
+     * @param MinSpacing
+     *  the minimum difference between two distances. Must be greater than 0.
+     * @param Count
+     *  the number of distances wanted
+     * @param Random
+     *  the random stream to draw from
+     * @return
+     *  Count distances, or fewer if no more fit at MinSpacing
+     */
+    TArray<float> GenerateDistances(float Length, float MinSpacing, int32 Count, FRandomStream& Random);
+}
@@ -0,0 +1,150 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitPoissonDisk.h"
+
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(AmbitPoissonDiskSpec, "Ambit.Unit.AmbitPoissonDisk",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    const FBox2D Bounds = FBox2D(FVector2D(-1000, -1000), FVector2D(1000, 1000));
+    const float MinSpacing = 100.f;
+
+    float GetClosestDistance(const TArray<FVector2D>& Points) const
+    {
+        float Closest = BIG_NUMBER;
+        for (int32 i = 0; i < Points.Num(); i++)
+        {
+            for (int32 j = i + 1; j < Points.Num(); j++)
+            {
+                Closest = FMath::Min(Closest, FVector2D::Distance(Points[i], Points[j]));
+            }
+        }
+        return Closest;
+    }
+END_DEFINE_SPEC(AmbitPoissonDiskSpec)
+
+void AmbitPoissonDiskSpec::Define()
+{
+    Describe("GeneratePoints()", [this]()
+    {
+        It("returns the requested number of points inside the bounds", [this]()
+        {
+            FRandomStream Random(0);
+            const TArray<FVector2D> Points = AmbitPoissonDisk::GeneratePoints(Bounds, MinSpacing, 100, Random);
+            TestEqual("The number of points", Points.Num(), 100);
+            for (const FVector2D& Point : Points)
+            {
+                TestTrue("The point is inside the bounds", Bounds.IsInside(Point));
+            }
+        });
+
+        It("keeps every pair of points at least MinSpacing apart", [this]()
+        {
+            FRandomStream Random(0);
+            const TArray<FVector2D> Points = AmbitPoissonDisk::GeneratePoints(Bounds, MinSpacing, 200, Random);
+            TestTrue("The closest pair is far enough apart", GetClosestDistance(Points) >= MinSpacing - 0.01f);
+        });
+
+        It("returns every point that fits when more are requested", [this]()
+        {
+            AddExpectedError(TEXT("locations fit at a minimum spacing"), EAutomationExpectedErrorFlags::Contains, 1);
+            FRandomStream Random(0);
+            const TArray<FVector2D> Points = AmbitPoissonDisk::GeneratePoints(Bounds, MinSpacing, 100000, Random);
+            // A maximal set at this spacing covers the 20 m by 20 m area with a few hundred points.
+            TestTrue("Some points are returned", Points.Num() > 200);
+            TestTrue("Not all requested points fit", Points.Num() < 100000);
+            TestTrue("The closest pair is far enough apart", GetClosestDistance(Points) >= MinSpacing - 0.01f);
+        });
+
+        It("is deterministic for a given seed", [this]()
+        {
+            FRandomStream RandomA(42);
+            FRandomStream RandomB(42);
+            const TArray<FVector2D> PointsA = AmbitPoissonDisk::GeneratePoints(Bounds, MinSpacing, 50, RandomA);
+            const TArray<FVector2D> PointsB = AmbitPoissonDisk::GeneratePoints(Bounds, MinSpacing, 50, RandomB);
+            TestTrue("Both runs return the same points", PointsA == PointsB);
+        });
+
+        It("spreads a few points over the whole of large bounds", [this]()
+        {
+            // One square kilometre at one metre spacing would hold about a million points.
+            const FBox2D LargeBounds(FVector2D(-50000, -50000), FVector2D(50000, 50000));
+            FRandomStream Random(0);
+            const TArray<FVector2D> Points = AmbitPoissonDisk::GeneratePoints(LargeBounds, MinSpacing, 50, Random);
+            TestEqual("The number of points", Points.Num(), 50);
+            TestTrue("The closest pair is far enough apart", GetClosestDistance(Points) >= MinSpacing - 0.01f);
+
+            const FBox2D Covered(Points);
+            TestTrue("The points span most of the bounds",
+                     Covered.GetSize().X > 0.5f * LargeBounds.GetSize().X &&
+                     Covered.GetSize().Y > 0.5f * LargeBounds.GetSize().Y);
+        });
+
+        It("returns nothing when MinSpacing is not positive", [this]()
+        {
+            FRandomStream Random(0);
+            TestEqual("No points", AmbitPoissonDisk::GeneratePoints(Bounds, 0.f, 10, Random).Num(), 0);
+        });
+    });
+
+    Describe("GenerateDistances()", [this]()
+    {
+        It("keeps every pair of distances at least MinSpacing apart", [this]()
+        {
+            FRandomStream Random(0);
+            TArray<float> Distances = AmbitPoissonDisk::GenerateDistances(5000.f, MinSpacing, 20, Random);
+            TestEqual("The number of distances", Distances.Num(), 20);
+
+            Distances.Sort();
+            for (int32 i = 0; i < Distances.Num(); i++)
+            {
+                TestTrue("The distance is on the segment", Distances[i] >= 0.f && Distances[i] <= 5000.f);
+                if (i > 0)
+                {
+                    TestTrue("Neighbours are far enough apart",
+                             Distances[i] - Distances[i - 1] >= MinSpacing - 0.01f);
+                }
+            }
+        });
+
+        It("spreads a few distances over the whole of a long segment", [this]()
+        {
+            // A hundred kilometres at one metre spacing would hold about 70,000 distances.
+            const float Length = 10000000.f;
+            FRandomStream Random(0);
+            TArray<float> Distances = AmbitPoissonDisk::GenerateDistances(Length, MinSpacing, 20, Random);
+            TestEqual("The number of distances", Distances.Num(), 20);
+
+            Distances.Sort();
+            TestTrue("The distances span most of the segment", Distances.Last() - Distances[0] > 0.5f * Length);
+            for (int32 i = 1; i < Distances.Num(); i++)
+            {
+                TestTrue("Neighbours are far enough apart", Distances[i] - Distances[i - 1] >= MinSpacing - 0.01f);
+            }
+        });
+
+        It("returns every distance that fits when more are requested", [this]()
+        {
+            AddExpectedError(TEXT("locations fit along"), EAutomationExpectedErrorFlags::Contains, 1);
+            FRandomStream Random(0);
+            const TArray<float> Distances = AmbitPoissonDisk::GenerateDistances(5000.f, MinSpacing, 1000, Random);
+            // A walk with steps of one to two spacings fits between 25 and 51 distances on 50 m.
+            TestTrue("Some distances are returned", Distances.Num() >= 25);
+            TestTrue("Not all requested distances fit", Distances.Num() <= 51);
+        });
+    });
+}
@@ -15,14 +15,21 @@
 #include "AmbitSpawnerCollisionHelpers.h"
 
 #include "EngineUtils.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/SCS_Node.h"
+#include "Engine/StaticMeshActor.h"
 #include "Engine/SimpleConstructionScript.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "Math/UnrealMathUtility.h"
+#include "PhysicsEngine/BodySetup.h"
 
 #include "Ambit/AmbitModule.h"
 #include "Ambit/Mode/Constant.h"
+#include "Ambit/Utils/AmbitPlacementScene.h"
 
 // TODO: Figure out a way to change DefaultEngine.ini in code
 // to indicate that GameTraceChannel1 is for "Spawned Obstacles"
@@ -31,7 +38,141 @@
 #define AMBIT_SPAWNED_OBSTACLE ECC_GameTraceChannel1
 #define AMBIT_SPAWNED_OVERLAP ECC_GameTraceChannel2
 
+namespace
+{
+    // Returns the template of the root component of an actor of the provided class,
+    // which is in the construction script if the class defaults have no root.
+    const USceneComponent* FindDefaultRootComponent(UClass* Actor)
+    {
+        const USceneComponent* Root = Actor->GetDefaultObject<AActor>()->GetRootComponent();
+        const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Actor);
+        if (Root == nullptr && BlueprintClass != nullptr && BlueprintClass->SimpleConstructionScript != nullptr)
+        {
+            const TArray<USCS_Node*>& RootNodes = BlueprintClass->SimpleConstructionScript->GetRootNodes();
+            Root = RootNodes.Num() > 0 ? Cast<USceneComponent>(RootNodes[0]->ComponentTemplate) : nullptr;
+        }
+        return Root;
+    }
+
+    // Returns the transform of a default component of the provided class relative to an actor placed
+    // at the origin. The root takes the location and rotation of the placement, and keeps only its scale.
+    FTransform GetDefaultActorSpaceTransform(UClass* Actor, const USceneComponent* Component)
+    {
+        const AActor* DefaultActor = Actor->GetDefaultObject<AActor>();
+        const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Actor);
+        const USceneComponent* Root = FindDefaultRootComponent(Actor);
+        TArray<USCS_Node*> Nodes;
+        if (BlueprintClass != nullptr && BlueprintClass->SimpleConstructionScript != nullptr)
+        {
+            Nodes = BlueprintClass->SimpleConstructionScript->GetAllNodes();
+        }
+
+        // Templates do not know their attach parent, so it is found from the construction script.
+        const auto FindParent = [&Nodes, BlueprintClass, DefaultActor, Root](const USceneComponent* Child)
+            -> const USceneComponent*
+        {
+            for (const USCS_Node* Node : Nodes)
+            {
+                if (Node->ComponentTemplate != Child)
+                {
+                    continue;
+                }
+                if (const USCS_Node* ParentNode = BlueprintClass->SimpleConstructionScript->FindParentNode(Node))
+                {
+                    return Cast<USceneComponent>(ParentNode->ComponentTemplate);
+                }
+                if (Node->bIsParentComponentNative)
+                {
+                    return Cast<USceneComponent>(DefaultActor->GetDefaultSubobjectByName(
+                        Node->ParentComponentOrVariableName));
+                }
+                return Root;
+            }
+            return Child->GetAttachParent() != nullptr ? Child->GetAttachParent() : Root;
+        };
+
+        FTransform ActorSpaceTransform;
+        while (Component != nullptr && Component != Root)
+        {
+            ActorSpaceTransform = ActorSpaceTransform * Component->GetRelativeTransform();
+            Component = FindParent(Component);
+        }
+        const FVector RootScale = Root != nullptr ? Root->GetRelativeScale3D() : FVector::OneVector;
+        return ActorSpaceTransform * FTransform(FQuat::Identity, FVector::ZeroVector, RootScale);
+    }
+
+    // Adds the simple collision of a default static mesh component, placed at ActorSpaceTransform,
+    // to OutShapes. Shapes are scaled by their component, which is exact for uniform scales.
+    void AddSimpleCollisionShapes(const UStaticMeshComponent* Component, const FTransform& ActorSpaceTransform,
+                                  TArray<FSpawnedObstacleShape>& OutShapes)
+    {
+        const UStaticMesh* StaticMesh = Component->GetStaticMesh();
+        if (StaticMesh == nullptr)
+        {
+            return;
+        }
+
+        const FVector Scale = ActorSpaceTransform.GetScale3D().GetAbs();
+        const auto AddShape = [&OutShapes, &ActorSpaceTransform](const FCollisionShape& Shape,
+                                                                 const FTransform& MeshSpaceTransform)
+        {
+            FSpawnedObstacleShape& Added = OutShapes.AddDefaulted_GetRef();
+            Added.Shape = Shape;
+            Added.ActorSpaceTransform = FTransform(ActorSpaceTransform.GetRotation() * MeshSpaceTransform.GetRotation(),
+                                                   ActorSpaceTransform.TransformPosition(
+                                                       MeshSpaceTransform.GetLocation()));
+        };
+
+        const UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+        const bool bHasSimpleCollision = BodySetup != nullptr && BodySetup->AggGeom.GetElementCount() > 0;
+        if (Component->GetCollisionEnabled() == ECollisionEnabled::NoCollision || !bHasSimpleCollision)
+        {
+            // As IsPlacementBlocked() tests spawned components without a body.
+            const FBox Bounds = StaticMesh->GetBoundingBox();
+            AddShape(FCollisionShape::MakeBox(Bounds.GetExtent() * Scale), FTransform(Bounds.GetCenter()));
+            return;
+        }
+
+        const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+        for (const FKBoxElem& Box : AggGeom.BoxElems)
+        {
+            AddShape(FCollisionShape::MakeBox(FVector(Box.X, Box.Y, Box.Z) * 0.5f * Scale),
+                     FTransform(Box.Rotation, Box.Center));
+        }
+        for (const FKSphereElem& Sphere : AggGeom.SphereElems)
+        {
+            AddShape(FCollisionShape::MakeSphere(Sphere.Radius * Scale.GetMin()), FTransform(Sphere.Center));
+        }
+        for (const FKSphylElem& Sphyl : AggGeom.SphylElems)
+        {
+            const float Radius = Sphyl.Radius * FMath::Max(Scale.X, Scale.Y);
+            AddShape(FCollisionShape::MakeCapsule(Radius, Sphyl.Length * 0.5f * Scale.Z + Radius),
+                     FTransform(Sphyl.Rotation, Sphyl.Center));
+        }
+        for (const FKTaperedCapsuleElem& Capsule : AggGeom.TaperedCapsuleElems)
+        {
+            const float Radius = FMath::Max(Capsule.Radius0, Capsule.Radius1) * FMath::Max(Scale.X, Scale.Y);
+            AddShape(FCollisionShape::MakeCapsule(Radius, Capsule.Length * 0.5f * Scale.Z + Radius),
+                     FTransform(Capsule.Rotation, Capsule.Center));
+        }
+        // Convex hulls are tested with their bounds, the closest shape that queries accept.
+        for (const FKConvexElem& Convex : AggGeom.ConvexElems)
+        {
+            const FTransform ConvexTransform = Convex.GetTransform();
+            AddShape(FCollisionShape::MakeBox(Convex.ElemBox.GetExtent() * Scale),
+                     FTransform(ConvexTransform.GetRotation(),
+                                ConvexTransform.TransformPosition(Convex.ElemBox.GetCenter())));
+        }
+    }
+}
+
 bool AmbitSpawnerCollisionHelpers::IsPenetratingOverlap(UPrimitiveComponent* OverlappingComponent, AActor* SpawnedActor)
+{
+    return IsPenetratingOverlap(OverlappingComponent, SpawnedActor->GetActorLocation());
+}
+
+bool AmbitSpawnerCollisionHelpers::IsPenetratingOverlap(UPrimitiveComponent* OverlappingComponent,
+                                                        const FVector& SpawnedLocation)
 {
     // Filter out overlaps if they are overlapping AMBIT_SPAWNER_OVERLAP objects
     if (OverlappingComponent->GetCollisionObjectType() == AMBIT_SPAWNED_OVERLAP)
@@ -43,7 +184,7 @@ bool AmbitSpawnerCollisionHelpers::IsPenetratingOverlap(UPrimitiveComponent* Ove
     {
         return true;
     }
-    const FVector& SpawnedActorLocation = SpawnedActor->GetActorLocation();
+    const FVector& SpawnedActorLocation = SpawnedLocation;
     const FVector& LocationOfOverlappingComp = OverlappingComponent->GetComponentLocation();
 
     const float DistanceBetweenActorAndComp = FVector::Distance(SpawnedActorLocation, LocationOfOverlappingComp) /
@@ -107,6 +248,102 @@ void AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(UClass* Actor
     }
 }
 
+FBox AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(UClass* Actor)
+{
+    FBox Bounds(ForceInit);
+    TArray<UStaticMeshComponent*> StaticMeshComponents;
+    FindDefaultStaticMeshComponents(Actor, StaticMeshComponents);
+    for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+    {
+        const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+        if (StaticMesh != nullptr)
+        {
+            Bounds += StaticMesh->GetBoundingBox().TransformBy(StaticMeshComponent->GetRelativeTransform());
+        }
+    }
+    return Bounds;
+}
+
+FVector AmbitSpawnerCollisionHelpers::GetDefaultRootScale(UClass* Actor)
+{
+    const USceneComponent* Root = FindDefaultRootComponent(Actor);
+    return Root != nullptr ? Root->GetRelativeScale3D() : FVector::OneVector;
+}
+
+bool AmbitSpawnerCollisionHelpers::GetInstanceableMeshes(UClass* Actor, TArray<FInstanceableMesh>& OutMeshes,
+                                                         FVector& OutRootScale)
+{
+    OutMeshes.Empty();
+    OutRootScale = FVector::OneVector;
+
+    // Native parents other than these, and event graphs, may change the actor after it is spawned.
+    const UClass* NativeParent = Actor;
+    while (!NativeParent->HasAnyClassFlags(CLASS_Native))
+    {
+        NativeParent = NativeParent->GetSuperClass();
+    }
+    if (NativeParent != AActor::StaticClass() && NativeParent != AStaticMeshActor::StaticClass())
+    {
+        return false;
+    }
+    const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Actor);
+    if (BlueprintClass != nullptr && BlueprintClass->UbergraphFunction != nullptr)
+    {
+        return false;
+    }
+
+    // Every component must be a static mesh, or a plain scene component that only positions them.
+    TArray<UObject*> NativeComponents;
+    Actor->GetDefaultObjectSubobjects(NativeComponents);
+    TArray<const UActorComponent*> Components;
+    for (const UObject* Object : NativeComponents)
+    {
+        if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+        {
+            Components.Add(Component);
+        }
+    }
+    TArray<USCS_Node*> Nodes;
+    if (BlueprintClass != nullptr && BlueprintClass->SimpleConstructionScript != nullptr)
+    {
+        Nodes = BlueprintClass->SimpleConstructionScript->GetAllNodes();
+        for (const USCS_Node* Node : Nodes)
+        {
+            Components.Add(Node->ComponentTemplate);
+        }
+    }
+    for (const UActorComponent* Component : Components)
+    {
+        const bool bIsSceneComponent = Component != nullptr && Component->GetClass() == USceneComponent::StaticClass();
+        const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component);
+        const bool bIsStaticMesh = StaticMeshComponent != nullptr
+                && !StaticMeshComponent->IsA<UInstancedStaticMeshComponent>()
+                && StaticMeshComponent->GetStaticMesh() != nullptr;
+        if (!bIsSceneComponent && !bIsStaticMesh)
+        {
+            return false;
+        }
+    }
+
+    const USceneComponent* Root = FindDefaultRootComponent(Actor);
+    if (Root != nullptr)
+    {
+        OutRootScale = Root->GetRelativeScale3D();
+    }
+
+    TArray<UStaticMeshComponent*> StaticMeshComponents;
+    FindDefaultStaticMeshComponents(Actor, StaticMeshComponents);
+    for (int32 i = 0; i < StaticMeshComponents.Num(); i++)
+    {
+        FInstanceableMesh Mesh;
+        Mesh.Template = StaticMeshComponents[i];
+        Mesh.ComponentIndex = i;
+        Mesh.ActorSpaceTransform = GetDefaultActorSpaceTransform(Actor, Mesh.Template);
+        OutMeshes.Add(Mesh);
+    }
+    return OutMeshes.Num() > 0;
+}
+
 void AmbitSpawnerCollisionHelpers::SetCollisionForAllStaticMeshComponents(
     const TArray<UStaticMeshComponent*>& StaticMeshComponents, bool bRemoveOverlaps)
 {
@@ -213,3 +450,311 @@ void AmbitSpawnerCollisionHelpers::ResetCollisionProfiles(
         }
     }
 }
+
+
+FSpawnedObstacleCollision AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(UClass* Actor,
+                                                                                    bool bRemoveOverlaps)
+{
+    FSpawnedObstacleCollision Collision;
+    Collision.ObjectType = bRemoveOverlaps ? AMBIT_SPAWNED_OBSTACLE : AMBIT_SPAWNED_OVERLAP;
+    Collision.PlacementResponses.SetAllChannels(ECR_Overlap);
+    Collision.PlacementResponses.SetResponse(AMBIT_SPAWNED_OBSTACLE, ECR_Block);
+
+    TArray<UStaticMeshComponent*> StaticMeshComponents;
+    FindDefaultStaticMeshComponents(Actor, StaticMeshComponents);
+    for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+    {
+        // Keeps the collision behavior of the asset, with the AmbitSpawner Spawned Type
+        // so that no overlaps occur with future spawned objects
+        FCollisionResponseTemplate& Component = Collision.Components.AddDefaulted_GetRef();
+        Component.Name = UCollisionProfile::CustomCollisionProfileName;
+        Component.ObjectType = Collision.ObjectType;
+        Component.CollisionEnabled = StaticMeshComponent->GetCollisionEnabled();
+        Component.ResponseToChannels = StaticMeshComponent->GetCollisionResponseToChannels();
+
+        // Overlappable obstacles are overlapped, so that actors not spawned by AmbitSpawners
+        // respond to them correctly if they are supposed to generate overlap events.
+        // The placement tests ignore AMBIT_SPAWNED_OVERLAP typed objects.
+        Component.ResponseToChannels.SetResponse(AMBIT_SPAWNED_OVERLAP, ECR_Overlap);
+
+        AddSimpleCollisionShapes(StaticMeshComponent, GetDefaultActorSpaceTransform(Actor, StaticMeshComponent),
+                                 Collision.Shapes);
+    }
+    return Collision;
+}
+
+void AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(const AActor* SpawnedActor,
+                                                                 const FSpawnedObstacleCollision& Collision)
+{
+    TArray<UStaticMeshComponent*> StaticMeshComponents;
+    SpawnedActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+    for (int32 i = 0; i < StaticMeshComponents.Num() && i < Collision.Components.Num(); i++)
+    {
+        UStaticMeshComponent* StaticMeshComponent = StaticMeshComponents[i];
+        const FCollisionResponseTemplate& Component = Collision.Components[i];
+        if (StaticMeshComponent->GetCollisionObjectType() != Component.ObjectType)
+        {
+            StaticMeshComponent->SetCollisionObjectType(Component.ObjectType);
+        }
+        if (!(StaticMeshComponent->GetCollisionResponseToChannels() == Component.ResponseToChannels))
+        {
+            StaticMeshComponent->SetCollisionResponseToChannels(Component.ResponseToChannels);
+        }
+        if (StaticMeshComponent->GetCollisionEnabled() != Component.CollisionEnabled)
+        {
+            StaticMeshComponent->SetCollisionEnabled(Component.CollisionEnabled);
+        }
+    }
+}
+
+AActor* AmbitSpawnerCollisionHelpers::SpawnObstacle(UWorld* World, UClass* Actor, const FTransform& Transform,
+                                                    const FSpawnedObstacleCollision& Collision)
+{
+    // Spawning must not fail on collision here; the placement is tested once the actor is spawned.
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParams.CustomPreSpawnInitalization = [&Collision](AActor* SpawnedActor)
+    {
+        ApplySpawnedObstacleCollision(SpawnedActor, Collision);
+    };
+    AActor* SpawnedActor = World->SpawnActor<AActor>(Actor, Transform, SpawnParams);
+    if (SpawnedActor != nullptr)
+    {
+        // Components added by the construction script only exist once the actor is spawned.
+        ApplySpawnedObstacleCollision(SpawnedActor, Collision);
+    }
+    return SpawnedActor;
+}
+
+namespace
+{
+    // Returns true if a spawned obstacle placed at SpawnedLocation cannot stay with Overlap.
+    bool IsBlockingOverlap(const FOverlapResult& Overlap, const FVector& SpawnedLocation)
+    {
+        UPrimitiveComponent* OverlappingComponent = Overlap.GetComponent();
+        if (OverlappingComponent == nullptr)
+        {
+            return false;
+        }
+
+        // Overlappable obstacles never block, but they are not to be penetrated either
+        const bool bBlocks = Overlap.bBlockingHit
+                             && OverlappingComponent->GetCollisionObjectType() != AMBIT_SPAWNED_OVERLAP;
+        return bBlocks || AmbitSpawnerCollisionHelpers::IsPenetratingOverlap(OverlappingComponent, SpawnedLocation);
+    }
+}
+
+bool AmbitSpawnerCollisionHelpers::IsPlacementBlocked(const UWorld* World, const FBodyInstance& Body,
+                                                      const FTransform& BodyTransform,
+                                                      const FSpawnedObstacleCollision& Collision,
+                                                      const FVector& SpawnedLocation,
+                                                      const FCollisionQueryParams& Params,
+                                                      TFunctionRef<bool(const FOverlapResult&)> IsIgnored)
+{
+    TArray<FOverlapResult> Overlaps;
+    Body.OverlapMulti(Overlaps, World, nullptr, BodyTransform.GetLocation(), BodyTransform.GetRotation(),
+                      Collision.ObjectType, Params, FCollisionResponseParams(Collision.PlacementResponses));
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        if (!IsIgnored(Overlap) && IsBlockingOverlap(Overlap, SpawnedLocation))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AmbitSpawnerCollisionHelpers::IsPlacementBlocked(const AActor* SpawnedActor,
+                                                      const FSpawnedObstacleCollision& Collision)
+{
+    const UWorld* World = SpawnedActor->GetWorld();
+    const FVector& SpawnedLocation = SpawnedActor->GetActorLocation();
+    const FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitPlacement), false, SpawnedActor);
+
+    TArray<UStaticMeshComponent*> StaticMeshComponents;
+    SpawnedActor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+    for (const UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+    {
+        const FBodyInstance* Body = StaticMeshComponent->GetBodyInstance();
+        if (Body != nullptr && Body->IsValidBodyInstance())
+        {
+            const auto IsIgnored = [](const FOverlapResult&) { return false; };
+            if (IsPlacementBlocked(World, *Body, StaticMeshComponent->GetComponentTransform(), Collision,
+                                   SpawnedLocation, Params, IsIgnored))
+            {
+                return true;
+            }
+            continue;
+        }
+
+        // Components without collision have no body, so they are tested with their bounds.
+        TArray<FOverlapResult> Overlaps;
+        World->OverlapMultiByChannel(Overlaps, StaticMeshComponent->Bounds.Origin, FQuat::Identity,
+                                     Collision.ObjectType,
+                                     FCollisionShape::MakeBox(StaticMeshComponent->Bounds.BoxExtent), Params,
+                                     FCollisionResponseParams(Collision.PlacementResponses));
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            if (IsBlockingOverlap(Overlap, SpawnedLocation))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool AmbitSpawnerCollisionHelpers::IsPlacementBlocked(const UWorld* World, const FSpawnedObstacleCollision& Collision,
+                                                      const FTransform& Placement,
+                                                      const FCollisionQueryParams& Params)
+{
+    const FTransform PlacementWithoutScale(Placement.GetRotation(), Placement.GetLocation());
+    TArray<FOverlapResult> Overlaps;
+    for (const FSpawnedObstacleShape& Shape : Collision.Shapes)
+    {
+        const FTransform ShapeTransform = Shape.ActorSpaceTransform * PlacementWithoutScale;
+        Overlaps.Reset();
+        World->OverlapMultiByChannel(Overlaps, ShapeTransform.GetLocation(), ShapeTransform.GetRotation(),
+                                     Collision.ObjectType, Shape.Shape, Params,
+                                     FCollisionResponseParams(Collision.PlacementResponses));
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            if (IsBlockingOverlap(Overlap, Placement.GetLocation()))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool AmbitSpawnerCollisionHelpers::IsPlacementBlocked(const FAmbitPlacementScene& Scene,
+                                                      const FSpawnedObstacleCollision& Collision,
+                                                      const FTransform& Placement)
+{
+    if (Scene.OverlapsObstacle(Collision, Placement))
+    {
+        return true;
+    }
+
+    const FTransform PlacementWithoutScale(Placement.GetRotation(), Placement.GetLocation());
+    TArray<FOverlapResult> Overlaps;
+    for (const FSpawnedObstacleShape& Shape : Collision.Shapes)
+    {
+        Overlaps.Reset();
+        Scene.OverlapMulti(Overlaps, Shape.Shape, Shape.ActorSpaceTransform * PlacementWithoutScale,
+                           Collision.ObjectType, Collision.PlacementResponses);
+        for (const FOverlapResult& Overlap : Overlaps)
+        {
+            if (IsBlockingOverlap(Overlap, Placement.GetLocation()))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+namespace
+{
+    // How far past a penetration a placement is moved, so that it only touches the obstacle.
+    constexpr float KPenetrationPullback = 0.125f;
+
+    using FOverlapShape = TFunctionRef<void(TArray<FOverlapResult>&, const FCollisionShape&, const FTransform&)>;
+
+    // Returns the sum of the penetrations of the shapes of an obstacle at Placement into the spawned
+    // obstacles that block it, as UWorld::EncroachingBlockingGeometry() proposes for a spawned actor.
+    FVector GetBlockingPenetration(const FSpawnedObstacleCollision& Collision, const FTransform& Placement,
+                                   FOverlapShape OverlapShape)
+    {
+        const FTransform PlacementWithoutScale(Placement.GetRotation(), Placement.GetLocation());
+        FVector Penetration = FVector::ZeroVector;
+        TArray<FOverlapResult> Overlaps;
+        for (const FSpawnedObstacleShape& Shape : Collision.Shapes)
+        {
+            const FTransform ShapeTransform = Shape.ActorSpaceTransform * PlacementWithoutScale;
+            Overlaps.Reset();
+            OverlapShape(Overlaps, Shape.Shape, ShapeTransform);
+            for (const FOverlapResult& Overlap : Overlaps)
+            {
+                // Only blocking obstacles are moved out of; other overlaps are left to IsBlockingOverlap().
+                const UPrimitiveComponent* Component = Overlap.GetComponent();
+                if (Component == nullptr || !Overlap.bBlockingHit
+                    || Component->GetCollisionObjectType() == AMBIT_SPAWNED_OVERLAP)
+                {
+                    continue;
+                }
+                const FBodyInstance* Body = Component->GetBodyInstance(NAME_None, true, Overlap.ItemIndex);
+                FMTDResult Result;
+                if (Body != nullptr && Body->IsValidBodyInstance()
+                    && Body->OverlapTest(ShapeTransform.GetLocation(), ShapeTransform.GetRotation(), Shape.Shape,
+                                         &Result))
+                {
+                    Penetration += Result.Direction * (Result.Distance + KPenetrationPullback);
+                }
+            }
+        }
+        return Penetration;
+    }
+
+    // Tries the moves that UWorld::FindTeleportSpot() tries for a spawned actor.
+    bool MoveOutOfBlockingObstacles(const FSpawnedObstacleCollision& Collision, FTransform& InOutPlacement,
+                                    FOverlapShape OverlapShape, TFunctionRef<bool(const FTransform&)> IsBlocked)
+    {
+        const FVector Penetration = GetBlockingPenetration(Collision, InOutPlacement, OverlapShape);
+        const FVector AlongZ(0.f, 0.f, Penetration.Z);
+        const FVector InXY(Penetration.X, Penetration.Y, 0.f);
+        const bool bBoth = !AlongZ.IsNearlyZero() && !InXY.IsNearlyZero();
+        for (const FVector& Move : {AlongZ, InXY, bBoth ? Penetration : FVector::ZeroVector})
+        {
+            if (Move.IsNearlyZero())
+            {
+                continue;
+            }
+            FTransform Moved = InOutPlacement;
+            Moved.AddToTranslation(Move);
+            if (!IsBlocked(Moved))
+            {
+                InOutPlacement = Moved;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+bool AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(const UWorld* World,
+                                                          const FSpawnedObstacleCollision& Collision,
+                                                          FTransform& InOutPlacement,
+                                                          const FCollisionQueryParams& Params)
+{
+    const auto OverlapShape = [World, &Collision, &Params](TArray<FOverlapResult>& OutOverlaps,
+                                                           const FCollisionShape& Shape,
+                                                           const FTransform& ShapeTransform)
+    {
+        World->OverlapMultiByChannel(OutOverlaps, ShapeTransform.GetLocation(), ShapeTransform.GetRotation(),
+                                     Collision.ObjectType, Shape, Params,
+                                     FCollisionResponseParams(Collision.PlacementResponses));
+    };
+    const auto IsBlocked = [World, &Collision, &Params](const FTransform& Placement)
+    {
+        return IsPlacementBlocked(World, Collision, Placement, Params);
+    };
+    return MoveOutOfBlockingObstacles(Collision, InOutPlacement, OverlapShape, IsBlocked);
+}
+
+bool AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(const FAmbitPlacementScene& Scene,
+                                                          const FSpawnedObstacleCollision& Collision,
+                                                          FTransform& InOutPlacement)
+{
+    const auto OverlapShape = [&Scene, &Collision](TArray<FOverlapResult>& OutOverlaps, const FCollisionShape& Shape,
+                                                   const FTransform& ShapeTransform)
+    {
+        Scene.OverlapMulti(OutOverlaps, Shape, ShapeTransform, Collision.ObjectType, Collision.PlacementResponses);
+    };
+    const auto IsBlocked = [&Scene, &Collision](const FTransform& Placement)
+    {
+        return IsPlacementBlocked(Scene, Collision, Placement);
+    };
+    return MoveOutOfBlockingObstacles(Collision, InOutPlacement, OverlapShape, IsBlocked);
+}
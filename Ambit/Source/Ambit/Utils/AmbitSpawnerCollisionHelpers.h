@@ -17,6 +17,58 @@
 #include "CoreMinimal.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/CollisionProfile.h"
+#include "WorldCollision.h"
+
+class FAmbitPlacementScene;
+
+/**
+ * A default static mesh component of an actor class that can be drawn as an instance.
+ */
+struct FInstanceableMesh
+{
+    // The default component, whose mesh, materials and collision the instance uses.
+    UStaticMeshComponent* Template = nullptr;
+
+    // The index of Template in the array returned by FindDefaultStaticMeshComponents().
+    int32 ComponentIndex = INDEX_NONE;
+
+    // The transform of Template relative to an actor placed at the origin.
+    FTransform ActorSpaceTransform;
+};
+
+/**
+ * A simple collision shape of a default static mesh component of an actor class.
+ */
+struct FSpawnedObstacleShape
+{
+    // The shape, with the scale of its component already applied.
+    FCollisionShape Shape;
+
+    // The location and rotation of Shape relative to an actor placed at the origin.
+    FTransform ActorSpaceTransform;
+};
+
+/**
+ * The collision of the obstacles that spawners place for an actor class,
+ * worked out from the class defaults without changing them.
+ */
+struct FSpawnedObstacleCollision
+{
+    // The object type of the spawned static mesh components.
+    ECollisionChannel ObjectType = ECC_GameTraceChannel1;
+
+    // The responses that placements are tested with: they are blocked by other spawned obstacles
+    // and find everything else that they overlap.
+    FCollisionResponseContainer PlacementResponses;
+
+    // The collision of each default static mesh component of the class once it is spawned,
+    // in the order of FindDefaultStaticMeshComponents().
+    TArray<FCollisionResponseTemplate> Components;
+
+    // The simple collision of the default static mesh components, which placements are tested with
+    // before anything is spawned. Components without collision are represented by their bounds.
+    TArray<FSpawnedObstacleShape> Shapes;
+};
 
 namespace AmbitSpawnerCollisionHelpers
 {
@@ -45,6 +97,184 @@ namespace AmbitSpawnerCollisionHelpers
      */
     void FindDefaultStaticMeshComponents(UClass* Actor, TArray<UStaticMeshComponent*>& OutArray);
 
+    /**
+     * Returns the combined bounds of the default static mesh
+     * components of the provided actor class, in the actor's space.
+     * The returned box is invalid if the class has no static meshes.
+     *
+     * @param Actor
+     *  the UClass of the Actor from which to get the bounds
+     */
+    FBox GetDefaultStaticMeshBounds(UClass* Actor);
+
+    /**
+     * Returns the scale that the default root component gives an actor of the provided class.
+     *
+     * @param Actor
+     *  the UClass of the Actor from which to get the scale
+     */
+    FVector GetDefaultRootScale(UClass* Actor);
+
+    /**
+     * Populates OutMeshes with the default static mesh components of the provided actor class
+     * if the class is made of static meshes only and has no logic of its own,
+     * so that its placements can be drawn as instances without changing how it looks.
+     *
+     * @param Actor
+     *  the UClass of the Actor to check
+     * @param OutMeshes
+     *  the array to populate with the static meshes of the class
+     * @param OutRootScale
+     *  the scale that the root component gives an actor of the class
+     * @return
+     *  whether the class can be drawn as instances; OutMeshes is empty if not
+     */
+    bool GetInstanceableMeshes(UClass* Actor, TArray<FInstanceableMesh>& OutMeshes, FVector& OutRootScale);
+
+    /**
+     * Returns the collision that spawned obstacles of the provided actor class have,
+     * without changing the class defaults.
+     *
+     * @param Actor
+     *  the UClass of the spawned obstacles
+     * @param bRemoveOverlaps
+     *  whether the obstacles block other spawned obstacles, rather than only overlapping them
+     */
+    FSpawnedObstacleCollision MakeSpawnedObstacleCollision(UClass* Actor, bool bRemoveOverlaps = true);
+
+    /**
+     * Gives the static mesh components of SpawnedActor the collision of spawned obstacles.
+     * Settings that already match are not set again, so that components that were set up
+     * before they were registered do not update their physics state.
+     *
+     * @param SpawnedActor
+     *  the spawned obstacle
+     * @param Collision
+     *  the collision of the class of SpawnedActor
+     */
+    void ApplySpawnedObstacleCollision(const AActor* SpawnedActor, const FSpawnedObstacleCollision& Collision);
+
+    /**
+     * Spawns an actor of the provided class as a spawned obstacle, even if it collides.
+     * Its native components get Collision before they are registered, so that their bodies
+     * are created with it; components added by the construction script get it right after.
+     *
+     * @param World
+     *  the world to spawn into
+     * @param Actor
+     *  the UClass of the obstacle
+     * @param Transform
+     *  where to spawn the obstacle
+     * @param Collision
+     *  the collision of Actor, from MakeSpawnedObstacleCollision()
+     * @return
+     *  the spawned actor, or nullptr if it could not be spawned
+     */
+    AActor* SpawnObstacle(UWorld* World, UClass* Actor, const FTransform& Transform,
+                          const FSpawnedObstacleCollision& Collision);
+
+    /**
+     * Checks if an obstacle placed at SpawnedLocation, with the provided body at BodyTransform,
+     * has to be removed because it is blocked by another spawned obstacle
+     * or penetrates a component that it overlaps.
+     *
+     * @param World
+     *  the world to query
+     * @param Body
+     *  the body of one of the components of the obstacle
+     * @param BodyTransform
+     *  the world transform of Body
+     * @param Collision
+     *  the collision of the obstacle's class
+     * @param SpawnedLocation
+     *  the location the obstacle was placed at
+     * @param Params
+     *  the query parameters, such as the actors to ignore
+     * @param IsIgnored
+     *  returns true for overlaps that do not count, such as with other parts of the same obstacle
+     */
+    bool IsPlacementBlocked(const UWorld* World, const FBodyInstance& Body, const FTransform& BodyTransform,
+                            const FSpawnedObstacleCollision& Collision, const FVector& SpawnedLocation,
+                            const FCollisionQueryParams& Params,
+                            TFunctionRef<bool(const FOverlapResult&)> IsIgnored);
+
+    /**
+     * Checks if SpawnedActor has to be removed because it is blocked by another spawned obstacle
+     * or penetrates a component that it overlaps. The components of SpawnedActor are queried with
+     * the placement responses of Collision, so their own collision settings do not matter.
+     *
+     * @param SpawnedActor
+     *  the spawned obstacle
+     * @param Collision
+     *  the collision of the class of SpawnedActor
+     */
+    bool IsPlacementBlocked(const AActor* SpawnedActor, const FSpawnedObstacleCollision& Collision);
+
+    /**
+     * Checks if an obstacle would have to be removed, because it would be blocked by another spawned obstacle
+     * or penetrate a component that it overlaps, before it is spawned. The shapes of Collision are queried
+     * at Placement, so nothing is added to the world, and several placements can be tested at once
+     * from other threads while the world is not changed.
+     *
+     * @param World
+     *  the world to query
+     * @param Collision
+     *  the collision of the obstacle's class
+     * @param Placement
+     *  the location and rotation the obstacle would be spawned at
+     * @param Params
+     *  the query parameters, such as the actors to ignore
+     */
+    bool IsPlacementBlocked(const UWorld* World, const FSpawnedObstacleCollision& Collision,
+                            const FTransform& Placement, const FCollisionQueryParams& Params);
+
+    /**
+     * Same as IsPlacementBlocked() above, but queries Scene instead of the world,
+     * including the obstacles already added to Scene.
+     *
+     * @param Scene
+     *  the scene to query
+     * @param Collision
+     *  the collision of the obstacle's class
+     * @param Placement
+     *  the location and rotation the obstacle would be spawned at
+     */
+    bool IsPlacementBlocked(const FAmbitPlacementScene& Scene, const FSpawnedObstacleCollision& Collision,
+                            const FTransform& Placement);
+
+    /**
+     * Moves a placement that IsPlacementBlocked() found blocked out of the spawned obstacles that block it,
+     * as spawning with ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding moves
+     * an actor. The placement is moved by the penetration of those obstacles along Z, then in XY,
+     * then along both, and the first move that is not blocked is kept.
+     *
+     * @param World
+     *  the world to query
+     * @param Collision
+     *  the collision of the obstacle's class
+     * @param InOutPlacement
+     *  the blocked placement, which is moved if a move is found
+     * @param Params
+     *  the query parameters, such as the actors to ignore
+     * @return
+     *  whether the obstacle can stay at the moved placement; InOutPlacement is not changed if not
+     */
+    bool AdjustBlockedPlacement(const UWorld* World, const FSpawnedObstacleCollision& Collision,
+                                FTransform& InOutPlacement, const FCollisionQueryParams& Params);
+
+    /**
+     * Same as AdjustBlockedPlacement() above, but queries Scene instead of the world.
+     *
+     * @param Scene
+     *  the scene to query
+     * @param Collision
+     *  the collision of the obstacle's class
+     * @param InOutPlacement
+     *  the blocked placement, which is moved if a move is found
+     */
+    bool AdjustBlockedPlacement(const FAmbitPlacementScene& Scene, const FSpawnedObstacleCollision& Collision,
+                                FTransform& InOutPlacement);
+
     /**
      * Sets collision profiles of all static mesh components
      * in the provided array to the custom profile for ambit spawned obstacles
@@ -71,6 +301,17 @@ namespace AmbitSpawnerCollisionHelpers
      */
     bool IsPenetratingOverlap(UPrimitiveComponent* OverlappingComponent, AActor* SpawnedActor);
 
+    /**
+     * Checks if an obstacle placed at SpawnedLocation is penetrating the provided
+     * overlapping component, in the same way as for a spawned actor.
+     *
+     * @param OverlappingComponent
+     *  the component that is overlapping the spawned obstacle
+     * @param SpawnedLocation
+     *  the location the obstacle was placed at
+     */
+    bool IsPenetratingOverlap(UPrimitiveComponent* OverlappingComponent, const FVector& SpawnedLocation);
+
     /**
      * Stores collision profiles of the provided StaticMeshComponents
      * in the OutMap in an array whose key value is PathName
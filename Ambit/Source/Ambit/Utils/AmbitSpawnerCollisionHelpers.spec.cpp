@@ -222,6 +222,40 @@ void AmbitSpawnerCollisionHelpersSpec::Define()
         });
     });
 
+    Describe("GetDefaultStaticMeshBounds()", [this]()
+    {
+        It("returns an invalid box if there are no static mesh components", [this]()
+        {
+            const FBox Actual = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(AActor::StaticClass());
+            TestFalse("The box is invalid", static_cast<bool>(Actual.IsValid));
+        });
+
+        It("returns the bounds of the static mesh of a blueprint actor", [this]()
+        {
+            const FBox Actual = AmbitSpawnerCollisionHelpers::GetDefaultStaticMeshBounds(TestSpawnedActor->GetClass());
+            TestTrue("The box is valid", static_cast<bool>(Actual.IsValid));
+
+            const FBox Expected = TestSpawnedActor->GetComponentsBoundingBox().ShiftBy(
+                -TestSpawnedActor->GetActorLocation());
+            TestTrue("The box matches the spawned actor", Actual.GetSize().Equals(Expected.GetSize(), 1.f));
+        });
+    });
+
+    Describe("GetDefaultRootScale()", [this]()
+    {
+        It("returns the scale of a spawned blueprint actor", [this]()
+        {
+            const FVector Actual = AmbitSpawnerCollisionHelpers::GetDefaultRootScale(TestSpawnedActor->GetClass());
+            TestEqual("The scale matches the spawned actor", Actual, TestSpawnedActor->GetActorScale3D());
+        });
+
+        It("returns a unit scale if there is no root component", [this]()
+        {
+            const FVector Actual = AmbitSpawnerCollisionHelpers::GetDefaultRootScale(AActor::StaticClass());
+            TestEqual("The scale is one", Actual, FVector::OneVector);
+        });
+    });
+
     Describe("SetCollisionForAllStaticMeshComponents()", [this]()
     {
         It("sets component to object type for Ambit Spawner Obstacles", [this]()
@@ -289,6 +323,175 @@ void AmbitSpawnerCollisionHelpersSpec::Define()
         });
     });
 
+    Describe("MakeSpawnedObstacleCollision()", [this]()
+    {
+        It("does not change the class defaults", [this]()
+        {
+            TArray<UStaticMeshComponent*> Defaults;
+            AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(TestSpawnedActor->GetClass(), Defaults);
+            const ECollisionChannel OriginalObjectType = Defaults[0]->GetCollisionObjectType();
+            const FCollisionResponseContainer OriginalResponses = Defaults[0]->GetCollisionResponseToChannels();
+            const bool bOriginalCustomizedCollision = Defaults[0]->GetStaticMesh()->bCustomizedCollision;
+
+            AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(TestSpawnedActor->GetClass());
+
+            TestEqual("object type", Defaults[0]->GetCollisionObjectType(), OriginalObjectType);
+            TestTrue("responses", Defaults[0]->GetCollisionResponseToChannels() == OriginalResponses);
+            TestEqual("customized collision", Defaults[0]->GetStaticMesh()->bCustomizedCollision,
+                      bOriginalCustomizedCollision);
+        });
+
+        It("keeps the responses of each default static mesh component", [this]()
+        {
+            TArray<UStaticMeshComponent*> Defaults;
+            AmbitSpawnerCollisionHelpers::FindDefaultStaticMeshComponents(TestSpawnedActor->GetClass(), Defaults);
+
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            TestEqual("one per component", Collision.Components.Num(), Defaults.Num());
+            TestEqual("object type", Collision.Components[0].ObjectType, ECC_GameTraceChannel1);
+            TestEqual("collision enabled", Collision.Components[0].CollisionEnabled,
+                      Defaults[0]->GetCollisionEnabled());
+            TestEqual("world static response", Collision.Components[0].ResponseToChannels.GetResponse(ECC_WorldStatic),
+                      Defaults[0]->GetCollisionResponseToChannel(ECC_WorldStatic));
+            TestEqual("overlappable obstacle response",
+                      Collision.Components[0].ResponseToChannels.GetResponse(ECC_GameTraceChannel2), ECR_Overlap);
+        });
+
+        It("tests placements against other spawned obstacles only", [this]()
+        {
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            TestEqual("spawned obstacles", Collision.PlacementResponses.GetResponse(ECC_GameTraceChannel1), ECR_Block);
+            TestEqual("world static", Collision.PlacementResponses.GetResponse(ECC_WorldStatic), ECR_Overlap);
+        });
+
+        It("uses the overlappable object type if overlaps are not removed", [this]()
+        {
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass(), false);
+
+            TestEqual("object type", Collision.ObjectType, ECC_GameTraceChannel2);
+        });
+    });
+
+    Describe("ApplySpawnedObstacleCollision()", [this]()
+    {
+        It("gives the spawned components the collision of the class", [this]()
+        {
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(TestSpawnedActor, Collision);
+
+            UStaticMeshComponent* StaticMesh = TestSpawnedActor->FindComponentByClass<UStaticMeshComponent>();
+            TestEqual("object type", StaticMesh->GetCollisionObjectType(), ECC_GameTraceChannel1);
+            TestTrue("responses",
+                     StaticMesh->GetCollisionResponseToChannels() == Collision.Components[0].ResponseToChannels);
+        });
+    });
+
+    Describe("IsPlacementBlocked()", [this]()
+    {
+        It("returns true if the actor penetrates what it overlaps", [this]()
+        {
+            TestSurfaceActor->SetActorScale3D(FVector(5));
+            TestSpawnedActor->SetActorLocation(FVector(0));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            TestTrue("is blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(TestSpawnedActor, Collision));
+        });
+
+        It("returns true if the actor overlaps another spawned obstacle", [this]()
+        {
+            TestSurfaceActor->SetActorLocation(FVector(0, 0, -1000));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+            AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(TestSpawnedActor, Collision);
+            const FVector Location = TestSpawnedActor->GetActorLocation();
+            FActorSpawnParameters Params;
+            Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+            AActor* Other = World->SpawnActor(TestSpawnedActor->GetClass(), &Location, nullptr, Params);
+            AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(Other, Collision);
+
+            TestTrue("is blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(Other, Collision));
+            Other->Destroy();
+        });
+
+        It("returns false if the actor overlaps nothing", [this]()
+        {
+            TestSpawnedActor->SetActorLocation(FVector(10000, 0, 0));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            TestFalse("is not blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(TestSpawnedActor, Collision));
+        });
+
+        It("returns true if a placement overlaps another spawned obstacle before spawning", [this]()
+        {
+            TestSurfaceActor->SetActorLocation(FVector(0, 0, -1000));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+            AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(TestSpawnedActor, Collision);
+
+            TestTrue("has shapes", Collision.Shapes.Num() > 0);
+            TestTrue("is blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(
+                         World, Collision, TestSpawnedActor->GetActorTransform(),
+                         FCollisionQueryParams(SCENE_QUERY_STAT(AmbitTest))));
+        });
+
+        It("returns false if a placement overlaps nothing before spawning", [this]()
+        {
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+
+            TestFalse("is not blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(
+                          World, Collision, FTransform(FVector(10000, 0, 0)),
+                          FCollisionQueryParams(SCENE_QUERY_STAT(AmbitTest))));
+        });
+    });
+
+    Describe("AdjustBlockedPlacement()", [this]()
+    {
+        It("moves a placement that partly overlaps another spawned obstacle out of it", [this]()
+        {
+            TestSurfaceActor->SetActorLocation(FVector(0, 0, -1000));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+            AmbitSpawnerCollisionHelpers::ApplySpawnedObstacleCollision(TestSpawnedActor, Collision);
+            const FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitTest));
+            const FBox Bounds = TestSpawnedActor->GetComponentsBoundingBox();
+            const FTransform Blocked(TestSpawnedActor->GetActorLocation() + FVector(Bounds.GetSize().X * 0.9f, 0, 0));
+
+            FTransform Adjusted = Blocked;
+            TestTrue("is blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(World, Collision, Blocked, Params));
+            TestTrue("is adjusted", AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(
+                         World, Collision, Adjusted, Params));
+            TestFalse("is moved", Adjusted.GetLocation().Equals(Blocked.GetLocation()));
+            TestFalse("is not blocked once moved", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(
+                          World, Collision, Adjusted, Params));
+        });
+
+        It("leaves a placement that cannot be moved out unchanged", [this]()
+        {
+            TestSurfaceActor->SetActorScale3D(FVector(50));
+            TestSurfaceActor->SetActorLocation(FVector(0, 0, 0));
+            const FSpawnedObstacleCollision Collision = AmbitSpawnerCollisionHelpers::MakeSpawnedObstacleCollision(
+                TestSpawnedActor->GetClass());
+            const FCollisionQueryParams Params(SCENE_QUERY_STAT(AmbitTest), false, TestSpawnedActor);
+            const FTransform Blocked(FVector::ZeroVector);
+
+            FTransform Adjusted = Blocked;
+            TestTrue("is blocked", AmbitSpawnerCollisionHelpers::IsPlacementBlocked(World, Collision, Blocked, Params));
+            TestFalse("is not adjusted", AmbitSpawnerCollisionHelpers::AdjustBlockedPlacement(
+                          World, Collision, Adjusted, Params));
+            TestTrue("is unchanged", Adjusted.Equals(Blocked, 0.f));
+        });
+    });
+
     Describe("StoreCollisionProfiles()", [this]()
     {
         It("does nothing when there are no components given", [this]()
@@ -0,0 +1,133 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitSplineSampler.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+
+AmbitSplineSampler::FSplineSnapshot::FSplineSnapshot(const USplineComponent& Spline)
+    : Curves(Spline.SplineCurves)
+    , ComponentTransform(Spline.GetComponentTransform())
+    , DefaultUpVector(Spline.DefaultUpVector)
+{
+}
+
+float AmbitSplineSampler::FSplineSnapshot::GetInputKeyAtDistance(float Distance, int32& Hint) const
+{
+    const TArray<FInterpCurvePoint<float>>& Points = Curves.ReparamTable.Points;
+    const int32 NumPoints = Points.Num();
+    if (NumPoints == 0)
+    {
+        return 0.f;
+    }
+    if (NumPoints == 1 || Distance < Points[0].InVal)
+    {
+        Hint = 0;
+        return Points[0].OutVal;
+    }
+    if (Distance >= Points.Last().InVal)
+    {
+        Hint = NumPoints - 1;
+        return Points.Last().OutVal;
+    }
+
+    // Find the last point at or before Distance, walking forward from the hint when it is behind.
+    int32 Index = Hint;
+    if (!Points.IsValidIndex(Index) || Points[Index].InVal > Distance)
+    {
+        Index = Algo::UpperBoundBy(Points, Distance, &FInterpCurvePoint<float>::InVal) - 1;
+    }
+    else
+    {
+        while (Points[Index + 1].InVal <= Distance)
+        {
+            Index++;
+        }
+    }
+    Hint = Index;
+
+    // Linear, like FInterpCurve::Eval() on the table.
+    const float Span = Points[Index + 1].InVal - Points[Index].InVal;
+    if (Span <= 0.f)
+    {
+        return Points[Index].OutVal;
+    }
+    const float Alpha = (Distance - Points[Index].InVal) / Span;
+    return FMath::Lerp(Points[Index].OutVal, Points[Index + 1].OutVal, Alpha);
+}
+
+AmbitSplineSampler::FSplineSample AmbitSplineSampler::FSplineSnapshot::SampleAtInputKey(
+    float InputKey, ESplineCoordinateSpace::Type CoordinateSpace) const
+{
+    FSplineSample Sample;
+    Sample.Location = Curves.Position.Eval(InputKey, FVector::ZeroVector);
+    Sample.Tangent = Curves.Position.EvalDerivative(InputKey, FVector::ZeroVector);
+
+    // The rotation faces along the tangent, rolled by the rotation curve,
+    // as in USplineComponent::GetQuaternionAtSplineInputKey().
+    FQuat Roll = Curves.Rotation.Eval(InputKey, FQuat::Identity);
+    Roll.Normalize();
+    FQuat Rotation = FRotationMatrix::MakeFromXZ(Sample.Tangent.GetSafeNormal(),
+                                                 Roll.RotateVector(DefaultUpVector)).ToQuat();
+
+    if (CoordinateSpace == ESplineCoordinateSpace::World)
+    {
+        Sample.Location = ComponentTransform.TransformPosition(Sample.Location);
+        Sample.Tangent = ComponentTransform.TransformVector(Sample.Tangent);
+        Rotation = ComponentTransform.GetRotation() * Rotation;
+    }
+    Sample.Rotation = Rotation.Rotator();
+    return Sample;
+}
+
+TArray<AmbitSplineSampler::FSplineSample> AmbitSplineSampler::SampleAtDistances(
+    const FSplineSnapshot& Spline, const TArray<float>& Distances, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+    // Resolve the distances in increasing order, so that the table is walked only once.
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Distances.Num());
+    for (int32 i = 0; i < Order.Num(); i++)
+    {
+        Order[i] = i;
+    }
+    if (!Algo::IsSorted(Distances))
+    {
+        Order.StableSort([&Distances](int32 A, int32 B)
+        {
+            return Distances[A] < Distances[B];
+        });
+    }
+
+    TArray<FSplineSample> Samples;
+    Samples.SetNum(Distances.Num());
+    int32 Hint = INDEX_NONE;
+    for (const int32 Index : Order)
+    {
+        Samples[Index] = Spline.SampleAtInputKey(Spline.GetInputKeyAtDistance(Distances[Index], Hint),
+                                                 CoordinateSpace);
+    }
+    return Samples;
+}
+
+TArray<AmbitSplineSampler::FSplineSample> AmbitSplineSampler::SampleAtDistances(
+    const USplineComponent* Spline, const TArray<float>& Distances, ESplineCoordinateSpace::Type CoordinateSpace)
+{
+    if (!IsValid(Spline))
+    {
+        return TArray<FSplineSample>();
+    }
+    return SampleAtDistances(FSplineSnapshot(*Spline), Distances, CoordinateSpace);
+}
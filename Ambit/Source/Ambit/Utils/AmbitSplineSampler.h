@@ -0,0 +1,112 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+
+/**
+ * Helpers that evaluate splines at many distances along their length,
+ * resolving each distance to a spline input key only once.
+ */
+namespace AmbitSplineSampler
+{
+    /**
+     * A point on a spline.
+     */
+    struct FSplineSample
+    {
+        FVector Location = FVector::ZeroVector;
+        FVector Tangent = FVector::ZeroVector;
+        FRotator Rotation = FRotator::ZeroRotator;
+    };
+
+    /**
+     * A copy of the curves and placement of a spline component. It is plain data,
+     * so it can be evaluated on any thread while the component is edited or destroyed.
+     */
+    struct FSplineSnapshot
+    {
+        FSplineCurves Curves;
+
+        FTransform ComponentTransform;
+
+        // The up vector that the rotation curve of the spline rotates.
+        FVector DefaultUpVector = FVector::UpVector;
+
+        FSplineSnapshot() = default;
+
+        explicit FSplineSnapshot(const USplineComponent& Spline);
+
+        float GetLength() const
+        {
+            return Curves.GetSplineLength();
+        }
+
+        /**
+         * Returns the spline input key at Distance, which is the key that
+         * USplineComponent::GetLocationAtDistanceAlongSpline() and the other functions
+         * at a distance evaluate at. Unlike USplineComponent::GetInputKeyAtDistanceAlongSpline(),
+         * it is not scaled by the Duration of the spline.
+         *
+         * @param Distance
+         *  the distance along the spline
+         * @param Hint
+         *  the segment of the reparameterization table the previous distance fell in,
+         *  if distances are evaluated in increasing order. Updated to the segment of Distance.
+         */
+        float GetInputKeyAtDistance(float Distance, int32& Hint) const;
+
+        float GetInputKeyAtDistance(float Distance) const
+        {
+            int32 Hint = INDEX_NONE;
+            return GetInputKeyAtDistance(Distance, Hint);
+        }
+
+        /**
+         * Evaluates the spline at InputKey as USplineComponent does, evaluating the position curve
+         * and its derivative once for the location, tangent and rotation.
+         *
+         * @param InputKey
+         *  the spline input key to evaluate at
+         * @param CoordinateSpace
+         *  the space to return the sample in
+         */
+        FSplineSample SampleAtInputKey(float InputKey, ESplineCoordinateSpace::Type CoordinateSpace) const;
+    };
+
+    /**
+     * Evaluates Spline at many distances along it. The distances are resolved in
+     * increasing order in a single pass over its reparameterization table, whatever order they are given in.
+     *
+     * @param Spline
+     *  the spline to evaluate
+     * @param Distances
+     *  the distances along the spline, in cm
+     * @param CoordinateSpace
+     *  the space to return the samples in
+     * @return
+     *  one sample per distance, in the same order as Distances
+     */
+    TArray<FSplineSample> SampleAtDistances(const FSplineSnapshot& Spline, const TArray<float>& Distances,
+                                            ESplineCoordinateSpace::Type CoordinateSpace);
+
+    /**
+     * Same as above, for a snapshot of Spline taken now. Returns no samples for an invalid spline.
+     */
+    TArray<FSplineSample> SampleAtDistances(const USplineComponent* Spline, const TArray<float>& Distances,
+                                            ESplineCoordinateSpace::Type CoordinateSpace);
+}
@@ -0,0 +1,200 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitSplineSampler.h"
+
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+BEGIN_DEFINE_SPEC(AmbitSplineSamplerSpec, "Ambit.Unit.AmbitSplineSampler",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    USplineComponent* Spline;
+
+    // Distances spread over the whole spline, in increasing order.
+    TArray<float> GetDistances() const
+    {
+        TArray<float> Distances;
+        const float Length = Spline->GetSplineLength();
+        for (int32 i = 0; i <= 40; i++)
+        {
+            Distances.Add(Length * i / 40.f);
+        }
+        return Distances;
+    }
+END_DEFINE_SPEC(AmbitSplineSamplerSpec)
+
+void AmbitSplineSamplerSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        AActor* Owner = World->SpawnActor<AActor>(AActor::StaticClass(),
+                                                  FTransform(FRotator(0, 30, 0), FVector(100, 200, 0)));
+        Spline = NewObject<USplineComponent>(Owner, USplineComponent::StaticClass(), "Spline");
+        Owner->SetRootComponent(Spline);
+        Spline->RegisterComponent();
+
+        // A curved road with uneven segments.
+        Spline->SetSplinePoints({FVector(0, 0, 0), FVector(1000, 0, 0), FVector(1500, 800, 50), FVector(4000, 900, 0)},
+                                ESplineCoordinateSpace::Local);
+    });
+
+    Describe("FSplineSnapshot", [this]()
+    {
+        It("has the length of the spline", [this]()
+        {
+            const AmbitSplineSampler::FSplineSnapshot Snapshot(*Spline);
+            TestEqual("The lengths match.", Snapshot.GetLength(), Spline->GetSplineLength());
+        });
+
+        It("is not changed by later edits of the spline", [this]()
+        {
+            const AmbitSplineSampler::FSplineSnapshot Snapshot(*Spline);
+            const float Length = Spline->GetSplineLength();
+
+            Spline->AddSplinePoint(FVector(5000, 900, 0), ESplineCoordinateSpace::Local);
+            TestEqual("The length is kept.", Snapshot.GetLength(), Length);
+            TestEqual("The end is kept.", Snapshot.SampleAtInputKey(3.f, ESplineCoordinateSpace::Local).Location,
+                      FVector(4000, 900, 0), 0.01f);
+        });
+
+        It("resolves distances to the keys that the spline evaluates them at whatever its duration", [this]()
+        {
+            Spline->SetDuration(7.f);
+            const AmbitSplineSampler::FSplineSnapshot Snapshot(*Spline);
+
+            for (const float Distance : GetDistances())
+            {
+                const float InputKey = Snapshot.GetInputKeyAtDistance(Distance);
+                const FVector Location = Snapshot.SampleAtInputKey(InputKey, ESplineCoordinateSpace::World).Location;
+                TestEqual("The keys match.", InputKey, Spline->SplineCurves.ReparamTable.Eval(Distance, 0.f),
+                          KINDA_SMALL_NUMBER);
+                TestEqual("The locations match.", Location,
+                          Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+            }
+        });
+
+        It("evaluates input keys as the spline does", [this]()
+        {
+            // Rolled points test that the rotation follows the rotation curve as well as the tangent.
+            Spline->SetRotationAtSplinePoint(1, FRotator(0, 0, 30), ESplineCoordinateSpace::Local);
+            Spline->SetRotationAtSplinePoint(2, FRotator(0, 0, -45), ESplineCoordinateSpace::Local);
+            const AmbitSplineSampler::FSplineSnapshot Snapshot(*Spline);
+
+            for (float InputKey = 0.f; InputKey <= 3.f; InputKey += 0.125f)
+            {
+                const AmbitSplineSampler::FSplineSample Sample = Snapshot.SampleAtInputKey(
+                    InputKey, ESplineCoordinateSpace::World);
+                TestEqual("The locations match.", Sample.Location,
+                          Spline->GetLocationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+                TestEqual("The tangents match.", Sample.Tangent,
+                          Spline->GetTangentAtSplineInputKey(InputKey, ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+                TestTrue("The rotations match.", Sample.Rotation.Equals(
+                             Spline->GetRotationAtSplineInputKey(InputKey, ESplineCoordinateSpace::World),
+                             KINDA_SMALL_NUMBER));
+            }
+        });
+    });
+
+    Describe("SampleAtDistances()", [this]()
+    {
+        It("matches evaluating the spline one distance at a time", [this]()
+        {
+            const TArray<float> Distances = GetDistances();
+            const TArray<AmbitSplineSampler::FSplineSample> Samples = AmbitSplineSampler::SampleAtDistances(
+                Spline, Distances, ESplineCoordinateSpace::World);
+            TestEqual("There is one sample per distance.", Samples.Num(), Distances.Num());
+
+            for (int32 i = 0; i < Samples.Num(); i++)
+            {
+                const float Distance = Distances[i];
+                TestEqual("The locations match.", Samples[i].Location,
+                          Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+                TestEqual("The tangents match.", Samples[i].Tangent,
+                          Spline->GetTangentAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+                TestTrue("The rotations match.", Samples[i].Rotation.Equals(
+                             Spline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World),
+                             KINDA_SMALL_NUMBER));
+            }
+        });
+
+        It("accepts distances in any order", [this]()
+        {
+            const TArray<float> Sorted = GetDistances();
+            TArray<float> Shuffled = Sorted;
+            FRandomStream Random(7);
+            for (int32 i = Shuffled.Num() - 1; i > 0; i--)
+            {
+                Shuffled.Swap(i, Random.RandRange(0, i));
+            }
+
+            const auto SortedSamples = AmbitSplineSampler::SampleAtDistances(Spline, Sorted,
+                                                                             ESplineCoordinateSpace::Local);
+            const auto ShuffledSamples = AmbitSplineSampler::SampleAtDistances(Spline, Shuffled,
+                                                                               ESplineCoordinateSpace::Local);
+            for (int32 i = 0; i < Shuffled.Num(); i++)
+            {
+                const int32 SortedIndex = Sorted.IndexOfByKey(Shuffled[i]);
+                TestEqual("The locations match.", ShuffledSamples[i].Location, SortedSamples[SortedIndex].Location);
+            }
+        });
+
+        It("matches evaluating the spline one distance at a time when its duration is not 1", [this]()
+        {
+            Spline->SetDuration(7.f);
+            const TArray<float> Distances = GetDistances();
+            const auto Samples = AmbitSplineSampler::SampleAtDistances(Spline, Distances,
+                                                                       ESplineCoordinateSpace::World);
+
+            for (int32 i = 0; i < Samples.Num(); i++)
+            {
+                TestEqual("The locations match.", Samples[i].Location,
+                          Spline->GetLocationAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::World),
+                          KINDA_SMALL_NUMBER);
+                TestTrue("The rotations match.", Samples[i].Rotation.Equals(
+                             Spline->GetRotationAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::World),
+                             KINDA_SMALL_NUMBER));
+            }
+        });
+
+        It("returns no samples for an invalid spline", [this]()
+        {
+            TestEqual("There are no samples.", AmbitSplineSampler::SampleAtDistances(
+                          static_cast<const USplineComponent*>(nullptr), GetDistances(),
+                          ESplineCoordinateSpace::World).Num(), 0);
+        });
+
+        It("clamps distances beyond the ends of the spline", [this]()
+        {
+            const auto Samples = AmbitSplineSampler::SampleAtDistances(
+                Spline, {-100.f, Spline->GetSplineLength() + 100.f}, ESplineCoordinateSpace::Local);
+            TestEqual("The first sample is at the start.", Samples[0].Location, FVector(0, 0, 0), 0.01f);
+            TestEqual("The last sample is at the end.", Samples[1].Location, FVector(4000, 900, 0), 0.01f);
+        });
+    });
+}
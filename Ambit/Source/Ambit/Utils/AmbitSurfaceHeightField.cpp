@@ -0,0 +1,413 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitSurfaceHeightField.h"
+
+#include "EngineUtils.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#include "Ambit/AmbitModule.h"
+#include "Ambit/Utils/AmbitMeshSampler.h"
+
+namespace
+{
+    // Triangles stacked further apart than this, in cm, are treated as separate layers.
+    constexpr float KLayerTolerance = 1.f;
+
+    // Upper bound on the number of cells, about 200 MB of height field.
+    constexpr int64 KMaxCells = 1 << 23;
+
+    // Triangles whose normal has a smaller Z component cannot be hit from above.
+    constexpr float KMinUpwardNormalZ = KINDA_SMALL_NUMBER;
+
+    bool BlocksVisibility(const UPrimitiveComponent* Component)
+    {
+        return Component->IsQueryCollisionEnabled()
+               && Component->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block;
+    }
+
+    bool IsSampleableMesh(const UPrimitiveComponent* Component)
+    {
+        // Instances would each need their own transform, so instanced meshes fall back to traces.
+        return Component->IsA<UStaticMeshComponent>() && !Component->IsA<UInstancedStaticMeshComponent>();
+    }
+
+    bool bExportActive = false;
+
+    float ExportCellSize = 0.f;
+
+    TArray<TSharedPtr<FAmbitSurfaceHeightField>> HeightFields;
+}
+
+TSharedPtr<FAmbitSurfaceHeightField> FAmbitSurfaceHeightField::Build(const TArray<AActor*>& Surfaces, float CellSize)
+{
+    FBox Bounds(ForceInit);
+    for (const AActor* Surface : Surfaces)
+    {
+        if (IsValid(Surface))
+        {
+            Bounds += Surface->GetComponentsBoundingBox();
+        }
+    }
+    if (!Bounds.IsValid || CellSize <= 0.f)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FAmbitSurfaceHeightField> Field = MakeShared<FAmbitSurfaceHeightField>();
+
+    // Grow the cells until the grid fits in memory.
+    const FVector Size = Bounds.GetSize();
+    float ActualCellSize = CellSize;
+    while (static_cast<int64>(Size.X / ActualCellSize + 1) * static_cast<int64>(Size.Y / ActualCellSize + 1) >
+        KMaxCells)
+    {
+        ActualCellSize *= 2.f;
+    }
+    if (ActualCellSize != CellSize)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("The surfaces are too large for a %.1f cm height field. Using %.1f cm cells."),
+               CellSize, ActualCellSize);
+    }
+
+    Field->CellSize = ActualCellSize;
+    Field->Origin = FVector2D(Bounds.Min);
+    Field->Columns = FMath::Max(FMath::CeilToInt(Size.X / ActualCellSize), 1);
+    Field->Rows = FMath::Max(FMath::CeilToInt(Size.Y / ActualCellSize), 1);
+
+    const int32 CellCount = Field->Columns * Field->Rows;
+    Field->Heights.Init(-BIG_NUMBER, CellCount);
+    Field->LowestHeights.Init(BIG_NUMBER, CellCount);
+    Field->Normals.Init(FVector::UpVector, CellCount);
+    Field->Owners.Init(INDEX_NONE, CellCount);
+    Field->Flags.Init(0, CellCount);
+
+    TArray<const UPrimitiveComponent*> SurfaceComponents;
+    for (int32 Owner = 0; Owner < Surfaces.Num(); Owner++)
+    {
+        AActor* Surface = Surfaces[Owner];
+        Field->SurfaceActors.Emplace(Surface);
+        Field->SurfaceTransforms.Add(IsValid(Surface) ? Surface->GetActorTransform() : FTransform::Identity);
+        if (!IsValid(Surface))
+        {
+            continue;
+        }
+
+        TInlineComponentArray<UPrimitiveComponent*> Components(Surface);
+        for (const UPrimitiveComponent* Component : Components)
+        {
+            if (!BlocksVisibility(Component))
+            {
+                continue;
+            }
+            SurfaceComponents.Add(Component);
+
+            const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component);
+            const AmbitMeshSampler::FMeshTriangleTablePtr Table = IsSampleableMesh(Component)
+                ? AmbitMeshSampler::GetTriangleTable(MeshComponent->GetStaticMesh())
+                : nullptr;
+            if (!Table.IsValid())
+            {
+                // Landscapes, instanced meshes and the like are left to traces.
+                Field->MarkAmbiguous(Component->Bounds.GetBox(), false);
+                continue;
+            }
+
+            const FTransform& Transform = Component->GetComponentTransform();
+            const FVector InverseScale = Transform.GetScale3D().Reciprocal();
+            for (int32 Triangle = 0; Triangle < Table->NumTriangles(); Triangle++)
+            {
+                const FVector LocalNormal = Table->Normals[Triangle] * InverseScale;
+                const FVector Normal = Transform.GetRotation().RotateVector(LocalNormal).GetSafeNormal();
+                if (Normal.Z <= KMinUpwardNormalZ)
+                {
+                    continue;
+                }
+                Field->RasterizeTriangle(Transform.TransformPosition(Table->Corners[Triangle * 3]),
+                                         Transform.TransformPosition(Table->Corners[Triangle * 3 + 1]),
+                                         Transform.TransformPosition(Table->Corners[Triangle * 3 + 2]), Normal,
+                                         Owner);
+            }
+        }
+    }
+
+    // Cells with several layers depend on where the trace starts.
+    for (int32 Index = 0; Index < CellCount; Index++)
+    {
+        if ((Field->Flags[Index] & Solid) && Field->Heights[Index] - Field->LowestHeights[Index] > KLayerTolerance)
+        {
+            Field->Flags[Index] |= Ambiguous;
+        }
+    }
+
+    // Any other blocking geometry above a surface would stop the trace first.
+    UWorld* World = Surfaces.Num() > 0 && IsValid(Surfaces[0]) ? Surfaces[0]->GetWorld() : nullptr;
+    if (World != nullptr)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            const AActor* Actor = *It;
+            TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+            for (const UPrimitiveComponent* Component : Components)
+            {
+                if (BlocksVisibility(Component) && !SurfaceComponents.Contains(Component))
+                {
+                    Field->MarkAmbiguous(Component->Bounds.GetBox(), true);
+                }
+            }
+        }
+    }
+
+    return Field;
+}
+
+bool FAmbitSurfaceHeightField::GetCellRange(const FBox& Box, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+    OutMin.X = FMath::Max(FMath::FloorToInt((Box.Min.X - Origin.X) / CellSize), 0);
+    OutMin.Y = FMath::Max(FMath::FloorToInt((Box.Min.Y - Origin.Y) / CellSize), 0);
+    OutMax.X = FMath::Min(FMath::FloorToInt((Box.Max.X - Origin.X) / CellSize), Columns - 1);
+    OutMax.Y = FMath::Min(FMath::FloorToInt((Box.Max.Y - Origin.Y) / CellSize), Rows - 1);
+    return OutMin.X <= OutMax.X && OutMin.Y <= OutMax.Y;
+}
+
+void FAmbitSurfaceHeightField::RasterizeTriangle(const FVector& A, const FVector& B, const FVector& C,
+                                                 const FVector& Normal, int32 Owner)
+{
+    FBox TriangleBounds(ForceInit);
+    TriangleBounds += A;
+    TriangleBounds += B;
+    TriangleBounds += C;
+
+    FIntPoint Min;
+    FIntPoint Max;
+    if (!GetCellRange(TriangleBounds, Min, Max))
+    {
+        return;
+    }
+
+    // Barycentric coordinates of the cell centres in the XY projection of the triangle.
+    const float Denominator = (B.Y - C.Y) * (A.X - C.X) + (C.X - B.X) * (A.Y - C.Y);
+    if (FMath::IsNearlyZero(Denominator))
+    {
+        return;
+    }
+
+    for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+    {
+        for (int32 X = Min.X; X <= Max.X; X++)
+        {
+            const int32 Index = ToIndex(X, Y);
+            const float CenterX = Origin.X + (X + 0.5f) * CellSize;
+            const float CenterY = Origin.Y + (Y + 0.5f) * CellSize;
+            const float WeightA = ((B.Y - C.Y) * (CenterX - C.X) + (C.X - B.X) * (CenterY - C.Y)) / Denominator;
+            const float WeightB = ((C.Y - A.Y) * (CenterX - C.X) + (A.X - C.X) * (CenterY - C.Y)) / Denominator;
+            const float WeightC = 1.f - WeightA - WeightB;
+            if (WeightA < 0.f || WeightB < 0.f || WeightC < 0.f)
+            {
+                Flags[Index] |= Edge;
+                continue;
+            }
+
+            const float Height = WeightA * A.Z + WeightB * B.Z + WeightC * C.Z;
+            Flags[Index] |= Solid;
+            LowestHeights[Index] = FMath::Min(LowestHeights[Index], Height);
+            if (Height > Heights[Index])
+            {
+                Heights[Index] = Height;
+                Normals[Index] = Normal;
+                Owners[Index] = Owner;
+            }
+        }
+    }
+}
+
+void FAmbitSurfaceHeightField::MarkAmbiguous(const FBox& Box, bool bOnlyBelow)
+{
+    FIntPoint Min;
+    FIntPoint Max;
+    if (!GetCellRange(Box, Min, Max))
+    {
+        return;
+    }
+
+    for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+    {
+        for (int32 X = Min.X; X <= Max.X; X++)
+        {
+            const int32 Index = ToIndex(X, Y);
+            // Cells without a surface remain misses: the trace cannot hit a surface there either.
+            if (!bOnlyBelow || ((Flags[Index] & Solid) && Box.Max.Z > Heights[Index] - KLayerTolerance))
+            {
+                Flags[Index] |= Ambiguous;
+            }
+        }
+    }
+}
+
+FAmbitSurfaceHeightField::EQueryResult FAmbitSurfaceHeightField::Query(const FVector& Location,
+                                                                       FVector& OutImpactPoint,
+                                                                       FVector& OutImpactNormal,
+                                                                       AActor*& OutActor) const
+{
+    // Interpolate between the four cell centres around the location.
+    const float GridX = (Location.X - Origin.X) / CellSize - 0.5f;
+    const float GridY = (Location.Y - Origin.Y) / CellSize - 0.5f;
+    const int32 X0 = FMath::FloorToInt(GridX);
+    const int32 Y0 = FMath::FloorToInt(GridY);
+    if (X0 < -1 || Y0 < -1 || X0 >= Columns || Y0 >= Rows)
+    {
+        // Entirely outside the surfaces' bounds.
+        return EQueryResult::Miss;
+    }
+
+    int32 Indices[4];
+    int32 SolidCount = 0;
+    int32 EmptyCount = 0;
+    for (int32 Corner = 0; Corner < 4; Corner++)
+    {
+        const int32 X = X0 + (Corner & 1);
+        const int32 Y = Y0 + (Corner >> 1);
+        if (X < 0 || Y < 0 || X >= Columns || Y >= Rows)
+        {
+            // Beyond the bounds of the surfaces, as good as an empty cell.
+            Indices[Corner] = INDEX_NONE;
+            EmptyCount++;
+            continue;
+        }
+        Indices[Corner] = ToIndex(X, Y);
+        const uint8 CellFlags = Flags[Indices[Corner]];
+        if (CellFlags & Ambiguous)
+        {
+            return EQueryResult::Unknown;
+        }
+        SolidCount += (CellFlags & Solid) ? 1 : 0;
+        EmptyCount += CellFlags == 0 ? 1 : 0;
+    }
+
+    if (EmptyCount == 4)
+    {
+        return EQueryResult::Miss;
+    }
+
+    if (SolidCount < 4)
+    {
+        // On the edge of a surface.
+        return EQueryResult::Unknown;
+    }
+
+    const int32 Owner = Owners[Indices[0]];
+    if (Owners[Indices[1]] != Owner || Owners[Indices[2]] != Owner || Owners[Indices[3]] != Owner)
+    {
+        // Between two surfaces.
+        return EQueryResult::Unknown;
+    }
+
+    const float AlphaX = FMath::Clamp(GridX - X0, 0.f, 1.f);
+    const float AlphaY = FMath::Clamp(GridY - Y0, 0.f, 1.f);
+    const float Height = FMath::BiLerp(Heights[Indices[0]], Heights[Indices[1]], Heights[Indices[2]],
+                                       Heights[Indices[3]], AlphaX, AlphaY);
+    if (Height > Location.Z)
+    {
+        // The trace would start below the surface.
+        return EQueryResult::Unknown;
+    }
+
+    AActor* Actor = SurfaceActors[Owner].Get();
+    if (Actor == nullptr)
+    {
+        return EQueryResult::Unknown;
+    }
+
+    OutImpactPoint = FVector(Location.X, Location.Y, Height);
+    OutImpactNormal = FMath::BiLerp(Normals[Indices[0]], Normals[Indices[1]], Normals[Indices[2]],
+                                    Normals[Indices[3]], AlphaX, AlphaY).GetSafeNormal();
+    OutActor = Actor;
+    return EQueryResult::Hit;
+}
+
+bool FAmbitSurfaceHeightField::IsBuiltFrom(const TArray<AActor*>& Surfaces) const
+{
+    if (Surfaces.Num() != SurfaceActors.Num())
+    {
+        return false;
+    }
+    for (int32 i = 0; i < Surfaces.Num(); i++)
+    {
+        if (SurfaceActors[i].Get() != Surfaces[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FAmbitSurfaceHeightField::IsUpToDate() const
+{
+    for (int32 i = 0; i < SurfaceActors.Num(); i++)
+    {
+        const AActor* Surface = SurfaceActors[i].Get();
+        if (Surface == nullptr || !Surface->GetActorTransform().Equals(SurfaceTransforms[i], 0.f))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AmbitSurfaceHeightFieldCache::BeginExport(float CellSize)
+{
+    HeightFields.Empty();
+    ExportCellSize = CellSize;
+    bExportActive = CellSize > 0.f;
+}
+
+void AmbitSurfaceHeightFieldCache::EndExport()
+{
+    HeightFields.Empty();
+    bExportActive = false;
+}
+
+TSharedPtr<const FAmbitSurfaceHeightField> AmbitSurfaceHeightFieldCache::Find(const TArray<AActor*>& Surfaces)
+{
+    // The cache is only ever touched from the game thread; other threads trace the world.
+    if (!bExportActive || Surfaces.Num() == 0 || !IsInGameThread())
+    {
+        return nullptr;
+    }
+
+    for (int32 i = 0; i < HeightFields.Num(); i++)
+    {
+        if (HeightFields[i]->IsBuiltFrom(Surfaces))
+        {
+            if (HeightFields[i]->IsUpToDate())
+            {
+                return HeightFields[i];
+            }
+            // A surface moved since the field was built.
+            HeightFields.RemoveAtSwap(i);
+            break;
+        }
+    }
+
+    TSharedPtr<FAmbitSurfaceHeightField> Field = FAmbitSurfaceHeightField::Build(Surfaces, ExportCellSize);
+    if (Field.IsValid())
+    {
+        HeightFields.Add(Field);
+    }
+    return Field;
+}
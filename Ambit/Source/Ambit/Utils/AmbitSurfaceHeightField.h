@@ -0,0 +1,150 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A top-down raster of the upward-facing triangles of a set of surface actors,
+ * used to answer "what is directly below this point" without a line trace.
+ *
+ * Each cell stores the height, normal and owning surface of the topmost triangle
+ * at its centre. Cells covered by more than one layer (e.g. bridges), touched by
+ * other blocking geometry or on the edge of a surface cannot be answered reliably
+ * and are reported as unknown so that callers fall back to a trace.
+ */
+class FAmbitSurfaceHeightField
+{
+public:
+    enum class EQueryResult : uint8
+    {
+        // A surface is directly below the location.
+        Hit,
+        // None of the surfaces is below the location.
+        Miss,
+        // The height field cannot tell. Trace instead.
+        Unknown
+    };
+
+    /**
+     * Rasterizes the static mesh components of Surfaces that block the Visibility channel.
+     *
+     * @param Surfaces
+     *  the actors to rasterize
+     * @param CellSize
+     *  the size of a cell in cm. Grown automatically for very large areas.
+     * @return
+     *  nullptr if the surfaces have no bounds
+     */
+    static TSharedPtr<FAmbitSurfaceHeightField> Build(const TArray<AActor*>& Surfaces, float CellSize);
+
+    /**
+     * Looks up the surface directly below Location, as a downward line trace from Location would.
+     *
+     * @param Location
+     *  the location to look down from
+     * @param OutImpactPoint
+     *  the point on the surface below Location, if Hit
+     * @param OutImpactNormal
+     *  the normal of the surface below Location, if Hit
+     * @param OutActor
+     *  the surface below Location, if Hit
+     */
+    EQueryResult Query(const FVector& Location, FVector& OutImpactPoint, FVector& OutImpactNormal,
+                       AActor*& OutActor) const;
+
+    /**
+     * Checks whether the field was built from exactly these actors.
+     */
+    bool IsBuiltFrom(const TArray<AActor*>& Surfaces) const;
+
+    /**
+     * Checks whether every surface is still where it was when the field was built.
+     */
+    bool IsUpToDate() const;
+
+    float GetCellSize() const
+    {
+        return CellSize;
+    }
+
+private:
+    enum ECellFlags : uint8
+    {
+        // A triangle covers the centre of the cell.
+        Solid = 1 << 0,
+        // A triangle touches the cell without covering its centre.
+        Edge = 1 << 1,
+        // Several layers, foreign geometry or non-mesh surfaces make the cell unreliable.
+        Ambiguous = 1 << 2
+    };
+
+    float CellSize = 0.f;
+    FVector2D Origin = FVector2D::ZeroVector;
+    int32 Columns = 0;
+    int32 Rows = 0;
+
+    TArray<float> Heights;
+    TArray<float> LowestHeights;
+    TArray<FVector> Normals;
+    TArray<int32> Owners;
+    TArray<uint8> Flags;
+
+    TArray<TWeakObjectPtr<AActor>> SurfaceActors;
+    TArray<FTransform> SurfaceTransforms;
+
+    int32 ToIndex(int32 X, int32 Y) const
+    {
+        return Y * Columns + X;
+    }
+
+    // Returns the range of cells overlapped by an XY box, clamped to the grid.
+    bool GetCellRange(const FBox& Box, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+    void RasterizeTriangle(const FVector& A, const FVector& B, const FVector& C, const FVector& Normal,
+                           int32 Owner);
+
+    void MarkAmbiguous(const FBox& Box, bool bOnlyBelow);
+};
+
+/**
+ * Keeps height fields alive for the duration of an export, so that
+ * every permutation snaps against the same rasterized surfaces.
+ */
+namespace AmbitSurfaceHeightFieldCache
+{
+    /**
+     * Enables the cache until EndExport() is called.
+     *
+     * @param CellSize
+     *  the size of a height field cell in cm. 0 disables the cache.
+     */
+    void BeginExport(float CellSize);
+
+    /**
+     * Disables the cache and releases every height field.
+     */
+    void EndExport();
+
+    /**
+     * Returns the height field for Surfaces, building it if needed or if any surface has moved.
+     * Returns nullptr outside an export, or when called off the game thread.
+     *
+     * @param Surfaces
+     *  the actors the height field is built from
+     */
+    TSharedPtr<const FAmbitSurfaceHeightField> Find(const TArray<AActor*>& Surfaces);
+}
@@ -0,0 +1,243 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "AmbitSurfaceHeightField.h"
+
+#include "AmbitWorldHelpers.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "Ambit/AmbitModule.h"
+
+BEGIN_DEFINE_SPEC(AmbitSurfaceHeightFieldSpec, "Ambit.Unit.AmbitSurfaceHeightField",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    UStaticMesh* PlaneMesh;
+    UStaticMesh* CubeMesh;
+    AStaticMeshActor* Ground;
+
+    AStaticMeshActor* SpawnMeshActor(UStaticMesh* Mesh, const FTransform& Transform) const
+    {
+        AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+        Actor->SetMobility(EComponentMobility::Movable);
+        Actor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+        Actor->GetStaticMeshComponent()->SetCollisionProfileName(TEXT("BlockAll"));
+        return Actor;
+    }
+END_DEFINE_SPEC(AmbitSurfaceHeightFieldSpec)
+
+void AmbitSurfaceHeightFieldSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        // Create an empty test map;
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        PlaneMesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Plane.Plane'"));
+        CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        TestNotNull("Check if the plane mesh is properly loaded", PlaneMesh);
+        TestNotNull("Check if the cube mesh is properly loaded", CubeMesh);
+
+        // A 1000 cm by 1000 cm plane centred on the origin.
+        Ground = SpawnMeshActor(PlaneMesh, FTransform(FRotator::ZeroRotator, FVector::ZeroVector, FVector(10)));
+        TestNotNull("Check if the ground is properly created", Ground);
+    });
+
+    AfterEach([this]()
+    {
+        AmbitSurfaceHeightFieldCache::EndExport();
+    });
+
+    Describe("Build()", [this]()
+    {
+        It("returns nullptr without surfaces", [this]()
+        {
+            const TArray<AActor*> NoSurfaces;
+            TestFalse("The field is not valid.", FAmbitSurfaceHeightField::Build(NoSurfaces, 50.f).IsValid());
+        });
+
+        It("grows the cells of very large surfaces", [this]()
+        {
+            Ground->SetActorScale3D(FVector(10000, 10000, 1));
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 1.f);
+            TestTrue("The field is valid.", Field.IsValid());
+            TestTrue("The cells are larger than requested.", Field->GetCellSize() > 1.f);
+        });
+    });
+
+    Describe("Query()", [this]()
+    {
+        It("finds the surface below a location", [this]()
+        {
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 50.f);
+            TestTrue("The field is valid.", Field.IsValid());
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            const auto Result = Field->Query(FVector(120, -75, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query is a hit.", Result == FAmbitSurfaceHeightField::EQueryResult::Hit);
+            TestEqual("The impact point is on the ground.", ImpactPoint, FVector(120, -75, 0), 0.1f);
+            TestEqual("The normal points up.", ImpactNormal, FVector::UpVector, 0.01f);
+            TestEqual("The ground is hit.", HitActor, static_cast<AActor*>(Ground));
+        });
+
+        It("misses outside the surfaces", [this]()
+        {
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 50.f);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            const auto Result = Field->Query(FVector(5000, 5000, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query is a miss.", Result == FAmbitSurfaceHeightField::EQueryResult::Miss);
+        });
+
+        It("cannot tell on the edge of a surface", [this]()
+        {
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 50.f);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            const auto Result = Field->Query(FVector(500, 0, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query is unknown.", Result == FAmbitSurfaceHeightField::EQueryResult::Unknown);
+        });
+
+        It("cannot tell below the surface", [this]()
+        {
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 50.f);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            const auto Result = Field->Query(FVector(0, 0, -100), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query is unknown.", Result == FAmbitSurfaceHeightField::EQueryResult::Unknown);
+        });
+
+        It("cannot tell where two surfaces are stacked", [this]()
+        {
+            AStaticMeshActor* Bridge = SpawnMeshActor(PlaneMesh, FTransform(FRotator::ZeroRotator,
+                                                                            FVector(0, 0, 200), FVector(2)));
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground, Bridge}, 50.f);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            auto Result = Field->Query(FVector(0, 0, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query below the bridge is unknown.",
+                     Result == FAmbitSurfaceHeightField::EQueryResult::Unknown);
+
+            Result = Field->Query(FVector(400, 400, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query beside the bridge is a hit.", Result == FAmbitSurfaceHeightField::EQueryResult::Hit);
+        });
+
+        It("cannot tell below other blocking geometry", [this]()
+        {
+            SpawnMeshActor(CubeMesh, FTransform(FVector(0, 0, 100)));
+            const auto Field = FAmbitSurfaceHeightField::Build({Ground}, 50.f);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            auto Result = Field->Query(FVector(0, 0, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query above the cube is unknown.",
+                     Result == FAmbitSurfaceHeightField::EQueryResult::Unknown);
+
+            Result = Field->Query(FVector(-300, 300, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestTrue("The query away from the cube is a hit.", Result == FAmbitSurfaceHeightField::EQueryResult::Hit);
+        });
+    });
+
+    Describe("AmbitSurfaceHeightFieldCache", [this]()
+    {
+        It("returns nullptr outside an export", [this]()
+        {
+            TestFalse("No field is cached.", AmbitSurfaceHeightFieldCache::Find({Ground}).IsValid());
+
+            AmbitSurfaceHeightFieldCache::BeginExport(0.f);
+            TestFalse("A cell size of 0 disables the cache.", AmbitSurfaceHeightFieldCache::Find({Ground}).IsValid());
+        });
+
+        It("reuses the field until a surface moves", [this]()
+        {
+            AmbitSurfaceHeightFieldCache::BeginExport(50.f);
+            const auto First = AmbitSurfaceHeightFieldCache::Find({Ground});
+            const auto Second = AmbitSurfaceHeightFieldCache::Find({Ground});
+            TestTrue("The field is valid.", First.IsValid());
+            TestTrue("The same field is returned.", First == Second);
+
+            Ground->SetActorLocation(FVector(0, 0, 50));
+            const auto Moved = AmbitSurfaceHeightFieldCache::Find({Ground});
+            TestTrue("The field is rebuilt.", First != Moved);
+
+            FVector ImpactPoint;
+            FVector ImpactNormal;
+            AActor* HitActor = nullptr;
+            Moved->Query(FVector(0, 0, 300), ImpactPoint, ImpactNormal, HitActor);
+            TestEqual("The rebuilt field follows the surface.", ImpactPoint.Z, 50.f, 0.1f);
+
+            AmbitSurfaceHeightFieldCache::EndExport();
+            TestFalse("Ending the export releases the field.", AmbitSurfaceHeightFieldCache::Find({Ground}).IsValid());
+        });
+
+        It("snaps like a line trace during an export", [this]()
+        {
+            Ground->SetActorRotation(FRotator(10, 0, 0));
+            const FTransform Start(FVector(100, 50, 500));
+
+            FTransform Traced = Start;
+            const bool bTraceHit = AmbitWorldHelpers::CheckAndSnapToSurface(Traced, {Ground}, true);
+
+            AmbitSurfaceHeightFieldCache::BeginExport(25.f);
+            FTransform Cached = Start;
+            const bool bCacheHit = AmbitWorldHelpers::CheckAndSnapToSurface(Cached, {Ground}, true);
+
+            TestTrue("The trace hits.", bTraceHit);
+            TestTrue("The height field hits.", bCacheHit);
+            TestEqual("The locations match.", Cached.GetLocation(), Traced.GetLocation(), 0.5f);
+            TestTrue("The rotations match.", Cached.GetRotation().Equals(Traced.GetRotation(), 0.01f));
+        });
+
+        It("generates the same placements as line traces during an export", [this]()
+        {
+            Ground->SetActorRotation(FRotator(10, 0, 0));
+            const TArray<AActor*> Surfaces = {Ground};
+
+            const TArray<FTransform> Traced = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                Surfaces, 0, 1.f, 2.f);
+
+            AmbitSurfaceHeightFieldCache::BeginExport(25.f);
+            const TArray<FTransform> Cached = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                Surfaces, 0, 1.f, 2.f);
+
+            TestTrue("The traces generate placements.", Traced.Num() > 0);
+            TestEqual("The number of placements matches.", Cached.Num(), Traced.Num());
+            bool bAllMatch = Cached.Num() == Traced.Num();
+            for (int32 i = 0; bAllMatch && i < Traced.Num(); i++)
+            {
+                bAllMatch = Cached[i].GetLocation().Equals(Traced[i].GetLocation(), 0.5f)
+                    && Cached[i].GetRotation().Equals(Traced[i].GetRotation(), 0.01f);
+            }
+            TestTrue("The placements match.", bAllMatch);
+        });
+    });
+}
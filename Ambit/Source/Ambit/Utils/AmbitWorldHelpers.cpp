@@ -15,12 +15,82 @@
 #include "AmbitWorldHelpers.h"
 
 #include "EngineUtils.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Math/UnrealMathUtility.h"
 
 #include "Ambit/AmbitModule.h"
+#include "Ambit/Utils/AmbitActorIndexSubsystem.h"
+#include "Ambit/Utils/AmbitActorPoolSubsystem.h"
+#include "Ambit/Utils/AmbitCounterRandom.h"
+#include "Ambit/Utils/AmbitMeshSampler.h"
+#include "Ambit/Utils/AmbitPoissonDisk.h"
+#include "Ambit/Utils/AmbitSplineSampler.h"
+#include "Ambit/Utils/AmbitSurfaceHeightField.h"
+#include "Ambit/Utils/AmbitWorldSnapshot.h"
+
+namespace
+{
+    FIntPoint ToInstanceCell(const FVector& Location, float CellSize)
+    {
+        return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+    }
+
+    using FInstanceCells = AmbitWorldHelpers::FSurfaceComponents::FInstanceCells;
+
+    // Buckets the instance bodies of Instances by the grid cells their bounds cover. Cells are sized
+    // after the average instance, so each instance covers a few cells and each cell holds a few instances.
+    FInstanceCells BucketInstances(const UInstancedStaticMeshComponent& Instances)
+    {
+        TArray<FBox> BodyBounds;
+        BodyBounds.Init(FBox(ForceInit), Instances.InstanceBodies.Num());
+        FVector2D TotalExtent = FVector2D::ZeroVector;
+        int32 NumBodies = 0;
+        for (int32 i = 0; i < Instances.InstanceBodies.Num(); i++)
+        {
+            if (const FBodyInstance* Body = Instances.InstanceBodies[i])
+            {
+                BodyBounds[i] = Body->GetBodyBounds();
+                TotalExtent += FVector2D(BodyBounds[i].GetSize());
+                NumBodies++;
+            }
+        }
+
+        FInstanceCells InstanceCells;
+        if (NumBodies == 0)
+        {
+            return InstanceCells;
+        }
+        InstanceCells.CellSize = FMath::Max(TotalExtent.GetMax() / NumBodies, 1.f);
+        for (int32 i = 0; i < BodyBounds.Num(); i++)
+        {
+            if (!BodyBounds[i].IsValid)
+            {
+                continue;
+            }
+            const FIntPoint Min = ToInstanceCell(BodyBounds[i].Min, InstanceCells.CellSize);
+            const FIntPoint Max = ToInstanceCell(BodyBounds[i].Max, InstanceCells.CellSize);
+            for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+            {
+                for (int32 X = Min.X; X <= Max.X; X++)
+                {
+                    InstanceCells.Cells.FindOrAdd(FIntPoint(X, Y)).Add(i);
+                }
+            }
+        }
+        return InstanceCells;
+    }
+}
+
+const TArray<int32>* AmbitWorldHelpers::FSurfaceComponents::FInstanceCells::Find(const FVector& Location) const
+{
+    return Cells.Find(ToInstanceCell(Location, CellSize));
+}
 
 FHitResult AmbitWorldHelpers::LineTraceBelowWorldPoint(const FVector& Location, const float MaxDistance)
 {
@@ -34,28 +104,171 @@ FHitResult AmbitWorldHelpers::LineTraceBelowWorldPoint(const FVector& Location,
     return Hit;
 }
 
+TArray<FHitResult> AmbitWorldHelpers::LineTraceBelowWorldPoints(const TArray<FVector>& Locations,
+                                                                const float MaxDistance, const bool bParallel)
+{
+    TArray<FHitResult> Hits;
+    Hits.SetNum(Locations.Num());
+    if (Locations.Num() == 0)
+    {
+        return Hits;
+    }
+
+    // Resolve the world and the query parameters once on the calling thread;
+    // scene queries themselves are read-only and safe to issue from worker threads.
+    UWorld* World = GEngine->GetWorldContexts()[0].World();
+    const FCollisionQueryParams QueryParams{FName("Visibility")};
+    const FCollisionResponseParams ResponseParams{};
+    const FVector Offset(0, 0, -MaxDistance);
+
+    // Each trace writes only to its own slot, so the gathered results are in
+    // the same order as Locations regardless of how the work was scheduled.
+    ParallelFor(Locations.Num(), [&](int32 Index)
+    {
+        const FVector& LineStart = Locations[Index];
+        World->LineTraceSingleByChannel(Hits[Index], LineStart, LineStart + Offset, ECC_Visibility, QueryParams,
+                                        ResponseParams);
+    }, !bParallel);
+
+    return Hits;
+}
+
+AmbitWorldHelpers::FSurfaceComponents AmbitWorldHelpers::GetSurfaceComponents(const TArray<AActor*>& Actors)
+{
+    FSurfaceComponents Surface;
+    for (AActor* Actor : Actors)
+    {
+        if (!IsValid(Actor))
+        {
+            continue;
+        }
+        TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+        for (UPrimitiveComponent* Primitive : Primitives)
+        {
+            if (Primitive->IsRegistered() && Primitive->IsQueryCollisionEnabled()
+                && Primitive->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block)
+            {
+                Surface.Components.Add(Primitive);
+                Surface.Bounds += Primitive->Bounds.GetBox();
+                if (const UInstancedStaticMeshComponent* Instances = Cast<UInstancedStaticMeshComponent>(Primitive))
+                {
+                    Surface.InstanceCells.Add(Primitive, BucketInstances(*Instances));
+                }
+            }
+        }
+    }
+    return Surface;
+}
+
+FHitResult AmbitWorldHelpers::LineTraceBelowOnSurface(const FVector& Location, const FSurfaceComponents& Surface)
+{
+    FHitResult Hit;
+    const FBox& Bounds = Surface.Bounds;
+    if (!Bounds.IsValid || Location.Z < Bounds.Min.Z || Location.X < Bounds.Min.X || Location.X > Bounds.Max.X
+        || Location.Y < Bounds.Min.Y || Location.Y > Bounds.Max.Y)
+    {
+        return Hit;
+    }
+
+    // Starting just above the surfaces and stopping just below them does not change which point is hit.
+    const FVector LineStart(Location.X, Location.Y, FMath::Min(Location.Z, Bounds.Max.Z + 1));
+    const FVector LineEnd(Location.X, Location.Y, Bounds.Min.Z - 1);
+    const FCollisionQueryParams QueryParams{FName("Visibility")};
+    const auto KeepClosest = [&Hit](const FHitResult& ComponentHit)
+    {
+        if (!Hit.bBlockingHit || ComponentHit.Time < Hit.Time)
+        {
+            Hit = ComponentHit;
+            Hit.bBlockingHit = true;
+        }
+    };
+    for (UPrimitiveComponent* Component : Surface.Components)
+    {
+        const FBox ComponentBounds = Component->Bounds.GetBox();
+        if (LineStart.X < ComponentBounds.Min.X || LineStart.X > ComponentBounds.Max.X
+            || LineStart.Y < ComponentBounds.Min.Y || LineStart.Y > ComponentBounds.Max.Y)
+        {
+            continue;
+        }
+
+        FHitResult ComponentHit;
+        // Instances have a body each, and the component's own body is empty.
+        // Only the instances bucketed under the trace are tested.
+        if (const UInstancedStaticMeshComponent* Instances = Cast<UInstancedStaticMeshComponent>(Component))
+        {
+            const FSurfaceComponents::FInstanceCells* InstanceCells = Surface.InstanceCells.Find(Component);
+            const TArray<int32>* InstanceIndices = InstanceCells != nullptr ? InstanceCells->Find(LineStart) : nullptr;
+            if (InstanceIndices == nullptr)
+            {
+                continue;
+            }
+            for (const int32 InstanceIndex : *InstanceIndices)
+            {
+                const FBodyInstance* InstanceBody = Instances->InstanceBodies.IsValidIndex(InstanceIndex)
+                                                        ? Instances->InstanceBodies[InstanceIndex]
+                                                        : nullptr;
+                if (InstanceBody != nullptr
+                    && InstanceBody->LineTrace(ComponentHit, LineStart, LineEnd, QueryParams.bTraceComplex))
+                {
+                    KeepClosest(ComponentHit);
+                }
+            }
+        }
+        else if (Component->LineTraceComponent(ComponentHit, LineStart, LineEnd, QueryParams))
+        {
+            KeepClosest(ComponentHit);
+        }
+    }
+    return Hit;
+}
+
 TArray<AActor*> AmbitWorldHelpers::GetActorsByMatchBy(const EMatchBy& MatchBy, const FString& NamePattern,
                                                       const TArray<FName>& TagsList, const bool bMatchExactName)
 {
+    // During an export, the surfaces of every spawner were matched once when it started.
+    const TSharedPtr<const FAmbitWorldSnapshot> Snapshot = AmbitWorldSnapshot::Get();
+    if (Snapshot.IsValid())
+    {
+        if (const TArray<AActor*>* Matched = Snapshot->FindActors({MatchBy, NamePattern, TagsList, bMatchExactName}))
+        {
+            return *Matched;
+        }
+    }
+
+    const UWorld* World = GEngine->GetWorldContexts()[0].World();
+    UAmbitActorIndexSubsystem* ActorIndex = World != nullptr
+                                                ? World->GetSubsystem<UAmbitActorIndexSubsystem>()
+                                                : nullptr;
+    if (ActorIndex == nullptr)
+    {
+        return ScanActorsByMatchBy(MatchBy, NamePattern, TagsList, bMatchExactName);
+    }
+    return ActorIndex->FindActors(MatchBy, NamePattern, TagsList, bMatchExactName);
+}
+
+TArray<AActor*> AmbitWorldHelpers::ScanActorsByMatchBy(const EMatchBy& MatchBy, const FString& NamePattern,
+                                                       const TArray<FName>& TagsList, const bool bMatchExactName)
+{
+    UWorld* World = GEngine->GetWorldContexts()[0].World();
     TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GEngine->GetWorldContexts()[0].World(), AActor::StaticClass(), AllActors);
+    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
 
     // Filter actors to just those matching criteria.
-    bool bNamePatternIsEmpty = NamePattern.IsEmpty();
     bool bTagsListIsEmpty = TagsList.Num() == 0;
+    const UAmbitActorPoolSubsystem* ActorPool = World->GetSubsystem<UAmbitActorPoolSubsystem>();
 
     return AllActors.FilterByPredicate(
-        [MatchBy, NamePattern, TagsList, bNamePatternIsEmpty, bTagsListIsEmpty, bMatchExactName](const AActor* Actor)
+        [MatchBy, NamePattern, TagsList, bTagsListIsEmpty, bMatchExactName, ActorPool](const AActor* Actor)
         {
-            // if name pattern is empty, default to false. Else match to the name pattern.
-            bool bMatchesName = false;
-
-            if (!bNamePatternIsEmpty && (bMatchExactName && Actor->GetName() == NamePattern || Actor->GetName().
-                Contains(NamePattern)))
+            // Actors waiting in the actor pool are not part of the level.
+            if (ActorPool != nullptr && ActorPool->IsPooled(Actor))
             {
-                bMatchesName = true;
+                return false;
             }
 
+            // if name pattern is empty, default to false. Else match to the name pattern.
+            const bool bMatchesName = MatchesNamePattern(Actor->GetName(), NamePattern, bMatchExactName);
+
             // if the tags list is empty, default to false. Else match to tags.
             bool bMatchesTags = !bTagsListIsEmpty;
             for (FName Tag : TagsList)
@@ -81,37 +294,96 @@ TArray<AActor*> AmbitWorldHelpers::GetActorsByMatchBy(const EMatchBy& MatchBy, c
         });
 }
 
+bool AmbitWorldHelpers::MatchesNamePattern(const FString& ActorName, const FString& NamePattern,
+                                           const bool bMatchExactName)
+{
+    return !NamePattern.IsEmpty() && (bMatchExactName && ActorName == NamePattern || ActorName.Contains(NamePattern));
+}
+
 TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromActors(const TArray<AActor*>& ActorsToSearch,
                                                                         int32 RandomSeed, float DensityMin,
                                                                         float DensityMax, float RotationMin,
-                                                                        float RotationMax)
+                                                                        float RotationMax, bool bParallelTraces,
+                                                                        EPlacementDistribution Distribution,
+                                                                        float MinSpacing, uint32 SpawnerId,
+                                                                        bool bTraceMatchedSurfacesOnly)
 {
-    TArray<FTransform> Transforms;
+    const FPlacementCandidates Candidates = DrawLocationsFromSurfaces(
+        GetSurfaceExtents(ActorsToSearch), RandomSeed, DensityMin, DensityMax, RotationMin, RotationMax,
+        bParallelTraces, Distribution, MinSpacing, SpawnerId);
+    return SnapToOwnSurfaces(Candidates, ActorsToSearch, bParallelTraces, bTraceMatchedSurfacesOnly);
+}
+
+TArray<AmbitWorldHelpers::FSurfaceExtent> AmbitWorldHelpers::GetSurfaceExtents(const TArray<AActor*>& Actors)
+{
+    TArray<FSurfaceExtent> Extents;
+    Extents.Reserve(Actors.Num());
+    const TSharedPtr<const FAmbitWorldSnapshot> Snapshot = AmbitWorldSnapshot::Get();
+    for (AActor* Actor : Actors)
+    {
+        // Calculate the surface area of this actor to determine how many items to spawn.
+        const FAmbitWorldSnapshot::FSurface* Surface = Snapshot.IsValid() ? Snapshot->FindSurface(Actor) : nullptr;
+        FSurfaceExtent& Extent = Extents.AddDefaulted_GetRef();
+        if (Surface != nullptr)
+        {
+            Extent.Bounds = Surface->Bounds;
+            Extent.AreaMeters = Surface->AreaMeters;
+        }
+        else
+        {
+            Extent.Bounds = Actor->GetComponentsBoundingBox();
+            const FVector SizeMeters = Extent.Bounds.GetSize() / 100.f;
+            Extent.AreaMeters = SizeMeters.X * SizeMeters.Y;
+        }
+    }
+    return Extents;
+}
+
+AmbitWorldHelpers::FPlacementCandidates AmbitWorldHelpers::DrawLocationsFromSurfaces(
+    const TArray<FSurfaceExtent>& Surfaces, int32 RandomSeed, float DensityMin, float DensityMax, float RotationMin,
+    float RotationMax, bool bParallel, EPlacementDistribution Distribution, float MinSpacing, uint32 SpawnerId)
+{
+    FPlacementCandidates Candidates;
     if (DensityMin > DensityMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("DensityMin is greater than DensityMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
 
     if (RotationMin > RotationMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("RotationMin is greater than RotationMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
 
-    FRandomStream Random;
-    Random.Initialize(RandomSeed);
+    const FAmbitCounterRandom Random(RandomSeed, SpawnerId);
 
-    for (AActor* SurfaceActor : ActorsToSearch)
+    // Draw every candidate point for every surface up front.
+    // Each value is keyed by its surface and sample index, so the candidates
+    // only depend on RandomSeed, whichever thread draws them.
+    for (int32 SurfaceIndex = 0; SurfaceIndex < Surfaces.Num(); SurfaceIndex++)
     {
-        // Calculate the surface area of this actor to determine how many items to spawn.
-        FBox Bounds = SurfaceActor->GetComponentsBoundingBox();
-        const FVector SizeMeters = Bounds.GetSize() / 100.f;
-        const float AreaMeters = SizeMeters.X * SizeMeters.Y;
-        int SpawnCount = AreaMeters * Random.FRandRange(DensityMin, DensityMax);
+        const FAmbitCounterRandom SurfaceRandom = Random.ForSurface(SurfaceIndex);
+        const FBox& Bounds = Surfaces[SurfaceIndex].Bounds;
+        int SpawnCount = Surfaces[SurfaceIndex].AreaMeters * SurfaceRandom.FRandRange(
+            0, EAmbitRandomChannel::Density, DensityMin, DensityMax);
 
-        FVector Location(0, 0, Bounds.Max.Z + 1);
-        FRotator Rotation(0);
+        if (Distribution == PoissonDisk && MinSpacing > 0.f)
+        {
+            // Blue-noise candidates cover the bounds evenly without clustering.
+            // The algorithm is sequential, so it gets a stream of its own.
+            const FBox2D Rectangle(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+            FRandomStream Stream = SurfaceRandom.MakeStream(0);
+            const TArray<FVector2D> Points = AmbitPoissonDisk::GeneratePoints(Rectangle, MinSpacing, SpawnCount,
+                                                                              Stream);
+            for (int32 i = 0; i < Points.Num(); i++)
+            {
+                const float Yaw = SurfaceRandom.FRandRange(i, EAmbitRandomChannel::Yaw, RotationMin, RotationMax);
+                Candidates.Transforms.Emplace(FRotator(0, Yaw, 0), FVector(Points[i].X, Points[i].Y, Bounds.Max.Z + 1));
+                Candidates.Surfaces.Add(SurfaceIndex);
+            }
+            continue;
+        }
 
         // Spawn items at random positions within the overall bounds of the target surface,
         // being sure to maintain the user-specified target density.
@@ -120,34 +392,230 @@ TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromActors(const TA
         // but in cases where surfaces don't completely fill their bounding boxes (which is very common).
         // the actually number of spawned items will be smaller in order to achieve the desired density
         // relative to the actual surface area available.
-        while (SpawnCount > 0)
+        SpawnCount = FMath::Max(SpawnCount, 0);
+        const int32 First = Candidates.Transforms.Num();
+        Candidates.Transforms.AddDefaulted(SpawnCount);
+        for (int32 Sample = 0; Sample < SpawnCount; Sample++)
+        {
+            Candidates.Surfaces.Add(SurfaceIndex);
+        }
+        ParallelFor(SpawnCount, [&](int32 Sample)
         {
             // Choose a random point just above the surface of SurfaceActor's bounding box.
-            Location.X = Random.FRandRange(Bounds.Min.X, Bounds.Max.X);
-            Location.Y = Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y);
-            const float Yaw = Random.FRandRange(RotationMin, RotationMax);
+            FVector Location(0, 0, Bounds.Max.Z + 1);
+            Location.X = SurfaceRandom.FRandRange(Sample, EAmbitRandomChannel::LocationX, Bounds.Min.X, Bounds.Max.X);
+            Location.Y = SurfaceRandom.FRandRange(Sample, EAmbitRandomChannel::LocationY, Bounds.Min.Y, Bounds.Max.Y);
+            const float Yaw = SurfaceRandom.FRandRange(Sample, EAmbitRandomChannel::Yaw, RotationMin, RotationMax);
+            Candidates.Transforms[First + Sample] = FTransform(FRotator(0, Yaw, 0), Location);
+        }, !bParallel);
+    }
+    return Candidates;
+}
+
+TArray<FTransform> AmbitWorldHelpers::SnapToOwnSurfaces(const FPlacementCandidates& Candidates,
+                                                        const TArray<AActor*>& ActorsToSearch, bool bParallelTraces,
+                                                        bool bTraceMatchedSurfacesOnly)
+{
+    const TArray<FTransform>& CandidateTransforms = Candidates.Transforms;
+    const TArray<int32>& CandidateSurfaces = Candidates.Surfaces;
+
+    // First pass: answer what the export's height field can, and trace the rest as one batch.
+    TArray<FHitResult> Hits;
+    Hits.SetNum(CandidateTransforms.Num());
+    TArray<FVector> TraceLocations;
+    TArray<int32> TraceCandidates;
+    const TSharedPtr<const FAmbitSurfaceHeightField> HeightField = AmbitSurfaceHeightFieldCache::Find(ActorsToSearch);
+    for (int32 i = 0; i < CandidateTransforms.Num(); i++)
+    {
+        FVector ImpactPoint;
+        FVector ImpactNormal;
+        AActor* HitActor = nullptr;
+        FAmbitSurfaceHeightField::EQueryResult Result = HeightField.IsValid()
+            ? HeightField->Query(CandidateTransforms[i].GetLocation(), ImpactPoint, ImpactNormal, HitActor)
+            : FAmbitSurfaceHeightField::EQueryResult::Unknown;
+        if (Result == FAmbitSurfaceHeightField::EQueryResult::Hit && bTraceMatchedSurfacesOnly
+            && HitActor != ActorsToSearch[CandidateSurfaces[i]])
+        {
+            // The height field only knows the topmost surface, which may be covering this candidate's own.
+            Result = FAmbitSurfaceHeightField::EQueryResult::Unknown;
+        }
+        if (Result == FAmbitSurfaceHeightField::EQueryResult::Hit)
+        {
+            Hits[i] = FHitResult(HitActor, nullptr, ImpactPoint, ImpactNormal);
+            Hits[i].bBlockingHit = true;
+        }
+        else if (Result == FAmbitSurfaceHeightField::EQueryResult::Unknown)
+        {
+            TraceLocations.Add(CandidateTransforms[i].GetLocation());
+            TraceCandidates.Add(i);
+        }
+    }
+    TArray<FHitResult> TraceHits;
+    if (bTraceMatchedSurfacesOnly)
+    {
+        // Each candidate only needs to hit its own surface, so nothing else in the world is traced.
+        TArray<FSurfaceComponents> Surfaces;
+        Surfaces.Reserve(ActorsToSearch.Num());
+        for (AActor* SurfaceActor : ActorsToSearch)
+        {
+            Surfaces.Add(GetSurfaceComponents({SurfaceActor}));
+        }
+        TraceHits.SetNum(TraceLocations.Num());
+        ParallelFor(TraceLocations.Num(), [&](int32 i)
+        {
+            TraceHits[i] = LineTraceBelowOnSurface(TraceLocations[i], Surfaces[CandidateSurfaces[TraceCandidates[i]]]);
+        }, !bParallelTraces);
+    }
+    else
+    {
+        TraceHits = LineTraceBelowWorldPoints(TraceLocations, 100000, bParallelTraces);
+    }
+    for (int32 i = 0; i < TraceHits.Num(); i++)
+    {
+        Hits[TraceCandidates[i]] = TraceHits[i];
+    }
 
-            const FHitResult& Hit = LineTraceBelowWorldPoint(Location);
+    // Second pass: gather the hits in candidate order.
+    TArray<FTransform> Transforms;
+    const FRotator Rotation(0);
+    for (int32 i = 0; i < Hits.Num(); i++)
+    {
+        const FHitResult& Hit = Hits[i];
+        if (Hit.IsValidBlockingHit() && Hit.GetActor() == ActorsToSearch[CandidateSurfaces[i]])
+        {
+            // Calculate rotation axis using normal of impact point
+            FVector RotationAxis = FVector::CrossProduct(FVector(0, 0, 1), Hit.ImpactNormal);
+            RotationAxis.Normalize();
+
+            const float Cosine = FMath::Clamp(FVector::DotProduct(FVector(0, 0, 1), Hit.ImpactNormal), -1.f, 1.f);
+            const float RotationAngle = acosf(Cosine);
+            const FQuat& Quat = FQuat(RotationAxis, RotationAngle);
+            // Adjust Rotation of new transform (0,0,0) with the new rotation axis
+            FQuat AdjustedRotation = Rotation.Quaternion() * Quat;
 
-            if (Hit.IsValidBlockingHit() && Hit.GetActor() == SurfaceActor)
+            // Combine "local" Yaw rotation generated from user inputted restrictions
+            // with the adjusted rotation axis
+            FTransform Transform(AdjustedRotation * CandidateTransforms[i].GetRotation(), Hit.ImpactPoint);
+            Transforms.Push(Transform);
+        }
+    }
+    return Transforms;
+}
+
+TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(const TArray<AActor*>& ActorsToSearch,
+                                                                                int32 RandomSeed, float DensityMin,
+                                                                                float DensityMax, float RotationMin,
+                                                                                float RotationMax, uint32 SpawnerId)
+{
+    return DrawLocationsFromTriangles(GetSurfaceTriangles(ActorsToSearch), RandomSeed, DensityMin, DensityMax,
+                                      RotationMin, RotationMax, SpawnerId);
+}
+
+TArray<AmbitWorldHelpers::FSurfaceTriangles> AmbitWorldHelpers::GetSurfaceTriangles(const TArray<AActor*>& Actors)
+{
+    TArray<FSurfaceTriangles> Surfaces;
+    Surfaces.SetNum(Actors.Num());
+    for (int32 SurfaceIndex = 0; SurfaceIndex < Actors.Num(); SurfaceIndex++)
+    {
+        AActor* SurfaceActor = Actors[SurfaceIndex];
+        if (!IsValid(SurfaceActor))
+        {
+            continue;
+        }
+
+        // Collect the upward-facing surface of every component a downward trace could hit.
+        FSurfaceTriangles& Surface = Surfaces[SurfaceIndex];
+        float ActorArea = 0.f;
+        TInlineComponentArray<UStaticMeshComponent*> Components(SurfaceActor);
+        for (const UStaticMeshComponent* Component : Components)
+        {
+            if (!Component->IsQueryCollisionEnabled()
+                || Component->GetCollisionResponseToChannel(ECC_Visibility) != ECR_Block)
+            {
+                continue;
+            }
+
+            AmbitMeshSampler::FComponentSampler Sampler;
+            if (Sampler.Initialize(Component))
             {
-                // Calculate rotation axis using normal of impact point
-                FVector RotationAxis = FVector::CrossProduct(FVector(0, 0, 1), Hit.ImpactNormal);
-                RotationAxis.Normalize();
-
-                const float RotationAngle = acosf(FVector::DotProduct(FVector(0, 0, 1), Hit.ImpactNormal));
-                const FQuat& Quat = FQuat(RotationAxis, RotationAngle);
-                // Adjust Rotation of new transform (0,0,0) with the new rotation axis
-                FQuat AdjustedRotation = Rotation.Quaternion() * Quat;
-
-                // Combine "local" Yaw rotation generated from user inputted restrictions
-                // with the adjusted rotation axis
-                FTransform Transform(AdjustedRotation * FRotator(0, Yaw, 0).Quaternion(), Hit.ImpactPoint);
-                Transforms.Push(Transform);
+                ActorArea += Sampler.GetArea();
+                Surface.Samplers.Add(MoveTemp(Sampler));
+                Surface.Cdf.Add(ActorArea);
             }
+        }
 
-            // No matter hit or not, reduce spawn count
-            SpawnCount--;
+        if (Surface.Samplers.Num() == 0)
+        {
+            UE_LOG(LogAmbit, Warning, TEXT("%s has no static mesh triangles to sample."), *SurfaceActor->GetName());
+        }
+    }
+    return Surfaces;
+}
+
+TArray<FTransform> AmbitWorldHelpers::DrawLocationsFromTriangles(const TArray<FSurfaceTriangles>& Surfaces,
+                                                                 int32 RandomSeed, float DensityMin,
+                                                                 float DensityMax, float RotationMin,
+                                                                 float RotationMax, uint32 SpawnerId)
+{
+    TArray<FTransform> Transforms;
+    if (DensityMin > DensityMax)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("DensityMin is greater than DensityMax. No actors spawned."));
+        return Transforms;
+    }
+
+    if (RotationMin > RotationMax)
+    {
+        UE_LOG(LogAmbit, Warning, TEXT("RotationMin is greater than RotationMax. No actors spawned."));
+        return Transforms;
+    }
+
+    const FAmbitCounterRandom Random(RandomSeed, SpawnerId);
+
+    const FRotator Rotation(0);
+    for (int32 SurfaceIndex = 0; SurfaceIndex < Surfaces.Num(); SurfaceIndex++)
+    {
+        const TArray<AmbitMeshSampler::FComponentSampler>& Samplers = Surfaces[SurfaceIndex].Samplers;
+        const TArray<float>& SamplerCdf = Surfaces[SurfaceIndex].Cdf;
+        const FAmbitCounterRandom SurfaceRandom = Random.ForSurface(SurfaceIndex);
+        if (Samplers.Num() == 0)
+        {
+            continue;
+        }
+
+        // Every sample lands on the surface, so the count follows directly from the true area.
+        const float ActorArea = SamplerCdf.Last();
+        const int SpawnCount = ActorArea / 10000.f * SurfaceRandom.FRandRange(0, EAmbitRandomChannel::Density,
+                                                                              DensityMin, DensityMax);
+        Transforms.Reserve(Transforms.Num() + FMath::Max(SpawnCount, 0));
+        for (int32 Sample = 0; Sample < SpawnCount; Sample++)
+        {
+            // A single area value selects both the component and the triangle within it.
+            const float AreaValue = SurfaceRandom.FRandRange(Sample, EAmbitRandomChannel::Area, 0.f, ActorArea);
+            const int32 SamplerIndex = FMath::Min(Algo::UpperBound(SamplerCdf, AreaValue), Samplers.Num() - 1);
+            const float SamplerStart = SamplerIndex > 0 ? SamplerCdf[SamplerIndex - 1] : 0.f;
+            const float U = SurfaceRandom.GetFraction(Sample, EAmbitRandomChannel::TriangleU);
+            const float V = SurfaceRandom.GetFraction(Sample, EAmbitRandomChannel::TriangleV);
+
+            FVector Location;
+            FVector Normal;
+            Samplers[SamplerIndex].Sample(AreaValue - SamplerStart, U, V, Location, Normal);
+
+            // Calculate rotation axis using normal of the sampled triangle
+            FVector RotationAxis = FVector::CrossProduct(FVector(0, 0, 1), Normal);
+            RotationAxis.Normalize();
+
+            const float Cosine = FMath::Clamp(FVector::DotProduct(FVector(0, 0, 1), Normal), -1.f, 1.f);
+            const float RotationAngle = acosf(Cosine);
+            const FQuat& Quat = FQuat(RotationAxis, RotationAngle);
+            // Adjust Rotation of new transform (0,0,0) with the new rotation axis
+            FQuat AdjustedRotation = Rotation.Quaternion() * Quat;
+
+            // Combine "local" Yaw rotation generated from user inputted restrictions
+            // with the adjusted rotation axis
+            const float Yaw = SurfaceRandom.FRandRange(Sample, EAmbitRandomChannel::Yaw, RotationMin, RotationMax);
+            FTransform Transform(AdjustedRotation * FRotator(0, Yaw, 0).Quaternion(), Location);
+            Transforms.Push(Transform);
         }
     }
     return Transforms;
@@ -157,31 +625,56 @@ TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromBox(UBoxCompone
                                                                      const TArray<AActor*>& ActorsToHit,
                                                                      int32 RandomSeed, bool bSnapToSurfaceBelow,
                                                                      float DensityMin, float DensityMax,
-                                                                     float RotationMin, float RotationMax)
+                                                                     float RotationMin, float RotationMax,
+                                                                     EPlacementDistribution Distribution,
+                                                                     float MinSpacing, uint32 SpawnerId)
 {
-    TArray<FTransform> Transforms;
     if (!IsValid(Box))
     {
         UE_LOG(LogAmbit, Warning, TEXT("Invalid box component."));
-        return Transforms;
+        return TArray<FTransform>();
     }
+    return GenerateRandomLocationsFromBox(Box->GetComponentTransform(), Box->GetUnscaledBoxExtent(), ActorsToHit,
+                                          RandomSeed, bSnapToSurfaceBelow, DensityMin, DensityMax, RotationMin,
+                                          RotationMax, Distribution, MinSpacing, SpawnerId);
+}
+
+TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromBox(const FTransform& BoxTransform,
+                                                                     const FVector& BoxExtent,
+                                                                     const TArray<AActor*>& ActorsToHit,
+                                                                     int32 RandomSeed, bool bSnapToSurfaceBelow,
+                                                                     float DensityMin, float DensityMax,
+                                                                     float RotationMin, float RotationMax,
+                                                                     EPlacementDistribution Distribution,
+                                                                     float MinSpacing, uint32 SpawnerId)
+{
+    const FPlacementCandidates Candidates = DrawLocationsFromBox(BoxTransform, BoxExtent, RandomSeed, DensityMin,
+                                                                 DensityMax, RotationMin, RotationMax, Distribution,
+                                                                 MinSpacing, SpawnerId);
+    return SnapToSurfaces(Candidates, ActorsToHit, bSnapToSurfaceBelow, false);
+}
+
+AmbitWorldHelpers::FPlacementCandidates AmbitWorldHelpers::DrawLocationsFromBox(
+    const FTransform& BoxTransform, const FVector& BoxExtent, int32 RandomSeed, float DensityMin, float DensityMax,
+    float RotationMin, float RotationMax, EPlacementDistribution Distribution, float MinSpacing, uint32 SpawnerId)
+{
+    FPlacementCandidates Candidates;
     if (DensityMin > DensityMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("DensityMin is greater than DensityMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
 
     if (RotationMin > RotationMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("RotationMin is greater than RotationMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
-    FRandomStream Random;
-    Random.Initialize(RandomSeed);
+    const FAmbitCounterRandom Random(RandomSeed, SpawnerId);
 
-    FTransform BoxTransform = Box->GetComponentTransform();
-
-    FBox Bounds = Box->Bounds.GetBox();
+    // The same bounds UBoxComponent::CalcBounds() gives the component.
+    FBox Bounds = FBoxSphereBounds(FBox(-BoxExtent, BoxExtent)).TransformBy(BoxTransform).GetBox();
+    const FVector ScaledExtent = BoxExtent * BoxTransform.GetScale3D();
 
     float BoxYaw = BoxTransform.Rotator().Yaw;
     float BoxYawMod = UKismetMathLibrary::GenericPercent_FloatFloat(BoxYaw, 90.f);
@@ -189,21 +682,38 @@ TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromBox(UBoxCompone
     {
         // If BoxComponent is a rotated box, create a rectangle
         // with the same area as a temporary bounding box
-        Bounds = FBox(FVector(-Box->GetScaledBoxExtent().X, -Box->GetScaledBoxExtent().Y, 0.0),
-                      FVector(Box->GetScaledBoxExtent().X, Box->GetScaledBoxExtent().Y, 0.0));
+        Bounds = FBox(FVector(-ScaledExtent.X, -ScaledExtent.Y, 0.0), FVector(ScaledExtent.X, ScaledExtent.Y, 0.0));
     }
 
     // Calculate the surface area of the bounding box to determine how many items to spawn.
     const FVector SizeMeters = Bounds.GetSize() / 100.f;
     const float AreaMeters = SizeMeters.X * SizeMeters.Y;
-    int SpawnCount = AreaMeters * Random.FRandRange(DensityMin, DensityMax);
+    int SpawnCount = AreaMeters * Random.FRandRange(0, EAmbitRandomChannel::Density, DensityMin, DensityMax);
+
+    const bool bPoissonDisk = Distribution == PoissonDisk && MinSpacing > 0.f;
+    TArray<FVector2D> PoissonPoints;
+    if (bPoissonDisk)
+    {
+        const FBox2D Rectangle(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+        FRandomStream Stream = Random.MakeStream(0);
+        PoissonPoints = AmbitPoissonDisk::GeneratePoints(Rectangle, MinSpacing, SpawnCount, Stream);
+        SpawnCount = PoissonPoints.Num();
+    }
 
     FVector Location(0, 0, Bounds.Max.Z);
 
-    while (SpawnCount > 0)
+    for (int32 Sample = 0; Sample < SpawnCount; Sample++)
     {
-        Location.X = Random.FRandRange(Bounds.Min.X, Bounds.Max.X);
-        Location.Y = Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y);
+        if (bPoissonDisk)
+        {
+            Location.X = PoissonPoints[Sample].X;
+            Location.Y = PoissonPoints[Sample].Y;
+        }
+        else
+        {
+            Location.X = Random.FRandRange(Sample, EAmbitRandomChannel::LocationX, Bounds.Min.X, Bounds.Max.X);
+            Location.Y = Random.FRandRange(Sample, EAmbitRandomChannel::LocationY, Bounds.Min.Y, Bounds.Max.Y);
+        }
 
         FVector NewLocation = Location;
         if (!FMath::IsNearlyEqual(BoxYawMod, 0.f))
@@ -213,21 +723,11 @@ TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromBox(UBoxCompone
             NewLocation = BoxTransform.TransformPosition(Location);
         }
 
-        FTransform Transform(FRotator(0), NewLocation);
-        if (CheckAndSnapToSurface(Transform, ActorsToHit, bSnapToSurfaceBelow))
-        {
-            FRotator Rotation(0, Random.FRandRange(RotationMin, RotationMax), 0);
-            // Combine "local" Yaw rotation generated from user inputted restrictions
-            // with the adjusted rotation axis
-            Transform.SetRotation(Transform.GetRotation() * Rotation.Quaternion());
-            Transforms.Push(Transform);
-        }
-
-        // No matter hit or not, reduce spawn count
-        SpawnCount--;
+        FRotator Rotation(0, Random.FRandRange(Sample, EAmbitRandomChannel::Yaw, RotationMin, RotationMax), 0);
+        Candidates.Transforms.Emplace(Rotation, NewLocation);
     }
 
-    return Transforms;
+    return Candidates;
 }
 
 TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromSpline(USplineComponent* Spline,
@@ -235,62 +735,109 @@ TArray<FTransform> AmbitWorldHelpers::GenerateRandomLocationsFromSpline(USplineC
                                                                         int32 RandomSeed, bool bSnapToSurfaceBelow,
                                                                         float DensityMin, float DensityMax,
                                                                         float RotationMin, float RotationMax,
-                                                                        bool bFollowSplineRotation)
+                                                                        bool bFollowSplineRotation,
+                                                                        EPlacementDistribution Distribution,
+                                                                        float MinSpacing, uint32 SpawnerId,
+                                                                        bool bTraceMatchedSurfacesOnly)
 {
-    TArray<FTransform> Transforms;
     if (!IsValid(Spline))
     {
         UE_LOG(LogAmbit, Warning, TEXT("Invalid spline component."));
-        return Transforms;
+        return TArray<FTransform>();
     }
+    const FPlacementCandidates Candidates = DrawLocationsFromSpline(
+        AmbitSplineSampler::FSplineSnapshot(*Spline), RandomSeed, DensityMin, DensityMax, RotationMin, RotationMax,
+        bFollowSplineRotation, Distribution, MinSpacing, SpawnerId);
+    return SnapToSurfaces(Candidates, ActorsToHit, bSnapToSurfaceBelow, bTraceMatchedSurfacesOnly);
+}
+
+AmbitWorldHelpers::FPlacementCandidates AmbitWorldHelpers::DrawLocationsFromSpline(
+    const AmbitSplineSampler::FSplineSnapshot& Spline, int32 RandomSeed, float DensityMin, float DensityMax,
+    float RotationMin, float RotationMax, bool bFollowSplineRotation, EPlacementDistribution Distribution,
+    float MinSpacing, uint32 SpawnerId)
+{
+    FPlacementCandidates Candidates;
     if (DensityMin > DensityMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("DensityMin is greater than DensityMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
 
     if (RotationMin > RotationMax)
     {
         UE_LOG(LogAmbit, Warning, TEXT("RotationMin is greater than RotationMax. No actors spawned."));
-        return Transforms;
+        return Candidates;
     }
-    FRandomStream Random;
-    Random.Initialize(RandomSeed);
+    const FAmbitCounterRandom Random(RandomSeed, SpawnerId);
 
-    const float SplineLength = Spline->GetSplineLength();
+    const float SplineLength = Spline.GetLength();
 
     // Calculate length of spline in meters to determine how many items to spawn.
-    int SpawnCount = SplineLength / 100.f * Random.FRandRange(DensityMin, DensityMax);
+    int SpawnCount = SplineLength / 100.f * Random.FRandRange(0, EAmbitRandomChannel::Density, DensityMin, DensityMax);
 
-    while (SpawnCount > 0)
+    TArray<float> Distances;
+    if (Distribution == PoissonDisk && MinSpacing > 0.f)
+    {
+        FRandomStream Stream = Random.MakeStream(0);
+        Distances = AmbitPoissonDisk::GenerateDistances(SplineLength, MinSpacing, SpawnCount, Stream);
+    }
+    else
     {
-        const float Distance = Random.FRandRange(0, SplineLength);
-        FVector Location = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+        Distances.SetNum(FMath::Max(SpawnCount, 0));
+        for (int32 Sample = 0; Sample < Distances.Num(); Sample++)
+        {
+            Distances[Sample] = Random.FRandRange(Sample, EAmbitRandomChannel::Distance, 0, SplineLength);
+        }
+    }
+
+    // Every distance is known up front, so they are all evaluated in one pass along the spline.
+    const TArray<AmbitSplineSampler::FSplineSample> Samples = AmbitSplineSampler::SampleAtDistances(
+        Spline, Distances, ESplineCoordinateSpace::World);
 
-        FTransform Transform(FRotator(0), Location);
-        if (CheckAndSnapToSurface(Transform, ActorsToHit, bSnapToSurfaceBelow))
+    Candidates.Transforms.Reserve(Samples.Num());
+    for (int32 Sample = 0; Sample < Samples.Num(); Sample++)
+    {
+        FRotator Rotation(0, Random.FRandRange(Sample, EAmbitRandomChannel::Yaw, RotationMin, RotationMax), 0);
+        if (bFollowSplineRotation)
+        {
+            Rotation.Yaw += Samples[Sample].Rotation.Yaw;
+        }
+        Candidates.Transforms.Emplace(Rotation, Samples[Sample].Location);
+    }
+    return Candidates;
+}
+
+TArray<FTransform> AmbitWorldHelpers::SnapToSurfaces(const FPlacementCandidates& Candidates,
+                                                     const TArray<AActor*>& ActorsToHit, bool bSnapToSurfaceBelow,
+                                                     bool bTraceMatchedSurfacesOnly)
+{
+    TArray<FTransform> Transforms;
+    const FSurfaceComponents SurfacesToTrace = bTraceMatchedSurfacesOnly
+                                                   ? GetSurfaceComponents(ActorsToHit)
+                                                   : FSurfaceComponents();
+    for (const FTransform& Candidate : Candidates.Transforms)
+    {
+        FTransform Transform(FRotator(0), Candidate.GetLocation());
+        if (CheckAndSnapToSurface(Transform, ActorsToHit, bSnapToSurfaceBelow, SurfacesToTrace))
         {
-            FRotator Rotation(0, Random.FRandRange(RotationMin, RotationMax), 0);
-            if (bFollowSplineRotation)
-            {
-                const float SplinePointRotation = Spline->GetRotationAtDistanceAlongSpline(
-                    Distance, ESplineCoordinateSpace::World).Yaw;
-                Rotation.Yaw += SplinePointRotation;
-            }
             // Combine "local" Yaw rotation generated from user inputted restrictions
             // with the adjusted rotation axis
-            Transform.SetRotation(Transform.GetRotation() * Rotation.Quaternion());
+            Transform.SetRotation(Transform.GetRotation() * Candidate.GetRotation());
             Transforms.Push(Transform);
         }
-
-        // No matter hit or not, reduce spawn count
-        SpawnCount--;
     }
     return Transforms;
 }
 
 bool AmbitWorldHelpers::CheckAndSnapToSurface(FTransform& Transform, const TArray<AActor*>& ActorsToHit,
                                               const bool& bSnapToSurfaceBelow)
+{
+    return CheckAndSnapToSurface(Transform, ActorsToHit, bSnapToSurfaceBelow, FSurfaceComponents());
+}
+
+bool AmbitWorldHelpers::CheckAndSnapToSurface(FTransform& Transform, const TArray<AActor*>& ActorsToHit,
+                                              const bool& bSnapToSurfaceBelow,
+                                              const FSurfaceComponents& SurfacesToTrace)
 {
     if (!bSnapToSurfaceBelow && ActorsToHit.Num() == 0)
     {
@@ -298,7 +845,28 @@ bool AmbitWorldHelpers::CheckAndSnapToSurface(FTransform& Transform, const TArra
     }
 
     FVector Location = Transform.GetLocation();
-    const FHitResult& Hit = LineTraceBelowWorldPoint(Location);
+
+    // During an export, the matched surfaces are rasterized once and most points never need a trace.
+    const TSharedPtr<const FAmbitSurfaceHeightField> HeightField = AmbitSurfaceHeightFieldCache::Find(ActorsToHit);
+    FHitResult Hit;
+    FAmbitSurfaceHeightField::EQueryResult Result = FAmbitSurfaceHeightField::EQueryResult::Unknown;
+    if (HeightField.IsValid())
+    {
+        AActor* HitActor = nullptr;
+        Result = HeightField->Query(Location, Hit.ImpactPoint, Hit.ImpactNormal, HitActor);
+        Hit.bBlockingHit = Result == FAmbitSurfaceHeightField::EQueryResult::Hit;
+        Hit.Actor = HitActor;
+    }
+    if (Result == FAmbitSurfaceHeightField::EQueryResult::Miss)
+    {
+        return false;
+    }
+    if (Result == FAmbitSurfaceHeightField::EQueryResult::Unknown)
+    {
+        Hit = SurfacesToTrace.Components.Num() > 0
+                  ? LineTraceBelowOnSurface(Location, SurfacesToTrace)
+                  : LineTraceBelowWorldPoint(Location);
+    }
     AActor* ActorHit = Hit.GetActor();
 
     if (Hit.IsValidBlockingHit())
@@ -310,7 +878,8 @@ bool AmbitWorldHelpers::CheckAndSnapToSurface(FTransform& Transform, const TArra
         FVector RotationAxis = FVector::CrossProduct(FVector(0, 0, 1), Hit.ImpactNormal);
         RotationAxis.Normalize();
 
-        const float RotationAngle = acosf(FVector::DotProduct(FVector(0, 0, 1), Hit.ImpactNormal));
+        const float Cosine = FMath::Clamp(FVector::DotProduct(FVector(0, 0, 1), Hit.ImpactNormal), -1.f, 1.f);
+        const float RotationAngle = acosf(Cosine);
         const FQuat& Quat = FQuat(RotationAxis, RotationAngle);
 
         Transform.SetRotation(Transform.GetRotation() * Quat);
@@ -340,7 +909,8 @@ TArray<FTransform> AmbitWorldHelpers::GenerateFixedLocationsFromSpline(USplineCo
         return Transforms;
     }
 
-    const float SplineLength = Spline->GetSplineLength();
+    const AmbitSplineSampler::FSplineSnapshot SplineSnapshot(*Spline);
+    const float SplineLength = SplineSnapshot.GetLength();
 
     if (Distance > SplineLength)
     {
@@ -348,14 +918,22 @@ TArray<FTransform> AmbitWorldHelpers::GenerateFixedLocationsFromSpline(USplineCo
         return Transforms;
     }
 
+    TArray<float> Distances;
     for (float i = 0.f; i <= SplineLength; i += Distance)
     {
-        FRotator Rotation(0, 0, 0);
-        Rotation.Yaw = Spline->GetRotationAtDistanceAlongSpline(i, ESplineCoordinateSpace::World).Yaw;
+        Distances.Add(i);
+    }
 
-        FVector Location = Spline->GetLocationAtDistanceAlongSpline(i, ESplineCoordinateSpace::World);
+    // Waypoints are in increasing order, so they are all resolved in a single pass along the spline.
+    const TArray<AmbitSplineSampler::FSplineSample> Samples = AmbitSplineSampler::SampleAtDistances(
+        SplineSnapshot, Distances, ESplineCoordinateSpace::World);
+    Transforms.Reserve(Samples.Num());
+    for (const AmbitSplineSampler::FSplineSample& Sample : Samples)
+    {
+        FRotator Rotation(0, 0, 0);
+        Rotation.Yaw = Sample.Rotation.Yaw;
 
-        FTransform Transform(Rotation, Location);
+        FTransform Transform(Rotation, Sample.Location);
         Transforms.Push(Transform);
     }
 
@@ -16,9 +16,13 @@
 
 #include "CoreMinimal.h"
 #include "MatchBy.h"
+#include "PlacementDistribution.h"
 #include "Components/BoxComponent.h"
 #include "Components/SplineComponent.h"
 
+#include "AmbitMeshSampler.h"
+#include "AmbitSplineSampler.h"
+
 /**
  * A collection of helpers functions that make using UWorld easier.
  */
@@ -35,6 +39,100 @@ namespace AmbitWorldHelpers
      */
     FHitResult LineTraceBelowWorldPoint(const FVector& Location, const float MaxDistance = 100000);
 
+    /**
+     * Performs a downward line trace from each of the specified locations
+     * as a single batch and returns the hit results in the same order
+     * as the provided locations.
+     *
+     * @param Locations
+     *  the locations to start the line traces
+     * @param MaxDistance
+     *  the maximum length of each line trace
+     * @param bParallel
+     *  whether the traces may be distributed across worker threads.
+     *  The results are identical either way.
+     */
+    TArray<FHitResult> LineTraceBelowWorldPoints(const TArray<FVector>& Locations, const float MaxDistance = 100000,
+                                                 const bool bParallel = true);
+
+    /**
+     * The primitive components of a set of surface actors that block the Visibility channel,
+     * gathered once so that many points can be traced against them.
+     */
+    struct FSurfaceComponents
+    {
+        /**
+         * The instances of an instanced component, bucketed in a uniform XY grid
+         * by the cells their bodies cover, so a trace only tests the instances under it.
+         */
+        struct FInstanceCells
+        {
+            float CellSize = 1.f;
+            TMap<FIntPoint, TArray<int32>> Cells;
+
+            /**
+             * Returns the indices of the instances whose bodies may cover Location in XY, or nullptr if none do.
+             */
+            const TArray<int32>* Find(const FVector& Location) const;
+        };
+
+        TArray<UPrimitiveComponent*> Components;
+        FBox Bounds{ForceInit};
+        TMap<const UPrimitiveComponent*, FInstanceCells> InstanceCells;
+    };
+
+    /**
+     * Placements drawn from plain data, before they are snapped to the surfaces below them.
+     */
+    struct FPlacementCandidates
+    {
+        // Where each placement is looked for, with the rotation it gets on a flat surface.
+        TArray<FTransform> Transforms;
+
+        // For each of Transforms, the index of the surface actor it must land on,
+        // if the candidates were drawn per surface.
+        TArray<int32> Surfaces;
+    };
+
+    /**
+     * The extent of a surface actor that candidate points are drawn within.
+     */
+    struct FSurfaceExtent
+    {
+        FBox Bounds{ForceInit};
+        float AreaMeters = 0.f;
+    };
+
+    /**
+     * The upward-facing triangles of the static mesh components of a surface actor, ready to be sampled.
+     */
+    struct FSurfaceTriangles
+    {
+        TArray<AmbitMeshSampler::FComponentSampler> Samplers;
+
+        // Running total of the area of Samplers, in cm^2.
+        TArray<float> Cdf;
+    };
+
+    /**
+     * Gathers the components of Actors that a Visibility trace through the world could hit.
+     */
+    FSurfaceComponents GetSurfaceComponents(const TArray<AActor*>& Actors);
+
+    /**
+     * Performs a downward line trace from the specified location against the components
+     * of Surface only, and returns the closest hit. Other actors in the world neither
+     * block the trace nor cost anything. The trace is limited to the bounds of Surface.
+     *
+     * Safe to call from worker threads.
+     *
+     * @param Location
+     *  the location to start the line trace
+     * @param Surface
+     *  the components to trace against
+     */
+    FHitResult LineTraceBelowOnSurface(const FVector& Location, const FSurfaceComponents& Surface);
+
     /**
      * Returns the list of actors that match by Name and/or a list of tags
      *
@@ -52,6 +150,19 @@ namespace AmbitWorldHelpers
     TArray<AActor*> GetActorsByMatchBy(const EMatchBy& MatchBy, const FString& NamePattern,
                                        const TArray<FName>& TagsList, const bool bMatchExactName = false);
 
+    /**
+     * Same as GetActorsByMatchBy(), but tests every actor in the world instead of
+     * using the actor index. Used when the world has no actor index.
+     */
+    TArray<AActor*> ScanActorsByMatchBy(const EMatchBy& MatchBy, const FString& NamePattern,
+                                        const TArray<FName>& TagsList, const bool bMatchExactName = false);
+
+    /**
+     * Returns true if an actor named ActorName matches NamePattern.
+     * An empty NamePattern matches nothing.
+     */
+    bool MatchesNamePattern(const FString& ActorName, const FString& NamePattern, const bool bMatchExactName);
+
     /**
      * Returns a list of locations in the provided actors.
      *
@@ -67,12 +178,101 @@ namespace AmbitWorldHelpers
      *  the minimum value for the rotations. Defaults to 0.
      * @param RotationMax
      *  the maximum value for the rotations. Defaults to 360.
+     * @param bParallelTraces
+     *  whether candidate points may be drawn and traced on worker threads. Every random value
+     *  is keyed by its sample index, so the output does not depend on this flag.
+     * @param Distribution
+     *  how candidate points are distributed within each actor's bounds
+     * @param MinSpacing
+     *  the minimum distance between candidate points when Distribution is PoissonDisk
+     * @param SpawnerId
+     *  tells apart spawners that share RandomSeed. See FAmbitCounterRandom::GetSpawnerId().
+     * @param bTraceMatchedSurfacesOnly
+     *  whether candidate points are traced against the components of their own surface only.
+     *  Otherwise they are traced against the whole world, and points where another actor
+     *  is above the surface are dropped. Defaults to false; SpawnOnSurface passes true.
      * @return
      *  An array of locations within the ActorsToSearch list
      */
     TArray<FTransform> GenerateRandomLocationsFromActors(const TArray<AActor*>& ActorsToSearch, int32 RandomSeed,
                                                          float DensityMin = 0.0, float DensityMax = 0.2,
-                                                         float RotationMin = 0.0, float RotationMax = 360.0);
+                                                         float RotationMin = 0.0, float RotationMax = 360.0,
+                                                         bool bParallelTraces = true,
+                                                         EPlacementDistribution Distribution = UniformRandom,
+                                                         float MinSpacing = 0.0, uint32 SpawnerId = 0,
+                                                         bool bTraceMatchedSurfacesOnly = false);
+
+    /**
+     * Gathers the extent of each of Actors that GenerateRandomLocationsFromActors() draws
+     * candidate points within, from the world snapshot of the export if there is one.
+     */
+    TArray<FSurfaceExtent> GetSurfaceExtents(const TArray<AActor*>& Actors);
+
+    /**
+     * Draws the candidate points of GenerateRandomLocationsFromActors() within the extents of the surfaces.
+     * It reads no UObjects, so it can run on any thread. The parameters are those of
+     * GenerateRandomLocationsFromActors().
+     */
+    FPlacementCandidates DrawLocationsFromSurfaces(const TArray<FSurfaceExtent>& Surfaces, int32 RandomSeed,
+                                                   float DensityMin, float DensityMax, float RotationMin,
+                                                   float RotationMax, bool bParallel,
+                                                   EPlacementDistribution Distribution, float MinSpacing,
+                                                   uint32 SpawnerId);
+
+    /**
+     * Snaps each candidate drawn by DrawLocationsFromSurfaces() onto the surface it was drawn for,
+     * and drops the candidates that miss it. The parameters are those of GenerateRandomLocationsFromActors().
+     */
+    TArray<FTransform> SnapToOwnSurfaces(const FPlacementCandidates& Candidates,
+                                         const TArray<AActor*>& ActorsToSearch, bool bParallelTraces,
+                                         bool bTraceMatchedSurfacesOnly);
+
+    /**
+     * Returns a list of locations on the upward-facing triangles of the static mesh
+     * components of the provided actors. Points are drawn with probability proportional
+     * to triangle area, so the requested density holds for surfaces of any shape
+     * and no line traces are needed.
+     *
+     * Only components that block the Visibility channel are sampled, matching
+     * the surfaces GenerateRandomLocationsFromActors can hit. Upward-facing triangles
+     * covered by other geometry are sampled as well.
+     *
+     * @param ActorsToSearch
+     *  Actors to use to generate the random locations
+     * @param RandomSeed
+     *  Locations are deterministic based on RandomSeed.
+     * @param DensityMin
+     *  the minimum density for the locations. Defaults to 0.
+     * @param DensityMax
+     *  the maximum density for the locations. Defaults to 0.2.
+     * @param RotationMin
+     *  the minimum value for the rotations. Defaults to 0.
+     * @param RotationMax
+     *  the maximum value for the rotations. Defaults to 360.
+     * @param SpawnerId
+     *  tells apart spawners that share RandomSeed. See FAmbitCounterRandom::GetSpawnerId().
+     * @return
+     *  An array of locations on the surfaces of the ActorsToSearch list
+     */
+    TArray<FTransform> GenerateRandomLocationsFromActorTriangles(const TArray<AActor*>& ActorsToSearch,
+                                                                 int32 RandomSeed, float DensityMin = 0.0,
+                                                                 float DensityMax = 0.2, float RotationMin = 0.0,
+                                                                 float RotationMax = 360.0, uint32 SpawnerId = 0);
+
+    /**
+     * Gathers the triangles of each of Actors that GenerateRandomLocationsFromActorTriangles() samples.
+     * Actors without triangles to sample get an empty entry.
+     */
+    TArray<FSurfaceTriangles> GetSurfaceTriangles(const TArray<AActor*>& Actors);
+
+    /**
+     * Samples the locations of GenerateRandomLocationsFromActorTriangles() from the triangles of the surfaces.
+     * It reads no UObjects, so it can run on any thread. The parameters are those of
+     * GenerateRandomLocationsFromActorTriangles().
+     */
+    TArray<FTransform> DrawLocationsFromTriangles(const TArray<FSurfaceTriangles>& Surfaces, int32 RandomSeed,
+                                                  float DensityMin, float DensityMax, float RotationMin,
+                                                  float RotationMax, uint32 SpawnerId);
 
 
     /**
@@ -91,6 +291,30 @@ namespace AmbitWorldHelpers
     bool CheckAndSnapToSurface(FTransform& Transform, const TArray<AActor*>& ActorsToHit,
                                const bool& bSnapToSurfaceBelow);
 
+    /**
+     * Same as CheckAndSnapToSurface(), but traces against SurfacesToTrace only when it is not empty.
+     * SurfacesToTrace is usually GetSurfaceComponents(ActorsToHit), gathered once for many transforms.
+     */
+    bool CheckAndSnapToSurface(FTransform& Transform, const TArray<AActor*>& ActorsToHit,
+                               const bool& bSnapToSurfaceBelow, const FSurfaceComponents& SurfacesToTrace);
+
+    /**
+     * Snaps every candidate with CheckAndSnapToSurface(), and drops the candidates that miss ActorsToHit.
+     * The rotation of each candidate is kept on top of the slope of the surface it lands on.
+     *
+     * @param Candidates
+     *  the candidates to snap
+     * @param ActorsToHit
+     *  Actors to use as valid surfaces to hit
+     * @param bSnapToSurfaceBelow
+     *  Determines if the hit check should be conducted when ActorsToHit is empty
+     * @param bTraceMatchedSurfacesOnly
+     *  whether candidates are traced against the components of ActorsToHit only,
+     *  rather than against the whole world
+     */
+    TArray<FTransform> SnapToSurfaces(const FPlacementCandidates& Candidates, const TArray<AActor*>& ActorsToHit,
+                                      bool bSnapToSurfaceBelow, bool bTraceMatchedSurfacesOnly);
+
     /**
      * Returns a list of locations in the provided spline
      * and actors.
@@ -113,6 +337,15 @@ namespace AmbitWorldHelpers
      *  the minimum value for the rotations. Defaults to 0.
      * @param RotationMax
      *  the maximum value for the rotations. Defaults to 360.  
+     * @param Distribution
+     *  how locations are distributed along Spline
+     * @param MinSpacing
+     *  the minimum distance along Spline between locations when Distribution is PoissonDisk
+     * @param SpawnerId
+     *  tells apart spawners that share RandomSeed. See FAmbitCounterRandom::GetSpawnerId().
+     * @param bTraceMatchedSurfacesOnly
+     *  whether locations are snapped by tracing against the components of ActorsToHit only,
+     *  rather than against the whole world. Defaults to false; SpawnOnPath passes true.
      * @return
      *  An array of locations within Spline and the ActorsToHit list (if any)
      */
@@ -120,7 +353,21 @@ namespace AmbitWorldHelpers
                                                          int32 RandomSeed, bool bSnapToSurfaceBelow,
                                                          float DensityMin = 0.0, float DensityMax = 0.2,
                                                          float RotationMin = 0.0, float RotationMax = 360.0,
-                                                         bool bFollowSplineRotation = false);
+                                                         bool bFollowSplineRotation = false,
+                                                         EPlacementDistribution Distribution = UniformRandom,
+                                                         float MinSpacing = 0.0, uint32 SpawnerId = 0,
+                                                         bool bTraceMatchedSurfacesOnly = false);
+
+    /**
+     * Draws the locations of GenerateRandomLocationsFromSpline() along a snapshot of the spline.
+     * It reads no UObjects, so it can run on any thread. The parameters are those of
+     * GenerateRandomLocationsFromSpline().
+     */
+    FPlacementCandidates DrawLocationsFromSpline(const AmbitSplineSampler::FSplineSnapshot& Spline, int32 RandomSeed,
+                                                 float DensityMin, float DensityMax, float RotationMin,
+                                                 float RotationMax, bool bFollowSplineRotation,
+                                                 EPlacementDistribution Distribution, float MinSpacing,
+                                                 uint32 SpawnerId);
 
 
     /**
@@ -143,13 +390,44 @@ namespace AmbitWorldHelpers
      *  the minimum value for the rotations. Defaults to 0.
      * @param RotationMax
      *  the maximum value for the rotations. Defaults to 360.
+     * @param Distribution
+     *  how locations are distributed within Box
+     * @param MinSpacing
+     *  the minimum distance between locations when Distribution is PoissonDisk
+     * @param SpawnerId
+     *  tells apart spawners that share RandomSeed. See FAmbitCounterRandom::GetSpawnerId().
      * @return
      *  An array of locations within Spline and the ActorsToHit list (if any)
      */
     TArray<FTransform> GenerateRandomLocationsFromBox(UBoxComponent* Box, const TArray<AActor*>& ActorsToHit,
                                                       int32 RandomSeed, bool bSnapToSurfaceBelow,
                                                       float DensityMin = 0.0, float DensityMax = 0.2,
-                                                      float RotationMin = 0.0, float RotationMax = 360.0);
+                                                      float RotationMin = 0.0, float RotationMax = 360.0,
+                                                      EPlacementDistribution Distribution = UniformRandom,
+                                                      float MinSpacing = 0.0, uint32 SpawnerId = 0);
+
+    /**
+     * Same as above, for a box given by its component transform and unscaled extent,
+     * so that it can run without reading the component.
+     */
+    TArray<FTransform> GenerateRandomLocationsFromBox(const FTransform& BoxTransform, const FVector& BoxExtent,
+                                                      const TArray<AActor*>& ActorsToHit,
+                                                      int32 RandomSeed, bool bSnapToSurfaceBelow,
+                                                      float DensityMin = 0.0, float DensityMax = 0.2,
+                                                      float RotationMin = 0.0, float RotationMax = 360.0,
+                                                      EPlacementDistribution Distribution = UniformRandom,
+                                                      float MinSpacing = 0.0, uint32 SpawnerId = 0);
+
+    /**
+     * Draws the locations of GenerateRandomLocationsFromBox() within the box.
+     * It reads no UObjects, so it can run on any thread. The parameters are those of
+     * GenerateRandomLocationsFromBox().
+     */
+    FPlacementCandidates DrawLocationsFromBox(const FTransform& BoxTransform, const FVector& BoxExtent,
+                                              int32 RandomSeed, float DensityMin, float DensityMax,
+                                              float RotationMin, float RotationMax,
+                                              EPlacementDistribution Distribution, float MinSpacing,
+                                              uint32 SpawnerId);
 
     /**
      * Returns a list of locations separate by fix distance in the provided spline
@@ -15,6 +15,7 @@
 #include "AmbitWorldHelpers.h"
 
 #include "Components/BoxComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/SplineComponent.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/World.h"
@@ -450,6 +451,57 @@ void AmbitWorldHelpersSpec::Define()
         });
     });
 
+    Describe("LineTraceBelowWorldPoints()", [this]()
+    {
+        It("returns one hit result per location, in the same order as the locations", [this]()
+        {
+            TArray<FVector> LineStarts;
+            LineStarts.Add(FVector(0, 0, 10));
+            LineStarts.Add(FVector(0, 0, -10));
+            LineStarts.Add(FVector(10, 10, 10));
+            const TArray<FHitResult>& Hits = AmbitWorldHelpers::LineTraceBelowWorldPoints(LineStarts);
+            TestEqual("The number of hit results", Hits.Num(), LineStarts.Num());
+            TestTrue("The first line trace hit the actor", Hits[0].IsValidBlockingHit());
+            TestFalse("The second line trace doesn't hit the actor", Hits[1].IsValidBlockingHit());
+            TestTrue("The third line trace hit the actor", Hits[2].IsValidBlockingHit());
+        });
+
+        It("returns an empty array when there are no locations", [this]()
+        {
+            const TArray<FVector> LineStarts;
+            const TArray<FHitResult>& Hits = AmbitWorldHelpers::LineTraceBelowWorldPoints(LineStarts);
+            TestEqual("The number of hit results", Hits.Num(), 0);
+        });
+    });
+
+    Describe("LineTraceBelowOnSurface()", [this]()
+    {
+        It("hits only the instance below the location on an instanced surface", [this]()
+        {
+            // A row of one metre planes, two metres apart.
+            AActor* InstancedActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+            UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(
+                InstancedActor, UInstancedStaticMeshComponent::StaticClass(), "Instances");
+            InstancedActor->SetRootComponent(Instances);
+            Instances->SetStaticMesh(TestSurfaceActor->GetStaticMeshComponent()->GetStaticMesh());
+            Instances->SetCollisionProfileName(TEXT("BlockAll"));
+            Instances->RegisterComponent();
+            for (int32 i = 0; i < 10; i++)
+            {
+                Instances->AddInstance(FTransform(FVector(i * 200, 0, i * 10)));
+            }
+
+            const AmbitWorldHelpers::FSurfaceComponents Surface = AmbitWorldHelpers::GetSurfaceComponents(
+                {InstancedActor});
+            const FHitResult Hit = AmbitWorldHelpers::LineTraceBelowOnSurface(FVector(600, 0, 500), Surface);
+            const FHitResult Gap = AmbitWorldHelpers::LineTraceBelowOnSurface(FVector(700, 0, 500), Surface);
+
+            TestTrue("The trace above an instance hits", Hit.IsValidBlockingHit());
+            TestEqual("The trace hits the instance below it", Hit.ImpactPoint.Z, 30.f, 0.1f);
+            TestFalse("The trace between instances misses", Gap.IsValidBlockingHit());
+        });
+    });
+
     Describe("GenerateRandomLocationsFromBox()", [this]()
     {
         It("will return an empty array if Box is invalid", [this]()
@@ -479,6 +531,32 @@ void AmbitWorldHelpersSpec::Define()
             TestTrue("The number of Transforms is greater than 0.", Transforms.Num() > 0);
         });
 
+        It("Keeps Poisson disk locations at least MinSpacing apart and reaches the requested count", [this]()
+        {
+            RealBox->SetBoxExtent(FVector(1000, 1000, 0));
+
+            const TArray<AActor*> ActorsToSearch;
+            const int32 RandomSeed = 0;
+            const float Density = 1.f;
+            const float MinSpacing = 50.f;
+
+            const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromBox(
+                RealBox, ActorsToSearch, RandomSeed, false, Density, Density, 0.f, 360.f, PoissonDisk, MinSpacing);
+            // The box is 20 m by 20 m.
+            TestEqual("The number of Transforms matches the density.", Transforms.Num(), 400);
+            for (int32 i = 0; i < Transforms.Num(); i++)
+            {
+                for (int32 j = i + 1; j < Transforms.Num(); j++)
+                {
+                    const float Distance = FVector::Dist2D(Transforms[i].GetLocation(), Transforms[j].GetLocation());
+                    if (Distance < MinSpacing - 0.01f)
+                    {
+                        AddError(FString::Printf(TEXT("Locations %d and %d are %f cm apart."), i, j, Distance));
+                    }
+                }
+            }
+        });
+
         It("Cannot generate random locations when Box's extent is not large enough", [this]()
         {
             RealBox->SetBoxExtent(FVector(0, 0, 0));
@@ -758,6 +836,31 @@ void AmbitWorldHelpersSpec::Define()
             TestTrue("The number of Transforms is greater than 0.", Transforms.Num() > 0);
         });
 
+        It("Keeps Poisson disk locations at least MinSpacing apart along the spline", [this]()
+        {
+            RealSpline->SetLocationAtSplinePoint(1, FVector(0, 5000, 0), ESplineCoordinateSpace::Local);
+
+            const TArray<AActor*> ActorsToSearch;
+            const int32 RandomSeed = 0;
+            // Slightly above 0.5 so that rounding of the spline length cannot drop an item.
+            const float Density = 0.51f;
+            const float MinSpacing = 100.f;
+
+            const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromSpline(
+                RealSpline, ActorsToSearch, RandomSeed, false, Density, Density, 0.f, 360.f, false, PoissonDisk,
+                MinSpacing);
+            // The spline is a 50 m straight line.
+            TestEqual("The number of Transforms matches the density.", Transforms.Num(), 25);
+            for (int32 i = 0; i < Transforms.Num(); i++)
+            {
+                for (int32 j = i + 1; j < Transforms.Num(); j++)
+                {
+                    const float Distance = FVector::Dist(Transforms[i].GetLocation(), Transforms[j].GetLocation());
+                    TestTrue("The locations are far enough apart.", Distance >= MinSpacing - 0.01f);
+                }
+            }
+        });
+
         It("Cannot generate random locations when Spline's length is not large enough", [this]()
         {
             RealSpline->SetLocationAtSplinePoint(1, FVector(0, 1, 100), ESplineCoordinateSpace::World);
@@ -1135,6 +1238,83 @@ void AmbitWorldHelpersSpec::Define()
             TestTrue("With different random seeds, we expect it will have different sets.", bNotEqual);
         });
 
+        It("Parallel traces produce exactly the same FTransforms as the single-threaded reference", [this]()
+        {
+            const FVector Scale3D(100, 100, 100);
+            TestSurfaceActor->SetActorScale3D(Scale3D);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float DensityMin = 1.f;
+            const float DensityMax = 2.f;
+
+            double StartTime = FPlatformTime::Seconds();
+            const TArray<FTransform> ReferenceArray = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, DensityMin, DensityMax, 0.f, 360.f, false);
+            const double ReferenceSeconds = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            const TArray<FTransform> ParallelArray = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, DensityMin, DensityMax, 0.f, 360.f, true);
+            const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+            // Every candidate point is traced once, hit or not. With a full plane all of them hit,
+            // so the number of transforms is also the number of traces.
+            UE_LOG(LogAmbit, Display, TEXT("Single-threaded: %d traces in %f s (%f traces/s)"), ReferenceArray.Num(),
+                   ReferenceSeconds, ReferenceArray.Num() / FMath::Max(ReferenceSeconds, SMALL_NUMBER));
+            UE_LOG(LogAmbit, Display, TEXT("Parallel: %d traces in %f s (%f traces/s)"), ParallelArray.Num(),
+                   ParallelSeconds, ParallelArray.Num() / FMath::Max(ParallelSeconds, SMALL_NUMBER));
+
+            TestTrue("The reference run generated FTransforms.", ReferenceArray.Num() > 0);
+            TestEqual("Both runs have the same size.", ParallelArray.Num(), ReferenceArray.Num());
+            const int32 Count = FMath::Min(ParallelArray.Num(), ReferenceArray.Num());
+            int32 NumMismatched = 0;
+            for (int i = 0; i < Count; ++i)
+            {
+                if (!ReferenceArray[i].Equals(ParallelArray[i], 0.f))
+                {
+                    NumMismatched++;
+                }
+            }
+            TestEqual("Each corresponding FTransform is exactly identical.", NumMismatched, 0);
+        });
+
+        It("Traces only the matched surface, whatever covers it", [this]()
+        {
+            const FVector Scale3D(100, 100, 100);
+            TestSurfaceActor->SetActorScale3D(Scale3D);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float DensityMin = 0.05f;
+            const float DensityMax = 0.2f;
+
+            // A prop that blocks Visibility and covers the whole surface.
+            const FString Path = "StaticMesh'/Engine/BasicShapes/Plane.Plane'";
+            UStaticMesh* StaticMesh = LoadObject<UStaticMesh>(nullptr, *Path, nullptr, LOAD_None, nullptr);
+            AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>(
+                AStaticMeshActor::StaticClass(), FTransform(FVector(0, 0, 50)));
+            Prop->SetMobility(EComponentMobility::Movable);
+            Prop->GetStaticMeshComponent()->SetStaticMesh(StaticMesh);
+            Prop->SetActorScale3D(FVector(200, 200, 1));
+
+            const TArray<FTransform> SurfaceArray = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, DensityMin, DensityMax, 0.f, 360.f, true, UniformRandom, 0.f, 0, true);
+            const TArray<FTransform> WorldArray = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, DensityMin, DensityMax, 0.f, 360.f, true, UniformRandom, 0.f, 0, false);
+            const TArray<FTransform> DefaultArray = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, DensityMin, DensityMax, 0.f, 360.f, true);
+
+            TestTrue("Surface traces reach the covered surface.", SurfaceArray.Num() > 0);
+            const bool bAllOnSurface = SurfaceArray.FindByPredicate([](const FTransform& OneTransform)
+            {
+                return !FMath::IsNearlyZero(OneTransform.GetLocation().Z, 0.1f);
+            }) == nullptr;
+            TestTrue("Every location is on the surface, not on the prop.", bAllOnSurface);
+            TestEqual("World traces are all blocked by the prop.", WorldArray.Num(), 0);
+            TestEqual("Callers that do not opt in still trace the world.", DefaultArray.Num(), 0);
+        });
+
         It("Can handle when DensityMin is greater than DensityMax", [this]()
         {
             AddExpectedError(
@@ -1174,6 +1354,149 @@ void AmbitWorldHelpersSpec::Define()
         });
     });
 
+    Describe("GenerateRandomLocationsFromActorTriangles()", [this]()
+    {
+        It("Draws from the triangles gathered before the surface moved", [this]()
+        {
+            TestSurfaceActor->SetActorScale3D(FVector(100, 100, 100));
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float Density = 0.2f;
+
+            const TArray<FTransform> Expected = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, RandomSeed, Density, Density);
+            const TArray<AmbitWorldHelpers::FSurfaceTriangles> Surfaces = AmbitWorldHelpers::GetSurfaceTriangles(
+                ActorsToSearch);
+            TestSurfaceActor->SetActorLocation(FVector(5000, 0, 0));
+            const TArray<FTransform> Drawn = AmbitWorldHelpers::DrawLocationsFromTriangles(
+                Surfaces, RandomSeed, Density, Density, 0.f, 360.f, 0);
+
+            TestEqual("The number of Transforms matches.", Drawn.Num(), Expected.Num());
+            for (int32 i = 0; i < Drawn.Num() && i < Expected.Num(); i++)
+            {
+                TestTrue("The Transforms match.", Drawn[i].Equals(Expected[i]));
+            }
+        });
+
+        It("Generates the requested density on the surface", [this]()
+        {
+            const FVector Scale3D(100, 100, 100);
+            TestSurfaceActor->SetActorScale3D(Scale3D);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float Density = 0.2f;
+
+            const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, RandomSeed, Density, Density);
+            // The plane is 100 m by 100 m.
+            TestEqual("The number of Transforms matches the density.", Transforms.Num(), 2000);
+
+            const FBox Bounds = TestSurfaceActor->GetComponentsBoundingBox().ExpandBy(1.f);
+            for (const FTransform& Transform : Transforms)
+            {
+                TestTrue("The location is on the surface.", Bounds.IsInside(Transform.GetLocation()));
+            }
+        });
+
+        It("Places every item on the surface when it does not fill its bounding box", [this]()
+        {
+            // Rotated by 45 degrees, the plane only covers half of its bounding box.
+            TestSurfaceActor->SetActorScale3D(FVector(100, 100, 100));
+            TestSurfaceActor->SetActorRotation(FRotator(0, 45, 0));
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float Density = 0.2f;
+
+            const TArray<FTransform>& TraceTransforms = AmbitWorldHelpers::GenerateRandomLocationsFromActors(
+                ActorsToSearch, RandomSeed, Density, Density);
+            const TArray<FTransform>& TriangleTransforms =
+                AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                    ActorsToSearch, RandomSeed, Density, Density);
+            UE_LOG(LogAmbit, Display, TEXT("Trace: %d, Triangles: %d"), TraceTransforms.Num(),
+                   TriangleTransforms.Num());
+
+            TestEqual("The number of Transforms matches the density.", TriangleTransforms.Num(), 2000);
+            const FTransform& SurfaceTransform = TestSurfaceActor->GetActorTransform();
+            for (const FTransform& Transform : TriangleTransforms)
+            {
+                // The plane mesh spans -50..50 cm in local space.
+                const FVector Local = SurfaceTransform.InverseTransformPosition(Transform.GetLocation());
+                TestTrue("The location is on the rotated plane.",
+                         FMath::Abs(Local.X) <= 50.01f && FMath::Abs(Local.Y) <= 50.01f);
+            }
+        });
+
+        It("Will generate random rotations only within the provided range", [this]()
+        {
+            const FVector Scale3D(100, 100, 100);
+            TestSurfaceActor->SetActorScale3D(Scale3D);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 0;
+            const float RotationMin = 30.f;
+            const float RotationMax = 60.f;
+
+            const TArray<FTransform>& Transforms = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, RandomSeed, 0.05f, 0.2f, RotationMin, RotationMax);
+            TestTrue("The number of Transforms is greater than 0.", Transforms.Num() > 0);
+            for (const FTransform& Transform : Transforms)
+            {
+                const float Yaw = Transform.Rotator().Yaw;
+                TestTrue("The yaw is within the range.", Yaw >= RotationMin - 0.01f && Yaw <= RotationMax + 0.01f);
+            }
+        });
+
+        It("Use same random seed will have the exact same FTransform set", [this]()
+        {
+            const FVector Scale3D(100, 100, 100);
+            TestSurfaceActor->SetActorScale3D(Scale3D);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+            const int32 RandomSeed = 7;
+
+            const TArray<FTransform> ExpectedArray = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, RandomSeed);
+            const TArray<FTransform> ActualArray = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, RandomSeed);
+
+            TestEqual("Both arrays have the same size.", ActualArray.Num(), ExpectedArray.Num());
+            const int32 Count = FMath::Min(ActualArray.Num(), ExpectedArray.Num());
+            for (int i = 0; i < Count; ++i)
+            {
+                TestTrue("Each corresponding FTransform is identical.", ExpectedArray[i].Equals(ActualArray[i], 0.f));
+            }
+        });
+
+        It("Can handle when DensityMin is greater than DensityMax", [this]()
+        {
+            AddExpectedError(
+                TEXT("DensityMin is greater than DensityMax. No actors spawned."), EAutomationExpectedErrorFlags::Exact,
+                1);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+
+            const TArray<FTransform> ActualArray = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, 0, 0.2f, 0.05f);
+            TestEqual("The array should be empty.", ActualArray.Num(), 0);
+        });
+
+        It("Can handle when RotationMin is greater than RotationMax", [this]()
+        {
+            AddExpectedError(
+                TEXT("RotationMin is greater than RotationMax. No actors spawned."),
+                EAutomationExpectedErrorFlags::Exact, 1);
+            TArray<AActor*> ActorsToSearch;
+            ActorsToSearch.Add(TestSurfaceActor);
+
+            const TArray<FTransform> ActualArray = AmbitWorldHelpers::GenerateRandomLocationsFromActorTriangles(
+                ActorsToSearch, 0, 0.05f, 0.2f, 90.f, 45.f);
+            TestEqual("The array should be empty.", ActualArray.Num(), 0);
+        });
+    });
+
     Describe("CheckAndSnapToSurface()", [this]()
     {
         It("Will return an unchanged FTransform if ActorsToHit is empty and bSnapToSurfaceBelow is false", [this]()
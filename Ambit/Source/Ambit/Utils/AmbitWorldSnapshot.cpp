@@ -0,0 +1,145 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitWorldSnapshot.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include "Ambit/Utils/AmbitActorIndexSubsystem.h"
+#include "Ambit/Utils/AmbitWorldHelpers.h"
+
+namespace
+{
+    TSharedPtr<const FAmbitWorldSnapshot> ExportSnapshot;
+}
+
+TSharedRef<const FAmbitWorldSnapshot> FAmbitWorldSnapshot::Build(UWorld* World, const TArray<AActor*>& Spawners,
+                                                                 const TArray<FAmbitSurfaceQuery>& SurfaceQueries)
+{
+    const TSharedRef<FAmbitWorldSnapshot> Snapshot = MakeShared<FAmbitWorldSnapshot>();
+    Snapshot->World = World;
+    const UAmbitActorIndexSubsystem* ActorIndex = World != nullptr
+                                                      ? World->GetSubsystem<UAmbitActorIndexSubsystem>()
+                                                      : nullptr;
+    Snapshot->Revision = ActorIndex != nullptr ? ActorIndex->GetRevision() : 0;
+
+    Snapshot->Spawners = Spawners;
+    for (AActor* Spawner : Spawners)
+    {
+        Snapshot->Actors.Emplace(Spawner, Spawner->GetActorTransform());
+    }
+
+    for (const FAmbitSurfaceQuery& Query : SurfaceQueries)
+    {
+        if (Snapshot->FindActors(Query) != nullptr)
+        {
+            continue;
+        }
+
+        TArray<AActor*> Matched = AmbitWorldHelpers::GetActorsByMatchBy(Query.MatchBy, Query.NamePattern, Query.Tags,
+                                                                        Query.bMatchExactName);
+        for (AActor* Actor : Matched)
+        {
+            if (Snapshot->Surfaces.Contains(Actor))
+            {
+                continue;
+            }
+            FSurface& Surface = Snapshot->Surfaces.Add(Actor);
+            Surface.Bounds = Actor->GetComponentsBoundingBox();
+            const FVector SizeMeters = Surface.Bounds.GetSize() / 100.f;
+            Surface.AreaMeters = SizeMeters.X * SizeMeters.Y;
+            Snapshot->Actors.Emplace(Actor, Actor->GetActorTransform());
+        }
+        Snapshot->Matches.Emplace(Query, MoveTemp(Matched));
+    }
+    return Snapshot;
+}
+
+const TArray<AActor*>* FAmbitWorldSnapshot::FindActors(const FAmbitSurfaceQuery& Query) const
+{
+    for (const TPair<FAmbitSurfaceQuery, TArray<AActor*>>& Match : Matches)
+    {
+        if (Match.Key == Query)
+        {
+            return &Match.Value;
+        }
+    }
+    return nullptr;
+}
+
+const FAmbitWorldSnapshot::FSurface* FAmbitWorldSnapshot::FindSurface(const AActor* Actor) const
+{
+    return Surfaces.Find(Actor);
+}
+
+TArray<AActor*> FAmbitWorldSnapshot::GetSpawners(const UClass* Class) const
+{
+    return Spawners.FilterByPredicate([Class](const AActor* Spawner)
+    {
+        return Spawner->IsA(Class);
+    });
+}
+
+bool FAmbitWorldSnapshot::IsUpToDate() const
+{
+    const UWorld* CurrentWorld = World.Get();
+    if (CurrentWorld == nullptr || CurrentWorld != GEngine->GetWorldContexts()[0].World())
+    {
+        return false;
+    }
+
+    // Without an actor index, nothing tells whether actors were added or edited.
+    const UAmbitActorIndexSubsystem* ActorIndex = CurrentWorld->GetSubsystem<UAmbitActorIndexSubsystem>();
+    if (ActorIndex == nullptr || ActorIndex->GetRevision() != Revision)
+    {
+        return false;
+    }
+
+    // Actors can be moved without notice.
+    for (const TPair<TWeakObjectPtr<AActor>, FTransform>& Actor : Actors)
+    {
+        const AActor* Current = Actor.Key.Get();
+        if (!IsValid(Current) || !Current->GetActorTransform().Equals(Actor.Value, 0.f))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AmbitWorldSnapshot::BeginExport(UWorld* World, const TArray<AActor*>& Spawners,
+                                     const TArray<FAmbitSurfaceQuery>& SurfaceQueries)
+{
+    // The surfaces are matched in the world itself, not in the snapshot being replaced.
+    ExportSnapshot.Reset();
+    ExportSnapshot = FAmbitWorldSnapshot::Build(World, Spawners, SurfaceQueries);
+}
+
+void AmbitWorldSnapshot::EndExport()
+{
+    ExportSnapshot.Reset();
+}
+
+TSharedPtr<const FAmbitWorldSnapshot> AmbitWorldSnapshot::Get()
+{
+    // The snapshot is replaced on the game thread, so other threads query the world instead.
+    if (!IsInGameThread())
+    {
+        return nullptr;
+    }
+    return ExportSnapshot;
+}
@@ -0,0 +1,143 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MatchBy.h"
+
+/**
+ * The surfaces that a spawner places onto, as matched by AmbitWorldHelpers::GetActorsByMatchBy().
+ */
+struct FAmbitSurfaceQuery
+{
+    EMatchBy MatchBy = EMatchBy::NameAndTags;
+    FString NamePattern;
+    TArray<FName> Tags;
+    bool bMatchExactName = false;
+
+    bool operator==(const FAmbitSurfaceQuery& Other) const
+    {
+        return MatchBy == Other.MatchBy && bMatchExactName == Other.bMatchExactName
+               && NamePattern == Other.NamePattern && Tags == Other.Tags;
+    }
+};
+
+/**
+ * What an export reads from the world, gathered once so that every spawner and every permutation
+ * of the export share it: the spawners, the surfaces that each of them matches,
+ * and the bounds and area of those surfaces.
+ *
+ * A snapshot does not change once it is built. IsUpToDate() tells whether the world
+ * has changed since, so that it can be built again before it is reused.
+ */
+class FAmbitWorldSnapshot
+{
+public:
+    /**
+     * A matched surface as it was when the snapshot was built.
+     */
+    struct FSurface
+    {
+        // The bounds of the components of the surface.
+        FBox Bounds{ForceInit};
+
+        // The area of Bounds seen from above, in square meters.
+        float AreaMeters = 0.f;
+    };
+
+    /**
+     * Gathers the surfaces that each of SurfaceQueries matches in World.
+     * Must be called on the game thread, while no other snapshot is in use by AmbitWorldHelpers.
+     *
+     * @param World
+     *  the world to take the snapshot of
+     * @param Spawners
+     *  the spawners of World, in the order they are iterated
+     * @param SurfaceQueries
+     *  the surfaces that the spawners place onto
+     */
+    static TSharedRef<const FAmbitWorldSnapshot> Build(UWorld* World, const TArray<AActor*>& Spawners,
+                                                       const TArray<FAmbitSurfaceQuery>& SurfaceQueries);
+
+    /**
+     * Returns the actors that Query matched when the snapshot was built,
+     * or nullptr if Query was not one of its surface queries.
+     */
+    const TArray<AActor*>* FindActors(const FAmbitSurfaceQuery& Query) const;
+
+    /**
+     * Returns the matched surface Actor, or nullptr if no query matched it.
+     */
+    const FSurface* FindSurface(const AActor* Actor) const;
+
+    /**
+     * Returns every spawner, in the order they are iterated.
+     */
+    const TArray<AActor*>& GetSpawners() const
+    {
+        return Spawners;
+    }
+
+    /**
+     * Returns the spawners that are a Class, in the order they are iterated.
+     */
+    TArray<AActor*> GetSpawners(const UClass* Class) const;
+
+    /**
+     * Checks whether the world is the same as when the snapshot was built: no actor has been spawned,
+     * added, deleted, renamed or edited, and no surface has moved.
+     */
+    bool IsUpToDate() const;
+
+private:
+    TWeakObjectPtr<UWorld> World;
+
+    // The revision of the actor index of World when the snapshot was built.
+    uint32 Revision = 0;
+
+    TArray<AActor*> Spawners;
+
+    TArray<TPair<FAmbitSurfaceQuery, TArray<AActor*>>> Matches;
+
+    TMap<const AActor*, FSurface> Surfaces;
+
+    // Every actor the snapshot refers to, and its transform when the snapshot was built.
+    TArray<TPair<TWeakObjectPtr<AActor>, FTransform>> Actors;
+};
+
+/**
+ * Keeps the snapshot of the world that an export was started with, so that
+ * AmbitWorldHelpers and the export read it instead of the world.
+ */
+namespace AmbitWorldSnapshot
+{
+    /**
+     * Takes a snapshot of World, which is used until EndExport() is called.
+     * See FAmbitWorldSnapshot::Build().
+     */
+    void BeginExport(UWorld* World, const TArray<AActor*>& Spawners, const TArray<FAmbitSurfaceQuery>& SurfaceQueries);
+
+    /**
+     * Releases the snapshot.
+     */
+    void EndExport();
+
+    /**
+     * Returns the snapshot of the export in progress, or nullptr outside an export or off the game thread.
+     */
+    TSharedPtr<const FAmbitWorldSnapshot> Get();
+}
@@ -0,0 +1,157 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+
+#include "AmbitWorldSnapshot.h"
+
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "AmbitActorIndexSubsystem.h"
+#include "AmbitWorldHelpers.h"
+
+BEGIN_DEFINE_SPEC(AmbitWorldSnapshotSpec, "Ambit.Unit.AmbitWorldSnapshot",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    UWorld* World;
+    AStaticMeshActor* Road;
+    AStaticMeshActor* Grass;
+    AActor* Spawner;
+    const FAmbitSurfaceQuery RoadQuery = {EMatchBy::NameOrTags, "", {"Road"}, false};
+
+    AStaticMeshActor* SpawnSurface(const FVector& Location, const TArray<FName>& Tags) const
+    {
+        UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"));
+        AStaticMeshActor* Surface = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+        Surface->SetMobility(EComponentMobility::Movable);
+        Surface->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+        Surface->SetActorScale3D(FVector(10, 20, 1));
+        Surface->Tags = Tags;
+        return Surface;
+    }
+END_DEFINE_SPEC(AmbitWorldSnapshotSpec)
+
+void AmbitWorldSnapshotSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        World = FAutomationEditorCommonUtils::CreateNewMap();
+        TestNotNull("Check if World is properly created", World);
+
+        Road = SpawnSurface(FVector::ZeroVector, {"Road"});
+        Grass = SpawnSurface(FVector(5000, 0, 0), {"Grass"});
+        Spawner = World->SpawnActor<AActor>();
+    });
+
+    Describe("Build()", [this]()
+    {
+        It("keeps the surfaces that each query matches", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner}, {RoadQuery});
+
+            const TArray<AActor*>* Matched = Snapshot->FindActors(RoadQuery);
+            TestNotNull("Road query", Matched);
+            TestTrue("Road", Matched != nullptr && *Matched == TArray<AActor*>{Road});
+            TestNull("Other query", Snapshot->FindActors({EMatchBy::NameOrTags, "", {"Grass"}, false}));
+        });
+
+        It("keeps the bounds and area of the surfaces", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner}, {RoadQuery});
+
+            const FAmbitWorldSnapshot::FSurface* Surface = Snapshot->FindSurface(Road);
+            TestNotNull("Road", Surface);
+            TestNull("Grass", Snapshot->FindSurface(Grass));
+            if (Surface != nullptr)
+            {
+                TestTrue("Bounds", Surface->Bounds == Road->GetComponentsBoundingBox());
+                TestEqual("Area", Surface->AreaMeters, 10.f * 20.f, 0.01f);
+            }
+        });
+    });
+
+    Describe("GetSpawners()", [this]()
+    {
+        It("returns the spawners of a class", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner, Road}, {});
+
+            TestEqual("All", Snapshot->GetSpawners().Num(), 2);
+            TestTrue("Static mesh actors",
+                     Snapshot->GetSpawners(AStaticMeshActor::StaticClass()) == TArray<AActor*>{Road});
+        });
+    });
+
+    Describe("IsUpToDate()", [this]()
+    {
+        It("returns true while the world does not change", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner}, {RoadQuery});
+            AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "", {"Grass"});
+            TestTrue("Up to date", Snapshot->IsUpToDate());
+        });
+
+        It("returns false once a surface has moved", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner}, {RoadQuery});
+            Road->SetActorLocation(FVector(0, 0, 100));
+            TestFalse("Up to date", Snapshot->IsUpToDate());
+        });
+
+        It("returns false once an actor has been spawned", [this]()
+        {
+            const TSharedRef<const FAmbitWorldSnapshot> Snapshot = FAmbitWorldSnapshot::Build(
+                World, {Spawner}, {RoadQuery});
+            World->SpawnActor<AActor>();
+            TestFalse("Up to date", Snapshot->IsUpToDate());
+        });
+    });
+
+    Describe("AmbitWorldSnapshot", [this]()
+    {
+        It("answers surface queries from the snapshot during an export", [this]()
+        {
+            AmbitWorldSnapshot::BeginExport(World, {Spawner}, {RoadQuery});
+            Grass->Tags.Add("Road");
+            World->GetSubsystem<UAmbitActorIndexSubsystem>()->NotifyActorChanged(Grass);
+
+            const TArray<AActor*> During = AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "", {"Road"});
+            TestTrue("During", During == TArray<AActor*>{Road});
+            TestFalse("Up to date", AmbitWorldSnapshot::Get()->IsUpToDate());
+
+            AmbitWorldSnapshot::EndExport();
+            TestFalse("Ended", AmbitWorldSnapshot::Get().IsValid());
+            TestEqual("After", AmbitWorldHelpers::GetActorsByMatchBy(EMatchBy::NameOrTags, "", {"Road"}).Num(), 2);
+        });
+    });
+
+    AfterEach([this]()
+    {
+        AmbitWorldSnapshot::EndExport();
+        Road->Destroy();
+        Road = nullptr;
+        Grass->Destroy();
+        Grass = nullptr;
+        Spawner->Destroy();
+        Spawner = nullptr;
+    });
+}
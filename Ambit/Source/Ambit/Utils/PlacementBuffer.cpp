@@ -0,0 +1,97 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "PlacementBuffer.h"
+
+void FPlacementBuffer::FPlacements::Reserve(int32 Number)
+{
+    Locations.Reserve(Locations.Num() + Number);
+    Rotations.Reserve(Rotations.Num() + Number);
+    Scales.Reserve(Scales.Num() + Number);
+}
+
+void FPlacementBuffer::FPlacements::Add(const FTransform& Transform)
+{
+    Locations.Add(Transform.GetLocation());
+    Rotations.Add(Transform.GetRotation());
+    Scales.Add(Transform.GetScale3D());
+}
+
+TArray<FTransform> FPlacementBuffer::FPlacements::GetTransforms() const
+{
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(Num());
+    for (int32 i = 0; i < Num(); i++)
+    {
+        Transforms.Add(GetTransform(i));
+    }
+    return Transforms;
+}
+
+bool FPlacementBuffer::FPlacements::operator==(const FPlacements& Other) const
+{
+    return Locations == Other.Locations && Rotations == Other.Rotations && Scales == Other.Scales;
+}
+
+void FPlacementBuffer::Reserve(FName Class, int32 Number)
+{
+    Classes.FindOrAdd(Class).Reserve(Number);
+}
+
+void FPlacementBuffer::Add(FName Class, const FTransform& Transform)
+{
+    Classes.FindOrAdd(Class).Add(Transform);
+}
+
+void FPlacementBuffer::Append(FName Class, const TArray<FTransform>& Transforms)
+{
+    FPlacements& Placements = Classes.FindOrAdd(Class);
+    Placements.Reserve(Transforms.Num());
+    for (const FTransform& Transform : Transforms)
+    {
+        Placements.Add(Transform);
+    }
+}
+
+int32 FPlacementBuffer::Num() const
+{
+    int32 Number = 0;
+    for (const TPair<FName, FPlacements>& Class : Classes)
+    {
+        Number += Class.Value.Num();
+    }
+    return Number;
+}
+
+void FPlacementBuffer::Empty()
+{
+    Classes.Empty();
+}
+
+bool FPlacementBuffer::operator==(const FPlacementBuffer& Other) const
+{
+    if (Classes.Num() != Other.Classes.Num())
+    {
+        return false;
+    }
+    for (const TPair<FName, FPlacements>& Class : Classes)
+    {
+        const FPlacements* OtherPlacements = Other.Classes.Find(Class.Key);
+        if (OtherPlacements == nullptr || !(*OtherPlacements == Class.Value))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The placements of spawned objects, grouped by the path name of their class.
+ *
+ * Each class keeps its locations, rotations and scales in separate arrays, so adding
+ * a placement only appends to them and the memory used is linear in the number of placements.
+ * Rotations and scales are kept at full precision, so GetTransform() returns the transform that was added
+ * and the exported rotations match those of FTransform::Rotator().
+ */
+class FPlacementBuffer
+{
+public:
+    /**
+     * The placements of a single class.
+     */
+    class FPlacements
+    {
+    public:
+        /**
+         * Makes room for Number more placements.
+         */
+        void Reserve(int32 Number);
+
+        /**
+         * Adds a placement.
+         */
+        void Add(const FTransform& Transform);
+
+        /**
+         * Returns the number of placements.
+         */
+        int32 Num() const
+        {
+            return Locations.Num();
+        }
+
+        const FVector& GetLocation(int32 Index) const
+        {
+            return Locations[Index];
+        }
+
+        FRotator GetRotation(int32 Index) const
+        {
+            return Rotations[Index].Rotator();
+        }
+
+        const FVector& GetScale(int32 Index) const
+        {
+            return Scales[Index];
+        }
+
+        FTransform GetTransform(int32 Index) const
+        {
+            return FTransform(Rotations[Index], Locations[Index], Scales[Index]);
+        }
+
+        /**
+         * Returns every placement as a transform, in the order they were added.
+         */
+        TArray<FTransform> GetTransforms() const;
+
+        bool operator==(const FPlacements& Other) const;
+
+    private:
+        TArray<FVector> Locations;
+        TArray<FQuat> Rotations;
+        TArray<FVector> Scales;
+    };
+
+    /**
+     * Makes room for Number more placements of Class.
+     */
+    void Reserve(FName Class, int32 Number);
+
+    /**
+     * Adds a placement of Class.
+     */
+    void Add(FName Class, const FTransform& Transform);
+
+    /**
+     * Adds every transform in Transforms as a placement of Class.
+     */
+    void Append(FName Class, const TArray<FTransform>& Transforms);
+
+    /**
+     * Returns the placements of Class, or nullptr if none were added.
+     */
+    const FPlacements* Find(FName Class) const
+    {
+        return Classes.Find(Class);
+    }
+
+    /**
+     * Returns the placements of every class, in the order the classes were first added.
+     */
+    const TMap<FName, FPlacements>& GetClasses() const
+    {
+        return Classes;
+    }
+
+    /**
+     * Returns the number of classes with placements.
+     */
+    int32 NumClasses() const
+    {
+        return Classes.Num();
+    }
+
+    /**
+     * Returns the number of placements of every class.
+     */
+    int32 Num() const;
+
+    /**
+     * Removes every placement.
+     */
+    void Empty();
+
+    bool operator==(const FPlacementBuffer& Other) const;
+
+private:
+    TMap<FName, FPlacements> Classes;
+};
@@ -0,0 +1,150 @@
+//   Copyright 2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//  
+//   Licensed under the Apache License, Version 2.0 (the "License").
+//   You may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//  
+//       http://www.apache.org/licenses/LICENSE-2.0
+//  
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+
+#include "PlacementBuffer.h"
+
+#include "Misc/AutomationTest.h"
+
+#include "Ambit/AmbitModule.h"
+
+BEGIN_DEFINE_SPEC(PlacementBufferSpec, "Ambit.Unit.PlacementBuffer",
+                  EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+    FPlacementBuffer Buffer;
+END_DEFINE_SPEC(PlacementBufferSpec)
+
+void PlacementBufferSpec::Define()
+{
+    BeforeEach([this]()
+    {
+        Buffer.Empty();
+    });
+
+    Describe("Add()", [this]()
+    {
+        It("groups placements by class in the order they were added", [this]()
+        {
+            Buffer.Add("A", FTransform(FVector(1, 0, 0)));
+            Buffer.Add("B", FTransform(FVector(2, 0, 0)));
+            Buffer.Add("A", FTransform(FVector(3, 0, 0)));
+
+            TestEqual("Classes", Buffer.NumClasses(), 2);
+            TestEqual("Placements", Buffer.Num(), 3);
+
+            const FPlacementBuffer::FPlacements* A = Buffer.Find("A");
+            TestNotNull("A is found", A);
+            if (A == nullptr)
+            {
+                return;
+            }
+            TestEqual("A placements", A->Num(), 2);
+            TestEqual("First A", A->GetLocation(0), FVector(1, 0, 0));
+            TestEqual("Second A", A->GetLocation(1), FVector(3, 0, 0));
+
+            TArray<FName> Classes;
+            Buffer.GetClasses().GenerateKeyArray(Classes);
+            TestTrue("Class order", Classes.Num() == 2 && Classes[0] == "A" && Classes[1] == "B");
+        });
+
+        It("keeps rotations at full precision", [this]()
+        {
+            const FTransform Transform(FRotator(-45.123f, 170.5f, -179.9f), FVector::ZeroVector);
+            Buffer.Add("A", Transform);
+
+            const FPlacementBuffer::FPlacements* A = Buffer.Find("A");
+            TestTrue("Quaternion", A->GetTransform(0).GetRotation() == Transform.GetRotation());
+            TestTrue("Rotation", A->GetRotation(0) == Transform.Rotator());
+        });
+
+        It("keeps a non-uniform scale", [this]()
+        {
+            const FVector Scale(2.5f, 0.5f, 1.25f);
+            Buffer.Add("A", FTransform(FRotator::ZeroRotator, FVector::ZeroVector, Scale));
+
+            TestEqual("Scale", Buffer.Find("A")->GetScale(0), Scale);
+            TestEqual("Transform scale", Buffer.Find("A")->GetTransform(0).GetScale3D(), Scale);
+        });
+    });
+
+    Describe("Reserve()", [this]()
+    {
+        It("adds no placements", [this]()
+        {
+            Buffer.Reserve("A", 100);
+
+            TestEqual("Placements", Buffer.Num(), 0);
+            TestNotNull("A is known", Buffer.Find("A"));
+        });
+    });
+
+    Describe("operator==()", [this]()
+    {
+        It("compares placements of every class", [this]()
+        {
+            const FTransform Transform(FRotator(10, 20, 30), FVector(1, 2, 3));
+            FPlacementBuffer Other;
+            Buffer.Add("A", Transform);
+            Other.Add("A", Transform);
+            TestTrue("Same placements", Buffer == Other);
+
+            Other.Add("B", Transform);
+            TestFalse("Other class", Buffer == Other);
+        });
+    });
+
+    Describe("Benchmark", [this]()
+    {
+        It("adds placements faster than a map of transform arrays", [this]()
+        {
+            const int32 Count = 10000;
+            TArray<FTransform> Transforms;
+            Transforms.Reserve(Count);
+            for (int32 i = 0; i < Count; i++)
+            {
+                Transforms.Emplace(FRotator(0, i % 360, 0), FVector(i, i, 0));
+            }
+
+            // As spawners recorded placements before, copying the array of the class for each one.
+            double StartTime = FPlatformTime::Seconds();
+            TMap<FString, TArray<FTransform>> Map;
+            for (const FTransform& Transform : Transforms)
+            {
+                TArray<FTransform> PathNameTransforms;
+                PathNameTransforms.Add(Transform);
+                if (Map.Find("A") != nullptr)
+                {
+                    PathNameTransforms.Append(Map.FindAndRemoveChecked("A"));
+                }
+                Map.Add("A", PathNameTransforms);
+            }
+            const double MapSeconds = FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            Buffer.Reserve("A", Count);
+            for (const FTransform& Transform : Transforms)
+            {
+                Buffer.Add("A", Transform);
+            }
+            const double BufferSeconds = FPlatformTime::Seconds() - StartTime;
+
+            TestEqual("Every placement is kept", Buffer.Num(), Count);
+            TestTrue("The buffer is faster", BufferSeconds < MapSeconds);
+            UE_LOG(LogAmbit, Display,
+                   TEXT("%i placements: map of transform arrays %.1f ms, %i bytes each; "
+                       "placement buffer %.1f ms, %i bytes each."),
+                   Count, MapSeconds * 1000, static_cast<int32>(sizeof(FTransform)), BufferSeconds * 1000,
+                   static_cast<int32>(2 * sizeof(FVector) + sizeof(FQuat)));
+        });
+    });
+}
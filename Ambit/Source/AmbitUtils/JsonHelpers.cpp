@@ -23,11 +23,8 @@ namespace FJsonHelpers
 {
     FString SerializeJson(TSharedPtr<FJsonObject> JsonObject)
     {
-        typedef TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>> FStringWriter;
-        typedef TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>> FStringWriterFactory;
-
         FString OutputString;
-        const TSharedRef<FStringWriter> Writer = FStringWriterFactory::Create(&OutputString);
+        const TSharedRef<FPrettyJsonWriter> Writer = FPrettyJsonWriterFactory::Create(&OutputString);
         if (!FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer))
         {
             return "";
@@ -51,6 +48,54 @@ namespace FJsonHelpers
         return OutputString;
     }
 
+    FString WriteJson(TFunctionRef<void(const TSharedRef<FPrettyJsonWriter>&)> WriteFields)
+    {
+        FString OutputString;
+        const TSharedRef<FPrettyJsonWriter> Writer = FPrettyJsonWriterFactory::Create(&OutputString);
+        Writer->WriteObjectStart();
+        WriteFields(Writer);
+        Writer->WriteObjectEnd();
+        if (!Writer->Close())
+        {
+            return "";
+        }
+
+        return OutputString;
+    }
+
+    void WriteObject(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier,
+                     const TSharedPtr<FJsonObject>& JsonObject)
+    {
+        if (!JsonObject.IsValid())
+        {
+            Writer->WriteNull(Identifier);
+            return;
+        }
+
+        const TSharedPtr<FJsonValue> Value = MakeShareable(new FJsonValueObject(JsonObject));
+        FJsonSerializer::Serialize(Value, Identifier, Writer, false);
+    }
+
+    void WriteVector3(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier, const FVector& Vector)
+    {
+        // Widen to double so the numbers print exactly as the FJsonValueNumber from SerializeVector3 would.
+        Writer->WriteArrayStart(Identifier);
+        Writer->WriteValue(static_cast<double>(Vector.X));
+        Writer->WriteValue(static_cast<double>(Vector.Y));
+        Writer->WriteValue(static_cast<double>(Vector.Z));
+        Writer->WriteArrayEnd();
+    }
+
+    void WriteRotation(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier,
+                       const FRotator& Rotation)
+    {
+        Writer->WriteArrayStart(Identifier);
+        Writer->WriteValue(static_cast<double>(Rotation.Pitch));
+        Writer->WriteValue(static_cast<double>(Rotation.Yaw));
+        Writer->WriteValue(static_cast<double>(Rotation.Roll));
+        Writer->WriteArrayEnd();
+    }
+
     TSharedPtr<FJsonObject> DeserializeJson(const FString& JsonString)
     {
         TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
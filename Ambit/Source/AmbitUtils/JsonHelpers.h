@@ -16,12 +16,17 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 
 /**
  * This namespace contains helper functions to deal with Json Serialization and Deserialization.
  */
 namespace FJsonHelpers
 {
+    typedef TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>> FPrettyJsonWriter;
+    typedef TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>> FPrettyJsonWriterFactory;
+
     /**
      * Serialize the JsonObject to a readable string.
      *
@@ -38,6 +43,37 @@ namespace FJsonHelpers
      */
     AMBITUTILS_API FString SerializeJsonCondense(const TSharedPtr<FJsonObject>& JsonObject);
 
+    /**
+     * Streams a root Json object to a readable string without building an FJsonObject for it.
+     * The output matches SerializeJson for an object holding the same fields in the same order.
+     *
+     * @param WriteFields Writes the fields of the root object, which is already open on the writer.
+     * @return
+     *  an empty string if WriteFields leaves the writer unbalanced
+     */
+    AMBITUTILS_API FString WriteJson(TFunctionRef<void(const TSharedRef<FPrettyJsonWriter>&)> WriteFields);
+
+    /**
+     * Writes JsonObject as a named field of the object that is open on Writer.
+     * An invalid JsonObject is written as null, like FJsonObject::SetObjectField does.
+     */
+    AMBITUTILS_API void WriteObject(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier,
+                                    const TSharedPtr<FJsonObject>& JsonObject);
+
+    /**
+     * Writes a Vector3 as a named field of the object that is open on Writer,
+     * in the same form as SerializeVector3.
+     */
+    AMBITUTILS_API void WriteVector3(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier,
+                                     const FVector& Vector);
+
+    /**
+     * Writes a Rotator as a named field of the object that is open on Writer,
+     * in the same form as SerializeRotation.
+     */
+    AMBITUTILS_API void WriteRotation(const TSharedRef<FPrettyJsonWriter>& Writer, const FString& Identifier,
+                                      const FRotator& Rotation);
+
     /**
      * Deserialize a readable string into a JsonObject
      *